@@ -0,0 +1,249 @@
+import argparse
+import csv
+import json
+import os
+import resource
+import statistics
+import subprocess
+import sys
+import time
+
+# End-to-end VQE benchmark of the simulation strategies
+#
+# Every molecule of the cache is optimized with UCCSD and COBYLA for a fixed
+# number of iterations with each simulation strategy of the installed
+# qiskit-aer build, selected by the simulation_strategy run option, and each
+# run is repeated to measure the variance. A run is a separate process, so
+# that its peak RSS is its own.
+#
+# The results are written to <output-dir>/runs.csv and runs.json (one row per
+# run) and summary.csv (median and standard deviation per molecule and
+# strategy). With --baseline <runs.json> of an earlier benchmark the medians
+# are compared and the exit status is 1 if a run got slower by more than
+# --time-threshold or its energy moved by more than --energy-tolerance.
+#
+# Usage: python3 code/benchmark.py [--molecules H2 LiH ...] [--max-qubits 16]
+#            [--strategies gates fusion mosq mosq_fusion] [--iterations 5]
+#            [--repeats 3] [--output-dir ./data/benchmark] [--baseline runs.json]
+
+TIMES = ["T_tot", "T_setup", "T_sim", "T_exp", "T_etc", "T_opt"]
+COLUMNS = (["molecule", "strategy", "repeat", "num_qubits", "num_parameters", "num_terms",
+            "iterations"] + TIMES + ["peak_rss_mb", "energy", "reference_energy",
+                                     "energy_error"])
+
+
+def run_vqe(molecule, strategy, iterations, cache_dir):
+    """Optimize the UCCSD ansatz of a molecule and return a row of runs.csv."""
+    setup_start = time.time()
+    import numpy as np
+    from scipy.optimize import minimize
+    from qiskit.primitives.containers.bindings_array import BindingsArray
+    from qiskit_nature.second_q.circuit.library import HartreeFock, UCCSD
+    from qiskit_nature.second_q.mappers import JordanWignerMapper
+    from qiskit_aer.primitives import EstimatorV2
+    from hamiltonian_cache import load_problem
+
+    hamiltonian, num_spatial_orbitals, num_particles, nuclear_repulsion_energy, \
+        reference_energy = load_problem(molecule, cache_dir)
+    jw_mapper = JordanWignerMapper()
+    ansatz = UCCSD(
+        num_spatial_orbitals,
+        num_particles,
+        jw_mapper,
+        initial_state=HartreeFock(num_spatial_orbitals, num_particles, jw_mapper),
+    )
+    ansatz = ansatz.decompose().decompose()
+    estimator = EstimatorV2(options={'run_options': {'simulation_strategy': strategy}})
+    setup_time = time.time() - setup_start
+
+    energies = []
+    profile = {}
+
+    def objective_function(params):
+        parameter_binds = BindingsArray(
+            {param: val for param, val in zip(ansatz.parameters, params)})
+        # The terms of the Hamiltonian file are read by the simulator
+        pub = (ansatz, hamiltonian, parameter_binds)
+        result = estimator.run([pub]).result()
+        for kind, counters in result[0].metadata.get('profile', {}).items():
+            profile[kind] = profile.get(kind, 0) + counters['time']
+        energy = float(result[0].data['evs'])
+        energies.append(energy)
+        return energy
+
+    # A tiny tolerance keeps COBYLA from stopping before maxiter
+    opt_start = time.time()
+    minimize(objective_function, np.zeros(ansatz.num_parameters), method='COBYLA',
+             tol=1e-12, options={'maxiter': iterations})
+    opt_time = time.time() - opt_start
+
+    # Expectation values computed by the simulator count as T_exp
+    time_expval = profile.get('expval', 0) + profile.get('hamiltonian_expval', 0)
+    sim_time = estimator._sim_time - time_expval
+    exp_time = estimator._exp_time + time_expval
+    etc_time = estimator._sim_exp_etc_time - estimator._exp_time - estimator._sim_time
+    # ru_maxrss is in kilobytes on Linux and in bytes on macOS
+    peak_rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    peak_rss_mb = peak_rss / (2**20 if sys.platform == 'darwin' else 2**10)
+    energy = min(energies) + float(nuclear_repulsion_energy)
+    return {
+        "molecule": molecule,
+        "strategy": strategy,
+        "num_qubits": ansatz.num_qubits,
+        "num_parameters": ansatz.num_parameters,
+        "num_terms": hamiltonian.num_terms,
+        "iterations": len(energies),
+        "T_tot": setup_time + opt_time,
+        "T_setup": setup_time,
+        "T_sim": sim_time,
+        "T_exp": exp_time,
+        "T_etc": etc_time,
+        "T_opt": opt_time - estimator._sim_exp_etc_time,
+        "peak_rss_mb": peak_rss_mb,
+        "energy": energy,
+        "reference_energy": float(reference_energy),
+        "energy_error": energy - float(reference_energy),
+    }
+
+
+def cached_molecules(cache_dir, max_qubits):
+    """Return the molecules of the cache with at most max_qubits qubits, smallest first."""
+    molecules = []
+    for filename in os.listdir(cache_dir):
+        if not filename.endswith('_fermionic_op.txt'):
+            continue
+        molecule = filename[:-len('_fermionic_op.txt')]
+        json_filepath = os.path.join(cache_dir, molecule + '.json')
+        if not os.path.exists(json_filepath):
+            continue
+        with open(json_filepath, 'r') as file:
+            num_qubits = 2 * int(json.load(file)['num_spatial_orbitals'])
+        if num_qubits <= max_qubits:
+            molecules.append((num_qubits, molecule))
+    return [molecule for _, molecule in sorted(molecules)]
+
+
+def run_worker(molecule, strategy, repeat, args):
+    """Run one VQE in a new process and return its row, or None if it failed."""
+    command = [sys.executable, os.path.abspath(__file__), '--worker', molecule, strategy,
+               '--iterations', str(args.iterations), '--cache-dir', args.cache_dir]
+    process = subprocess.run(command, capture_output=True, text=True)
+    if process.returncode != 0:
+        print(f"{molecule} {strategy} failed:\n{process.stderr}", file=sys.stderr)
+        return None
+    row = json.loads(process.stdout.strip().splitlines()[-1])
+    row["repeat"] = repeat
+    return row
+
+
+def summarize(rows):
+    """Return the median and standard deviation of each molecule and strategy."""
+    groups = {}
+    for row in rows:
+        groups.setdefault((row["molecule"], row["strategy"]), []).append(row)
+    summary = []
+    for (molecule, strategy), group in groups.items():
+        entry = {"molecule": molecule, "strategy": strategy, "runs": len(group),
+                 "num_qubits": group[0]["num_qubits"], "iterations": group[0]["iterations"]}
+        for key in TIMES + ["energy"]:
+            values = [row[key] for row in group]
+            entry[key] = statistics.median(values)
+            entry[key + "_std"] = statistics.stdev(values) if len(values) > 1 else 0.0
+        entry["peak_rss_mb"] = max(row["peak_rss_mb"] for row in group)
+        entry["energy_error"] = entry["energy"] - group[0]["reference_energy"]
+        summary.append(entry)
+    # Deviation of the energy from the first strategy of the molecule
+    first = {}
+    for entry in summary:
+        first.setdefault(entry["molecule"], entry["energy"])
+        entry["energy_deviation"] = entry["energy"] - first[entry["molecule"]]
+    return summary
+
+
+def write_csv(filepath, rows):
+    with open(filepath, 'w', newline='') as file:
+        writer = csv.DictWriter(file, fieldnames=list(rows[0].keys()))
+        writer.writeheader()
+        writer.writerows(rows)
+
+
+def compare(summary, baseline_filepath, time_threshold, energy_tolerance):
+    """Print the changes from a baseline runs.json and return the number of regressions."""
+    with open(baseline_filepath, 'r') as file:
+        baseline = {(entry["molecule"], entry["strategy"]): entry
+                    for entry in summarize(json.load(file)["runs"])}
+    regressions = 0
+    print(f"{'molecule':<10}{'strategy':<13}{'T_tot':>10}{'base':>10}{'ratio':>8}"
+          f"{'dE':>12}")
+    for entry in summary:
+        old = baseline.get((entry["molecule"], entry["strategy"]))
+        if old is None:
+            continue
+        ratio = entry["T_tot"] / old["T_tot"]
+        energy_change = entry["energy"] - old["energy"]
+        flag = ""
+        if ratio > 1.0 + time_threshold:
+            flag += "  slower"
+        if abs(energy_change) > energy_tolerance:
+            flag += "  energy"
+        regressions += bool(flag)
+        print(f"{entry['molecule']:<10}{entry['strategy']:<13}{entry['T_tot']:>10.3f}"
+              f"{old['T_tot']:>10.3f}{ratio:>8.2f}{energy_change:>12.2e}{flag}")
+    return regressions
+
+
+def main():
+    from qiskit_aer.primitives.simulation_strategy import SIMULATION_STRATEGIES
+
+    parser = argparse.ArgumentParser(description="End-to-end VQE benchmark")
+    parser.add_argument('--worker', nargs=2, metavar=('MOLECULE', 'STRATEGY'))
+    parser.add_argument('--molecules', nargs='+')
+    parser.add_argument('--max-qubits', type=int, default=16)
+    parser.add_argument('--strategies', nargs='+', default=list(SIMULATION_STRATEGIES))
+    parser.add_argument('--iterations', type=int, default=5)
+    parser.add_argument('--repeats', type=int, default=3)
+    parser.add_argument('--cache-dir', default='./cache')
+    parser.add_argument('--output-dir', default='./data/benchmark')
+    parser.add_argument('--baseline')
+    parser.add_argument('--time-threshold', type=float, default=0.1)
+    parser.add_argument('--energy-tolerance', type=float, default=1e-8)
+    args = parser.parse_args()
+
+    if args.worker:
+        molecule, strategy = args.worker
+        print(json.dumps(run_vqe(molecule, strategy, args.iterations, args.cache_dir)))
+        return 0
+
+    molecules = args.molecules or cached_molecules(args.cache_dir, args.max_qubits)
+    rows = []
+    for molecule in molecules:
+        for repeat in range(args.repeats):
+            # Strategies are interleaved so that drifts of the machine affect all of them
+            for strategy in args.strategies:
+                row = run_worker(molecule, strategy, repeat, args)
+                if row is None:
+                    continue
+                rows.append({column: row[column] for column in COLUMNS})
+                print(f"{molecule} {strategy} #{repeat}: T_tot {row['T_tot']:.3f} "
+                      f"T_sim {row['T_sim']:.3f} energy {row['energy']:.10f}", flush=True)
+    if not rows:
+        print("no run succeeded", file=sys.stderr)
+        return 1
+
+    os.makedirs(args.output_dir, exist_ok=True)
+    summary = summarize(rows)
+    write_csv(os.path.join(args.output_dir, 'runs.csv'), rows)
+    write_csv(os.path.join(args.output_dir, 'summary.csv'), summary)
+    with open(os.path.join(args.output_dir, 'runs.json'), 'w') as file:
+        json.dump({"iterations": args.iterations, "repeats": args.repeats, "runs": rows},
+                  file, indent=1)
+
+    if args.baseline:
+        regressions = compare(summary, args.baseline, args.time_threshold,
+                              args.energy_tolerance)
+        return 1 if regressions else 0
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
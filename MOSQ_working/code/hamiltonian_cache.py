@@ -0,0 +1,71 @@
+import json
+import os
+import sys
+
+import numpy as np
+
+from qiskit_aer.quantum_info import QubitHamiltonian
+
+# Binary qubit Hamiltonian cache
+#
+# <molecule>_fermionic_op.txt is mapped by Jordan-Wigner only once per
+# molecule; the qubit operator and the problem metadata of <molecule>.json are
+# written to <molecule>_qubit_op.bin, which later runs memory-map.
+#
+# Usage: python3 code/hamiltonian_cache.py <molecule> [<molecule> ...]
+
+
+def _parse_problem_json(json_filepath):
+    with open(json_filepath, 'r') as file:
+        data = json.load(file)
+    num_spatial_orbitals = int(data['num_spatial_orbitals'])
+    num_particles = tuple(map(int, data['num_particles'].strip("()").split(',')))
+    nuclear_repulsion_energy = np.float64(data['nuclear_repulsion_energy'])
+    reference_energy = np.float64(data['reference_energy'])
+    return num_spatial_orbitals, num_particles, nuclear_repulsion_energy, reference_energy
+
+
+def build_hamiltonian_cache(molecule, cache_dir="./cache"):
+    """Map <molecule>_fermionic_op.txt to a qubit operator and write it with
+    the problem metadata to <molecule>_qubit_op.bin."""
+    json_filepath = f"{cache_dir}/{molecule}.json"
+    fermionic_op_filepath = f"{cache_dir}/{molecule}_fermionic_op.txt"
+    if not (os.path.exists(json_filepath) and os.path.exists(fermionic_op_filepath)):
+        raise FileNotFoundError(f"Cache files not found for molecule {molecule}")
+
+    num_spatial_orbitals, num_particles, nuclear_repulsion_energy, reference_energy = \
+        _parse_problem_json(json_filepath)
+    # The text file is parsed and mapped natively, in parallel
+    return QubitHamiltonian.from_fermionic_op(
+        f"{cache_dir}/{molecule}_qubit_op.bin",
+        fermionic_op_filepath,
+        num_spatial_orbitals=num_spatial_orbitals,
+        num_particles=num_particles,
+        nuclear_repulsion_energy=nuclear_repulsion_energy,
+        reference_energy=reference_energy,
+    )
+
+
+def load_problem(molecule, cache_dir="./cache"):
+    """Return the qubit Hamiltonian of a molecule with num_spatial_orbitals,
+    num_particles, nuclear_repulsion_energy and reference_energy. The binary
+    cache is built first if it does not exist."""
+    qubit_op_filepath = f"{cache_dir}/{molecule}_qubit_op.bin"
+    if os.path.exists(qubit_op_filepath):
+        hamiltonian = QubitHamiltonian(qubit_op_filepath)
+    else:
+        hamiltonian = build_hamiltonian_cache(molecule, cache_dir)
+    metadata = hamiltonian.metadata
+    return (
+        hamiltonian,
+        metadata['num_spatial_orbitals'],
+        metadata['num_particles'],
+        np.float64(metadata['nuclear_repulsion_energy']),
+        np.float64(metadata['reference_energy']),
+    )
+
+
+if __name__ == "__main__":
+    for molecule in sys.argv[1:]:
+        hamiltonian = build_hamiltonian_cache(molecule)
+        print(f"{molecule}: {hamiltonian.num_qubits} qubits, {hamiltonian.num_terms} terms")
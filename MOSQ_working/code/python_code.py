@@ -2,79 +2,21 @@ from qiskit_nature.second_q.mappers import JordanWignerMapper
 from qiskit_nature.second_q.circuit.library import HartreeFock, UCCSD
 import numpy as np
 from scipy.optimize import minimize
-from qiskit.primitives.containers.estimator_pub import EstimatorPub
 from qiskit.primitives.containers.bindings_array import BindingsArray
-from qiskit.primitives.containers.observables_array import ObservablesArray
-from qiskit_nature.second_q.operators import FermionicOp
 import time
 import sys
-import json
-import os
+
+from hamiltonian_cache import load_problem
 
 start_time = time.time()
 
 molecule = sys.argv[1]
 cache_dir = "./cache"
-json_filepath = f"{cache_dir}/{molecule}.json"
-fermionic_op_filepath = f"{cache_dir}/{molecule}_fermionic_op.txt"
-
-def deserialize_problem(data, fermionic_op_filepath):
-    # Deserialize problem attributes
-    num_spatial_orbitals = int(data['num_spatial_orbitals'])
-    num_particles = tuple(map(int, data['num_particles'].strip("()").split(',')))
-    nuclear_repulsion_energy = np.float64(data['nuclear_repulsion_energy'])
-    reference_energy = np.float64(data['reference_energy'])
-
-    with open(fermionic_op_filepath, 'r') as f:
-        fermionic_op_str = f.read()
-    
-    # Parse fermionic_op_str to FermionicOp object
-    def parse_fermionic_op_string(fermionic_op_str):
-        lines = fermionic_op_str.strip().split("\n")
-        data = {}
-        max_index = -1
-        for line in lines[2:]:
-            if line.startswith("+ "):
-                line = line[2:]
-            elif line.startswith("  "):
-                line = line[2:]
-
-            coeff_str, label = line.split(" * ")
-            coeff = float(coeff_str.strip())
-            label = label.strip().strip("()").strip()
-            data[label] = coeff
-
-            for term in label.split():
-                index = int(term[2:])
-                if index > max_index:
-                    max_index = index
-
-        num_spin_orbitals = max_index + 1
-        return data, num_spin_orbitals
 
-    fermionic_op_data, num_spin_orbitals = parse_fermionic_op_string(fermionic_op_str)
-    fermionic_op = FermionicOp(fermionic_op_data, num_spin_orbitals)
-
-    return fermionic_op, num_spatial_orbitals, num_particles, nuclear_repulsion_energy, reference_energy
-
-def load_problem_from_json(json_filepath, fermionic_op_filepath):
-    with open(json_filepath, 'r') as file:
-        data = json.load(file)
-    return deserialize_problem(data, fermionic_op_filepath)
-
-# Ensure cache directory exists
-os.makedirs(cache_dir, exist_ok=True)
-
-# Check if cache file exists
-if os.path.exists(json_filepath) and os.path.exists(fermionic_op_filepath):
-    fermionic_op, num_spatial_orbitals, num_particles, nuclear_repulsion_energy, reference_energy = load_problem_from_json(json_filepath, fermionic_op_filepath)
-else:
-    raise FileNotFoundError(f"Cache files not found for molecule {molecule}")
-
-# Map the problem to a fermionic operator and then to a qubit operator
+# Load the qubit Hamiltonian from its binary cache, which is mapped from
+# <molecule>_fermionic_op.txt on the first run
+hamiltonian_cache, num_spatial_orbitals, num_particles, nuclear_repulsion_energy, reference_energy = load_problem(molecule, cache_dir)
 jw_mapper = JordanWignerMapper()
-qubit_jw_op = jw_mapper.map(fermionic_op)
-hamiltonian = qubit_jw_op
 
 # Define the ansatz using UCCSD
 ansatz_UCCSD = UCCSD(
@@ -107,29 +49,12 @@ options = {
 from qiskit_aer.primitives import EstimatorV2
 estimator = EstimatorV2(options=options)
 
-# Convert SparsePauliOp to ObservablesArray
-observables_array = ObservablesArray.coerce([hamiltonian])
-
 iteration = 0
 time_taken_execute = 0
 sim_time = 0
 exp_time = 0
 sim_exp_etc_time = 0
-time_expval = 0
-time_Diag = 0
-time_Fuse2 = 0
-time_Fuse3 = 0
-time_Fuse4 = 0
-time_Fuse5 = 0
-time_MOSQ = 0
-time_MOSQ_CR = 0
-time_HS = 0
-time_SDGH = 0
-time_RZ = 0
-time_CX = 0
-time_S = 0
-time_SDG = 0
-time_H = 0
+profile = {}  # op kind -> time, reported by builds with AER_PROFILING
 
 # Define the objective function for the optimizer
 def objective_function(params):
@@ -138,24 +63,10 @@ def objective_function(params):
     global sim_time
     global exp_time
     global sim_exp_etc_time
-    global time_expval
-    global time_Diag
-    global time_Fuse2
-    global time_Fuse3
-    global time_Fuse4
-    global time_Fuse5
-    global time_MOSQ
-    global time_MOSQ_CR
-    global time_HS
-    global time_SDGH
-    global time_RZ
-    global time_CX
-    global time_S
-    global time_SDG
-    global time_H
     iteration += 1
     parameter_binds = BindingsArray({param: val for param, val in zip(ansatz.parameters, params)})
-    estimator_pub = EstimatorPub(circuit=ansatz, observables=observables_array, parameter_values=parameter_binds)
+    # the Hamiltonian file is passed as is and its terms are read by the simulator
+    estimator_pub = (ansatz, hamiltonian_cache, parameter_binds)
     
     job = estimator.run([estimator_pub])
 
@@ -167,22 +78,8 @@ def objective_function(params):
     sim_time = estimator._sim_time
     exp_time = estimator._exp_time
     sim_exp_etc_time = estimator._sim_exp_etc_time
-    
-    time_expval += result[0].metadata['time_expval']
-    time_Diag += result[0].metadata['time_Diag']
-    time_Fuse2 += result[0].metadata['time_Fuse2']
-    time_Fuse3 += result[0].metadata['time_Fuse3']
-    time_Fuse4 += result[0].metadata['time_Fuse4']
-    time_Fuse5 += result[0].metadata['time_Fuse5']
-    time_MOSQ += result[0].metadata['time_MOSQ']
-    time_MOSQ_CR += result[0].metadata['time_MOSQ_CR']
-    time_HS += result[0].metadata['time_HS']
-    time_SDGH += result[0].metadata['time_SDGH']
-    time_RZ += result[0].metadata['time_RZ']
-    time_CX += result[0].metadata['time_CX']
-    time_S += result[0].metadata['time_S']
-    time_SDG += result[0].metadata['time_SDG']
-    time_H += result[0].metadata['time_H']
+    for kind, counters in result[0].metadata['profile'].items():
+        profile[kind] = profile.get(kind, 0) + counters['time']
     
 # Perform the optimization
 maxit = 1
@@ -192,23 +89,24 @@ result = minimize(objective_function, initial_point, method='COBYLA'
         ,options = {'maxiter': maxit}
         )
 
+time_expval = profile.get('expval', 0) + profile.get('hamiltonian_expval', 0)
 print("T_sim: " + str(sim_time - time_expval))
 print("T_exp: " + str(exp_time + time_expval))
 print("T_etc: " + str(sim_exp_etc_time - exp_time - sim_time))
 print("T_opt = T_tot - T_sim - T_exp - T_etc")
-print("time_Diag: " + str(time_Diag))
-print("time_Fuse2: " + str(time_Fuse2))
-print("time_Fuse3: " + str(time_Fuse3))
-print("time_Fuse4: " + str(time_Fuse4))
-print("time_Fuse5: " + str(time_Fuse5))
-print("time_MOSQ: " + str(time_MOSQ_CR))
-print("time_HS: " + str(time_HS))
-print("time_SDGH: " + str(time_SDGH))
-print("time_RZ: " + str(time_RZ))
-print("time_CX: " + str(time_CX))
-print("time_S: " + str(time_S))
-print("time_SDG: " + str(time_SDG))
-print("time_H: " + str(time_H))
+print("time_Diag: " + str(profile.get('diagonal', 0)))
+print("time_Fuse2: " + str(profile.get('matrix_2', 0)))
+print("time_Fuse3: " + str(profile.get('matrix_3', 0)))
+print("time_Fuse4: " + str(profile.get('matrix_4', 0)))
+print("time_Fuse5: " + str(profile.get('matrix_5', 0)))
+print("time_MOSQ: " + str(profile.get('MOSQ_CR', 0) + profile.get('MOSQ_BLOCK', 0)))
+print("time_HS: " + str(profile.get('hs', 0)))
+print("time_SDGH: " + str(profile.get('sdgh', 0)))
+print("time_RZ: " + str(profile.get('rz', 0)))
+print("time_CX: " + str(profile.get('cx', 0)))
+print("time_S: " + str(profile.get('s', 0)))
+print("time_SDG: " + str(profile.get('sdg', 0)))
+print("time_H: " + str(profile.get('h', 0)))
 print("total iteration: " + str(iteration))
 # print("T_tot(global): " + str(time.time() - start_time))
 # print("T_sim(aer_provided): " + str(time_taken_execute))
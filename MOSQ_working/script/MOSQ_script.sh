@@ -12,14 +12,12 @@ cp ${MOSQ_src_DIR}qubitvector.hpp ${cpp_src_DIR}simulators/statevector/
 cp ${MOSQ_src_DIR}statevector_state.hpp ${cpp_src_DIR}simulators/statevector/
 cp ${MOSQ_src_DIR}state.hpp ${cpp_src_DIR}simulators/
 
-#baseline results
-cp ${MOSQ_src_DIR}fusion_OFF.hpp ${cpp_src_DIR}transpile/fusion.hpp
-
+#build once, the simulation strategy is selected at runtime
 cd ../qiskit-aer/build
-cmake .. -DCMAKE_BUILD_TYPE=Debug
+cmake .. -DCMAKE_BUILD_TYPE=Debug -DAER_PROFILING=True
 make -j
 cd ..
-python3 setup.py bdist_wheel
+python3 setup.py bdist_wheel -- -DAER_PROFILING=True
 pip uninstall qiskit-aer -y
 pip install dist/*.whl
 cd ../MOSQ_working
@@ -27,46 +25,21 @@ cd ../MOSQ_working
 cp ${MOSQ_src_DIR}aer_compiler.py ${py_src_DIR}backends/
 cp ${MOSQ_src_DIR}estimator_v2.py ${py_src_DIR}primitives/
 
+#baseline results (simulation_strategy "gates")
 for molecule in NH3 #H2 LiH BeH2 NH3 CH4 LiF MgH2 N2H2 CH3N C2H4 CO2 C2H6
 do
     echo "Baseline" > "${output_DIR}Baseline_${molecule}.txt"
     python3 ./code/Baseline.py $molecule >> "${output_DIR}Baseline_${molecule}.txt"
 done
 
-#fusion results
-cp ${MOSQ_src_DIR}fusion_ON.hpp ${cpp_src_DIR}transpile/fusion.hpp
-
-cd ../qiskit-aer/build
-cmake .. -DCMAKE_BUILD_TYPE=Debug
-make -j
-cd ..
-python3 setup.py bdist_wheel
-pip uninstall qiskit-aer -y
-pip install dist/*.whl
-cd ../MOSQ_working
-
-cp ${MOSQ_src_DIR}aer_compiler.py ${py_src_DIR}backends/
-cp ${MOSQ_src_DIR}estimator_v2.py ${py_src_DIR}primitives/
-
+#fusion results (simulation_strategy "fusion")
 for molecule in NH3 #H2 LiH BeH2 NH3 CH4 LiF MgH2 N2H2 CH3N C2H4 CO2 C2H6
 do
     echo "Fusion" > "${output_DIR}Fusion_${molecule}.txt"
     python3 ./code/Fusion.py $molecule >> "${output_DIR}Fusion_${molecule}.txt"
 done
 
-#MOSQ results
-cp ${MOSQ_src_DIR}fusion_OFF.hpp ${cpp_src_DIR}transpile/fusion.hpp
-
-cd ../qiskit-aer/build
-cmake .. -DCMAKE_BUILD_TYPE=Debug
-make -j
-cd ..
-python3 setup.py bdist_wheel
-pip uninstall qiskit-aer -y
-pip install dist/*.whl
-cd ../MOSQ_working
-
-cp ${MOSQ_src_DIR}aer_compiler.py ${py_src_DIR}backends/
+#MOSQ results (simulation_strategy "mosq")
 cp ${MOSQ_src_DIR}estimator_v2_MOSQ_CR.py ${py_src_DIR}primitives/estimator_v2.py
 
 for molecule in NH3 #H2 LiH BeH2 NH3 CH4 LiF MgH2 N2H2 CH3N C2H4 CO2 C2H6
@@ -0,0 +1,18 @@
+output_DIR="./data/benchmark/"
+
+#build once with the op profiler, every simulation strategy is selected at
+#runtime and no installed Python file is replaced
+mkdir ../qiskit-aer/build
+cd ../qiskit-aer/build
+cmake .. -DCMAKE_BUILD_TYPE=Release -DAER_PROFILING=True
+make -j
+cd ..
+python3 setup.py bdist_wheel -- -DAER_PROFILING=True
+pip uninstall qiskit-aer -y
+pip install dist/*.whl
+cd ../MOSQ_working
+
+#all molecules of the cache up to 16 qubits, 5 COBYLA iterations, 3 repeats
+#compare with an earlier run by adding --baseline <earlier runs.json>
+python3 ./code/benchmark.py --max-qubits 16 --iterations 5 --repeats 3 \
+    --output-dir ${output_DIR}
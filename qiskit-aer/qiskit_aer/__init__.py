@@ -32,6 +32,7 @@ Simulator Backends
     :toctree: ../stubs/
 
     AerSimulator
+    AerSession
 
 Legacy Simulator Backends
 =========================
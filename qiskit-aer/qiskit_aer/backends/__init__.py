@@ -15,6 +15,7 @@ Aer Provider Simulator Backends
 """
 
 from .aer_simulator import AerSimulator
+from .aer_session import AerSession
 from .qasm_simulator import QasmSimulator
 from .statevector_simulator import StatevectorSimulator
 from .unitary_simulator import UnitarySimulator
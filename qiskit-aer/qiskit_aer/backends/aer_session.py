@@ -0,0 +1,233 @@
+# This code is part of Qiskit.
+#
+# (C) Copyright IBM 2024.
+#
+# This code is licensed under the Apache License, Version 2.0. You may
+# obtain a copy of this license in the LICENSE.txt file in the root directory
+# of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+#
+# Any modifications or derivative works of this code must retain this
+# copyright notice, and modified files need to carry a notice indicating
+# that they have been altered from the originals.
+"""
+Persistent simulation of a parameterized circuit
+"""
+
+import numpy as np
+
+from qiskit.circuit import ParameterExpression
+from qiskit.quantum_info import SparsePauliOp
+
+# pylint: disable=import-error, no-name-in-module
+from qiskit_aer.backends.controller_wrappers import AerConfig, AerSessionWrapper
+from .aer_compiler import assemble_circuits, generate_aer_config
+from .aerbackend import AerError
+from .backend_utils import LIBRARY_DIR
+
+
+#SW
+class AerSession:
+    """A parameterized circuit kept in the simulator between evaluations.
+
+    The circuit is compiled, transpiled and its statevector allocated once.
+    :meth:`evaluate` then only writes new parameter values into the compiled
+    circuit and returns the expectation values of its ``save_expval`` and
+    ``save_hamiltonian_expval`` instructions, which makes it suitable for the
+    cost function of a variational algorithm. :meth:`gradient` returns the
+    gradient of the first energy by the adjoint method, for circuits whose
+    parameters are angles of Pauli rotations.
+
+    Sessions support ideal simulations with the ``statevector`` method on
+    the CPU.
+    """
+
+    def __init__(self, circuit, observables=None, backend=None, gradient=False, **run_options):
+        """
+        Args:
+            circuit (QuantumCircuit): parameterized circuit.
+            observables (SparsePauliOp or QubitHamiltonian or list):
+                observables whose expectation values are saved at the end of
+                the circuit. A :class:`~qiskit_aer.quantum_info.QubitHamiltonian`
+                is loaded from its file by the simulator. If
+                ``None`` the circuit must contain expectation value
+                instructions.
+            backend (AerSimulator): backend whose options are used. A new
+                :class:`~.AerSimulator` is used if ``None``.
+            gradient (bool): prepare the session for :meth:`gradient`, which
+                requires complex amplitudes.
+            run_options: options as for :meth:`AerSimulator.run`.
+
+        Raises:
+            AerError: if the circuit can not be run in a session.
+        """
+        if backend is None:
+            # pylint: disable=cyclic-import
+            from .aer_simulator import AerSimulator
+
+            backend = AerSimulator()
+
+        self._single = observables is not None and not isinstance(observables, (list, tuple))
+        if observables is not None:
+            circuit = circuit.copy()
+            if self._single:
+                observables = [observables]
+            # pylint: disable=cyclic-import
+            from ..quantum_info import QubitHamiltonian
+
+            for i, observable in enumerate(observables):
+                if not isinstance(observable, QubitHamiltonian):
+                    observable = SparsePauliOp(observable)
+                circuit.save_hamiltonian_expectation_value(
+                    observable, range(circuit.num_qubits), label=f"expval_{i}"
+                )
+        self._parameters = list(circuit.parameters)
+        if gradient:
+            run_options["statevector_real_amplitudes"] = False
+
+        circuits, noise_model = backend._compile(circuit, **run_options)
+        circuit = circuits[0]
+        if backend._target is not None:
+            aer_circuits, idx_maps = assemble_circuits(circuits, backend.configuration().basis_gates)
+        else:
+            aer_circuits, idx_maps = assemble_circuits(circuits)
+        config = generate_aer_config(circuits, backend.options, **run_options)
+        config.library_dir = LIBRARY_DIR
+
+        positions, exprs = self._parameter_positions(circuit, idx_maps[0])
+        self._set_maps(exprs)
+
+        self._native_session = AerSessionWrapper()
+        try:
+            self._native_session.initialize(
+                aer_circuits[0],
+                noise_model.to_dict(serializable=True) if noise_model else {},
+                config,
+                positions,
+            )
+        except Exception as err:
+            raise AerError(f"failed to initialize session: {err}") from err
+        self._values = np.zeros(len(positions))
+
+    @property
+    def parameters(self):
+        """Return the circuit parameters in the order of :meth:`evaluate`."""
+        return self._parameters
+
+    @property
+    def real_amplitudes(self):
+        """Return True if the session simulates real amplitudes."""
+        return self._native_session.real_amplitudes()
+
+    @staticmethod
+    def _parameter_positions(circuit, idx_map):
+        """Return the positions of the parameterized values in the compiled
+        circuit and their expressions"""
+        positions = []
+        exprs = []
+
+        def append_position(index, param_pos, param):
+            if isinstance(param, ParameterExpression) and param.parameters:
+                positions.append((index, param_pos))
+                exprs.append(param)
+
+        append_position(AerConfig.GLOBAL_PHASE_POS, -1, circuit.global_phase)
+        for index, instruction in enumerate(circuit.data):
+            if instruction.operation.is_parameterized():
+                for param_pos, param in enumerate(instruction.operation.params):
+                    append_position(idx_map[index] if idx_map else index, param_pos, param)
+        return positions, exprs
+
+    def _set_maps(self, exprs):
+        """Split the expressions into an affine map of the parameters and
+        the remaining nonlinear expressions"""
+        param_index = {param: i for i, param in enumerate(self._parameters)}
+        self._coeffs = np.zeros((len(exprs), len(self._parameters)))
+        self._offsets = np.zeros(len(exprs))
+        self._nonlinear = []
+        for k, expr in enumerate(exprs):
+            grads = [expr.gradient(param) for param in expr.parameters]
+            if any(isinstance(grad, ParameterExpression) and grad.parameters for grad in grads):
+                self._nonlinear.append((k, expr))
+                continue
+            for param, grad in zip(expr.parameters, grads):
+                self._coeffs[k, param_index[param]] = complex(grad).real
+            self._offsets[k] = complex(expr.bind({param: 0.0 for param in expr.parameters})).real
+
+    def evaluate(self, parameter_values):
+        """Return the expectation values for parameter values.
+
+        Args:
+            parameter_values (array_like): values in the order of
+                :attr:`parameters`.
+
+        Returns:
+            float or np.ndarray: the expectation value of the observable, or
+            an array of all saved expectation values.
+
+        Raises:
+            AerError: if the number of values does not match.
+        """
+        self._set_values(parameter_values)
+        expvals = self._native_session.evaluate(self._values)
+        if self._single:
+            return float(expvals[0])
+        return expvals
+
+    def gradient(self, parameter_values):
+        """Return the energy of the first observable and its gradient.
+
+        The gradient is computed by the adjoint method with a single reverse
+        sweep over the circuit. Parameters before the energy must only
+        appear in the angles of Pauli rotations (``MOSQ_CR``, ``rx``,
+        ``ry``, ``rz``, ``rzz``, ...).
+
+        Args:
+            parameter_values (array_like): values in the order of
+                :attr:`parameters`.
+
+        Returns:
+            tuple: the energy (float) and its gradient (np.ndarray) with
+            respect to :attr:`parameters`.
+
+        Raises:
+            AerError: if the number of values does not match or the
+                gradient is not supported for the circuit.
+        """
+        parameter_values = self._set_values(parameter_values)
+        try:
+            energy, value_grad = self._native_session.gradient(self._values)
+        except Exception as err:
+            raise AerError(f"failed to compute gradient: {err}") from err
+
+        # Chain rule through the parameter expressions
+        grad = self._coeffs.T @ value_grad
+        if self._nonlinear:
+            binds = dict(zip(self._parameters, parameter_values))
+            index = {param: i for i, param in enumerate(self._parameters)}
+            for k, expr in self._nonlinear:
+                bind = {p: binds[p] for p in expr.parameters}
+                for param in expr.parameters:
+                    grad[index[param]] += value_grad[k] * float(expr.gradient(param).bind(bind))
+        return energy, grad
+
+    def _set_values(self, parameter_values):
+        """Compute the values of the compiled circuit parameters"""
+        parameter_values = np.asarray(parameter_values, dtype=float)
+        if parameter_values.shape != (len(self._parameters),):
+            raise AerError(
+                f"expected {len(self._parameters)} parameter values "
+                f"but got shape {parameter_values.shape}"
+            )
+        np.matmul(self._coeffs, parameter_values, out=self._values)
+        self._values += self._offsets
+        if self._nonlinear:
+            binds = dict(zip(self._parameters, parameter_values))
+            for k, expr in self._nonlinear:
+                self._values[k] = float(expr.bind({p: binds[p] for p in expr.parameters}))
+        return parameter_values
+
+    def __call__(self, parameter_values):
+        return self.evaluate(parameter_values)
+
+    def __repr__(self):
+        return f"AerSession(num_parameters={len(self._parameters)}, {self._native_session})"
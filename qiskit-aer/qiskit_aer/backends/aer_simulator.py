@@ -130,6 +130,14 @@ class AerSimulator(AerBackend):
       both statevector and density matrix. Currently there is only available
       for GPU and accelerated by using cuTensorNet APIs of cuQuantum.
 
+    * ``"subspace_statevector"``: A statevector simulation that only stores
+      the amplitudes of a fixed particle-number sector, for circuits that
+      prepare a basis state with single-qubit gates and then apply
+      particle-number conserving ``MOSQ_CR`` and ``MOSQ`` rotations, such as
+      UCCSD ansatze. The sector is the Hamming weight of the first and second
+      half of the qubits (see ``subspace_spin_sectors``). Only expectation
+      value and statevector save instructions are supported.
+
     **GPU Simulation**
 
     By default all simulation methods run on the CPU, however select methods
@@ -157,6 +165,8 @@ class AerSimulator(AerBackend):
     +--------------------------+---------------+
     | ``tensor_network``       | Yes(GPU only) |
     +--------------------------+---------------+
+    | ``subspace_statevector`` | No            |
+    +--------------------------+---------------+
 
     Running a GPU simulation is done using ``device="GPU"`` kwarg during
     initialization or with :meth:`set_options`. The list of supported devices
@@ -328,6 +338,14 @@ class AerSimulator(AerBackend):
       ``batched_shots_gpu`` to run with multiple parameters in a batch.
       (Default: False).
 
+    * ``trace_file`` (str): Write a timeline of the run to this file in the
+      Chrome trace event format, which can be opened in ``chrome://tracing``
+      or https://ui.perfetto.dev. It has spans of the circuit compilation,
+      parameter binding, transpiler passes, each applied operation with its
+      qubits and OpenMP threads, and the result formatting. The file is
+      overwritten by the first run on a new file name and appended to by
+      later runs (Default: None).
+
     These backend options only apply when using the ``"statevector"``
     simulation method:
 
@@ -344,6 +362,30 @@ class AerSimulator(AerBackend):
       qubit optimized implementation of measurement sampling. Note
       that setting this two low can reduce performance (Default: 10)
 
+    * ``statevector_real_amplitudes`` (bool): Store only real amplitudes
+      for circuits on the CPU without noise whose gates are all real up to
+      a global phase, such as ``MOSQ_CR`` rotations of Pauli strings with an
+      odd number of Y. This halves the statevector memory. The result
+      metadata contains ``real_amplitudes`` when it is used (Default: True).
+
+    * ``prefix_cache_max_memory_mb`` (int): Memory budget in MB for
+      statevector snapshots kept between runs of the same circuit on the
+      CPU. Snapshots are taken before parameterized gates, and a later run
+      with the same gates resumes from the deepest snapshot whose preceding
+      parameters are unchanged, as when an optimizer varies a few ansatz
+      parameters. The result metadata contains ``prefix_cache`` with the
+      cache hit rate and the statevector bytes not recomputed. If set to 0
+      the cache is disabled (Default: 0).
+
+    * ``statevector_persistent_parallel`` (bool): Apply runs of gates that
+      act within the per-thread slices of the statevector, the slice of a
+      thread being fixed by the highest qubits, inside one OpenMP parallel
+      region instead of one region per gate. Threads only synchronize at
+      gates that couple amplitudes of different slices. Used on the CPU
+      when the statevector is parallelized over its amplitudes. The number
+      of such runs is reported in the ``"persistent_parallel"`` metadata
+      (Default: False).
+
     These backend options only apply when using the ``"stabilizer"``
     simulation method:
 
@@ -496,6 +538,37 @@ class AerSimulator(AerBackend):
     | other methods            | 5                    | 14                   |
     +--------------------------+----------------------+----------------------+
 
+    * ``simulation_strategy`` (str): Set the fusion and MOSQ options of a
+      strategy. ``"gates"`` applies the circuit gates, ``"fusion"`` applies
+      fused gates, ``"mosq"`` rewrites the Pauli rotations into ``MOSQ_CR``
+      operations without fusion and ``"mosq_fusion"`` fuses the remaining
+      gates of the rewritten circuit. With ``"auto"`` the Aer estimators time
+      each strategy on the first run of a circuit and keep the fastest one.
+      If ``None`` the ``fusion_enable`` and ``mosq_rewrite_enable`` options
+      are used [Default: None]
+    * ``mosq_rewrite_enable`` (bool): Rewrite the Pauli rotations of the
+      circuit into ``MOSQ_CR`` operations. A rotation is an ``RZ`` gate
+      between a basis change and CX ladder and its mirror image, as in the
+      decomposition of a ``PauliEvolutionGate``, or a ``rx``, ``ry``,
+      ``rz``, ``rxx``, ``ryy``, ``rzz`` or ``rzx`` gate. As ``MOSQ_CR``
+      applies a rotation up to a global phase, the rewrite is meant for
+      expectation values. Only used by the ``"statevector"`` method
+      [Default: False]
+    * ``mosq_block_enable`` (bool): Merge runs of consecutive ``MOSQ_CR`` and
+      ``MOSQ`` Pauli rotations into ``MOSQ_BLOCK`` operations that are applied
+      in a single pass over the statevector. Only used by the ``"statevector"``
+      method [Default: False]
+    * ``mosq_block_max_qubit`` (int): Maximum number of pair qubits (qubits
+      acted on by X or Y) of a ``MOSQ_BLOCK`` operation. Each block keeps at most
+      ``2 ** (mosq_block_max_qubit + 3)`` amplitudes in cache [Default: 10]
+
+    These options are used by the ``"subspace_statevector"`` method:
+
+    * ``subspace_spin_sectors`` (bool): Conserve the Hamming weight of the
+      first and the second half of the qubits separately, as for the alpha
+      and beta spin orbitals of a Jordan-Wigner mapped molecule. If False
+      only the total Hamming weight is conserved [Default: True]
+
     """
 
     _BASIS_GATES = BASIS_GATES
@@ -509,6 +582,8 @@ class AerSimulator(AerBackend):
                 "kraus",
                 "save_expval",
                 "save_expval_var",
+                "save_hamiltonian_expval",
+                "save_energy_gradient",
                 "save_probabilities",
                 "save_probabilities_dict",
                 "save_amplitudes",
@@ -652,6 +727,15 @@ class AerSimulator(AerBackend):
                 "switch_case",
             ]
         ),
+        "subspace_statevector": sorted(
+            [
+                "save_state",
+                "save_expval",
+                "save_expval_var",
+                "save_hamiltonian_expval",
+                "save_statevector",
+            ]
+        ),
     }
 
     # Automatic method custom instructions are the union of statevector,
@@ -694,6 +778,7 @@ class AerSimulator(AerBackend):
         "unitary",
         "superop",
         "tensor_network",
+        "subspace_statevector",
     ]
 
     _AVAILABLE_METHODS = None
@@ -787,6 +872,9 @@ class AerSimulator(AerBackend):
             # statevector options
             statevector_parallel_threshold=14,
             statevector_sample_measure_opt=10,
+            statevector_real_amplitudes=True,
+            prefix_cache_max_memory_mb=0,
+            statevector_persistent_parallel=False,
             # stabilizer options
             stabilizer_max_snapshot_probabilities=32,
             # extended stabilizer options
@@ -812,6 +900,13 @@ class AerSimulator(AerBackend):
             use_cuTensorNet_autotuning=False,
             # parameter binding
             runtime_parameter_bind_enable=False,
+            trace_file=None,
+            # MOSQ options
+            simulation_strategy=None,
+            mosq_rewrite_enable=False,
+            mosq_block_enable=False,
+            mosq_block_max_qubit=None,
+            subspace_spin_sectors=True,
         )
 
     def __repr__(self):
@@ -35,7 +35,7 @@ from ..jobs import AerJob, AerJobSet, split_qobj
 from ..noise.noise_model import NoiseModel, QuantumErrorLocation
 from ..noise.errors.quantum_error import QuantumChannelInstruction
 from .aer_compiler import compile_circuit, assemble_circuits, generate_aer_config
-from .backend_utils import format_save_type, circuit_optypes
+from .backend_utils import format_save_type, circuit_optypes, append_trace_events
 from .name_mapping import NAME_MAPPING
 
 # pylint: disable=import-error, no-name-in-module, abstract-method
@@ -446,6 +446,7 @@ class AerBackend(Backend, ABC):
         """Run a job"""
         # Start timer
         start = time.time()
+        compile_start = time.monotonic_ns()  #SW
 
         # Compile circuits
         circuits, noise_model = self._compile(circuits, **run_options)
@@ -465,6 +466,7 @@ class AerBackend(Backend, ABC):
             aer_circuit.circ_id = circ_id
 
         config = generate_aer_config(circuits, self.options, **run_options)
+        trace_events = [("compile", compile_start, time.monotonic_ns())]  #SW
 
         # Run simulation
         metadata_map = {
@@ -502,7 +504,11 @@ class AerBackend(Backend, ABC):
                 msg += f" and returned the following error message:\n{output['status']}"
             logger.warning(msg)
         if format_result:
-            return self._format_results(output)
+            format_start = time.monotonic_ns()  #SW
+            output = self._format_results(output)
+            trace_events.append(("format_result", format_start, time.monotonic_ns()))
+        if getattr(config, "trace_file", ""):
+            append_trace_events(config.trace_file, trace_events)
         return output
 
     @staticmethod
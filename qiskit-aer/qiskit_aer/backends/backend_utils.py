@@ -14,6 +14,7 @@
 """
 Aer simulator backend utils
 """
+import json
 import os
 from math import log2
 
@@ -419,6 +420,27 @@ BASIS_GATES = {
             "mcx_gray",
         ]
     ),
+    "subspace_statevector": sorted(
+        [
+            "u1",
+            "u3",
+            "u",
+            "p",
+            "r",
+            "rx",
+            "ry",
+            "rz",
+            "id",
+            "x",
+            "y",
+            "z",
+            "s",
+            "sdg",
+            "t",
+            "tdg",
+            "delay",
+        ]
+    ),
 }
 
 # Automatic method basis gates are the union of statevector,
@@ -455,6 +477,32 @@ def cpp_execute_circuits(controller, aer_circuits, noise_model, config):
     return controller.execute(aer_circuits, noise_model, config)
 
 
+#SW
+def append_trace_events(filename, events):
+    """Append spans of the Python side of a run to a trace file.
+
+    The file is written by the simulator with the ``trace_file`` option and
+    its timestamps are microseconds of the monotonic clock.
+
+    Args:
+        filename (str): the trace file.
+        events (list): tuples ``(name, start, stop)`` with the start and stop
+            times in nanoseconds of :func:`time.monotonic_ns`.
+    """
+    with open(filename, "a", encoding="utf-8") as file:
+        for name, start, stop in events:
+            event = {
+                "name": name,
+                "cat": "python",
+                "ph": "X",
+                "ts": start / 1e3,
+                "dur": (stop - start) / 1e3,
+                "pid": 1,
+                "tid": 0,
+            }
+            file.write(json.dumps(event) + ",\n")
+
+
 def available_methods(methods, devices):
     """Check available simulation methods"""
 
@@ -66,6 +66,8 @@ from ..library import (
     SaveUnitary,
     SetSuperOp,
     SaveExpectationValueVariance,
+    SaveHamiltonianExpectationValue,
+    SaveEnergyGradient,
     SaveStabilizer,
     SetStatevector,
     SetStabilizer,
@@ -293,6 +295,8 @@ NAME_MAPPING = {
     "save_unitary": SaveUnitary,
     "set_superop": SetSuperOp,
     "save_expval_var": SaveExpectationValueVariance,
+    "save_hamiltonian_expval": SaveHamiltonianExpectationValue,
+    "save_energy_gradient": SaveEnergyGradient,
     "save_stabilizer": SaveStabilizer,
     "set_statevector": SetStatevector,
     "set_stabilizer": SetStabilizer,
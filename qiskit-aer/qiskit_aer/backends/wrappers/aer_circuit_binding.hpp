@@ -169,6 +169,7 @@ void bind_aer_circuit(MODULE m) {
                   });
   aer_circuit.def("bfunc", &Circuit::bfunc);
   aer_circuit.def("gate", &Circuit::gate);
+  aer_circuit.def("mosq_cr", &Circuit::mosq_cr); //SW
   aer_circuit.def("diagonal", &Circuit::diagonal);
   aer_circuit.def("unitary", &Circuit::unitary);
   aer_circuit.def("roerror", &Circuit::roerror);
@@ -178,6 +179,12 @@ void bind_aer_circuit(MODULE m) {
   aer_circuit.def("save_state", &Circuit::save_state);
   aer_circuit.def("save_amplitudes", &Circuit::save_amplitudes);
   aer_circuit.def("save_expval", &Circuit::save_expval);
+  aer_circuit.def("save_hamiltonian_expval",
+                  &Circuit::save_hamiltonian_expval); //SW
+  aer_circuit.def("save_hamiltonian_expval_file",
+                  &Circuit::save_hamiltonian_expval_file); //SW
+  aer_circuit.def("save_energy_gradient",
+                  &Circuit::save_energy_gradient); //SW
   aer_circuit.def("initialize", &Circuit::initialize);
   aer_circuit.def("set_statevector", &Circuit::set_statevector<py::handle>);
   aer_circuit.def("set_density_matrix",
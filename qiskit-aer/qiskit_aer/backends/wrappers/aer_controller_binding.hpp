@@ -29,6 +29,7 @@ DISABLE_WARNING_POP
 #include "framework/pybind_casts.hpp"
 #include "framework/python_parser.hpp"
 #include "framework/results/pybind_result.hpp"
+#include "framework/trace.hpp"
 #include "framework/types.hpp"
 
 #include "controllers/aer_controller.hpp"
@@ -53,8 +54,11 @@ public:
   py::object execute(std::vector<std::shared_ptr<Circuit>> &circuits,
                      Noise::NoiseModel &noise_model,
                      AER::Config &config) const {
-    return AerToPy::to_python(
-        controller_execute<T>(circuits, noise_model, config));
+    //SW: the trace covers the conversion of the result
+    Tracing::Recording recording(config.trace_file);
+    auto result = controller_execute<T>(circuits, noise_model, config);
+    Tracing::Span span("python", "to_python");
+    return AerToPy::to_python(std::move(result));
   }
 
   py::object available_devices() {
@@ -340,6 +344,14 @@ void bind_aer_controller(MODULE m) {
       "_fusion_min_qubit",
       [](const Config &config) { return config._fusion_min_qubit.val; },
       [](Config &config, uint_t val) { config._fusion_min_qubit.value(val); });
+  aer_config.def_property(
+      "_fusion_enable_mosq",
+      [](const Config &config) { return config._fusion_enable_mosq.val; },
+      [](Config &config, bool val) { config._fusion_enable_mosq.value(val); });
+  aer_config.def_property(
+      "_fusion_mosq_cost",
+      [](const Config &config) { return config._fusion_mosq_cost.val; },
+      [](Config &config, double val) { config._fusion_mosq_cost.value(val); });
   aer_config.def_property(
       "fusion_cost_factor",
       [](const Config &config) { return config.fusion_cost_factor.val; },
@@ -433,6 +445,26 @@ void bind_aer_controller(MODULE m) {
       [](Config &config, bool val) {
         config.runtime_parameter_bind_enable.value(val);
       });
+  aer_config.def_readwrite("simulation_strategy",
+                           &Config::simulation_strategy);
+  aer_config.def_readwrite("trace_file", &Config::trace_file);
+  aer_config.def_readwrite("mosq_rewrite_enable",
+                           &Config::mosq_rewrite_enable);
+  aer_config.def_readwrite("mosq_block_enable", &Config::mosq_block_enable);
+  aer_config.def_property(
+      "mosq_block_max_qubit",
+      [](const Config &config) { return config.mosq_block_max_qubit.val; },
+      [](Config &config, uint_t val) {
+        config.mosq_block_max_qubit.value(val);
+      });
+  aer_config.def_readwrite("subspace_spin_sectors",
+                           &Config::subspace_spin_sectors);
+  aer_config.def_readwrite("statevector_real_amplitudes",
+                           &Config::statevector_real_amplitudes);
+  aer_config.def_readwrite("prefix_cache_max_memory_mb",
+                           &Config::prefix_cache_max_memory_mb);
+  aer_config.def_readwrite("statevector_persistent_parallel",
+                           &Config::statevector_persistent_parallel);
 
   aer_config.def(py::pickle(
       [](const AER::Config &config) {
@@ -523,11 +555,22 @@ void bind_aer_controller(MODULE m) {
             write_value(80, config.shot_branching_enable),
             write_value(81, config.shot_branching_sampling_enable),
             write_value(82, config.target_gpus),
-            write_value(83, config.runtime_parameter_bind_enable));
+            write_value(83, config.runtime_parameter_bind_enable),
+            write_value(84, config.mosq_block_enable),
+            write_value(85, config.mosq_block_max_qubit),
+            write_value(86, config.subspace_spin_sectors),
+            write_value(87, config.statevector_real_amplitudes),
+            write_value(88, config.prefix_cache_max_memory_mb),
+            write_value(89, config.mosq_rewrite_enable),
+            write_value(90, config._fusion_enable_mosq),
+            write_value(91, config._fusion_mosq_cost),
+            write_value(92, config.simulation_strategy),
+            write_value(93, config.trace_file),
+            write_value(94, config.statevector_persistent_parallel));
       },
       [](py::tuple t) {
         AER::Config config;
-        if (t.size() != 84)
+        if (t.size() != 95)
           throw std::runtime_error("Invalid serialization format.");
 
         read_value(t, 0, config.shots);
@@ -619,6 +662,17 @@ void bind_aer_controller(MODULE m) {
         read_value(t, 81, config.shot_branching_sampling_enable);
         read_value(t, 82, config.target_gpus);
         read_value(t, 83, config.runtime_parameter_bind_enable);
+        read_value(t, 84, config.mosq_block_enable);
+        read_value(t, 85, config.mosq_block_max_qubit);
+        read_value(t, 86, config.subspace_spin_sectors);
+        read_value(t, 87, config.statevector_real_amplitudes);
+        read_value(t, 88, config.prefix_cache_max_memory_mb);
+        read_value(t, 89, config.mosq_rewrite_enable);
+        read_value(t, 90, config._fusion_enable_mosq);
+        read_value(t, 91, config._fusion_mosq_cost);
+        read_value(t, 92, config.simulation_strategy);
+        read_value(t, 93, config.trace_file);
+        read_value(t, 94, config.statevector_persistent_parallel);
         return config;
       }));
 }
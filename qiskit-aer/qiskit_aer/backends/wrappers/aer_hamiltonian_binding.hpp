@@ -0,0 +1,94 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2023.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_hamiltonian_binding_hpp_
+#define _aer_hamiltonian_binding_hpp_
+
+#include "misc/warnings.hpp"
+DISABLE_WARNING_PUSH
+#include <pybind11/complex.h>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+DISABLE_WARNING_POP
+#if defined(_MSC_VER)
+#undef snprintf
+#endif
+
+#include <string>
+#include <vector>
+
+#include "framework/jordan_wigner.hpp"
+#include "framework/types.hpp"
+
+namespace py = pybind11;
+using namespace AER;
+
+//SW
+template <typename MODULE>
+void bind_aer_hamiltonian(MODULE m) {
+  // Return (num_qubits, x_masks, z_masks, coeffs) of a Pauli table as numpy
+  // arrays
+  auto to_arrays = [](const PauliTable &table) {
+    return py::make_tuple(
+        table.num_qubits,
+        py::array_t<uint64_t>(table.x_masks.size(), table.x_masks.data()),
+        py::array_t<uint64_t>(table.z_masks.size(), table.z_masks.data()),
+        py::array_t<double>(table.coeffs.size(), table.coeffs.data()));
+  };
+
+  // Jordan-Wigner mapping of FermionicOp labels and coefficients. The
+  // mapping runs with the GIL released.
+  m.def(
+      "jordan_wigner",
+      [to_arrays](const std::vector<std::string> &labels,
+                  const std::vector<complex_t> &coeffs,
+                  const uint_t num_spin_orbitals, const double atol,
+                  const int num_threads) {
+        if (labels.size() != coeffs.size()) {
+          throw std::invalid_argument(
+              "jordan_wigner: labels and coefficients have different "
+              "lengths.");
+        }
+        FermionicOperator op;
+        op.num_spin_orbitals = num_spin_orbitals;
+        for (uint_t k = 0; k < labels.size(); ++k)
+          op.add_term(labels[k], coeffs[k]);
+        PauliTable table;
+        {
+          py::gil_scoped_release release;
+          table = jordan_wigner(op, atol, num_threads);
+        }
+        return to_arrays(table);
+      },
+      py::arg("labels"), py::arg("coeffs"), py::arg("num_spin_orbitals") = 0,
+      py::arg("atol") = 1e-8, py::arg("num_threads") = 0);
+
+  // Jordan-Wigner mapping of a fermionic operator in the text format of the
+  // MOSQ molecule cache
+  m.def(
+      "jordan_wigner_file",
+      [to_arrays](const std::string &path, const double atol,
+                  const int num_threads) {
+        PauliTable table;
+        {
+          py::gil_scoped_release release;
+          table = jordan_wigner(load_fermionic_op(path), atol, num_threads);
+        }
+        return to_arrays(table);
+      },
+      py::arg("path"), py::arg("atol") = 1e-8, py::arg("num_threads") = 0);
+}
+
+#endif
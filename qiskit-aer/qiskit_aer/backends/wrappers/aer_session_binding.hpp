@@ -0,0 +1,107 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2023.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_session_binding_hpp_
+#define _aer_session_binding_hpp_
+
+#include "misc/warnings.hpp"
+DISABLE_WARNING_PUSH
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+DISABLE_WARNING_POP
+#if defined(_MSC_VER)
+#undef snprintf
+#endif
+
+#include <vector>
+
+#include "framework/pybind_casts.hpp"
+#include "framework/python_parser.hpp"
+#include "framework/types.hpp"
+
+#include "controllers/session_controller.hpp"
+
+namespace py = pybind11;
+using namespace AER;
+
+//SW
+template <typename MODULE>
+void bind_aer_session(MODULE m) {
+  py::class_<AerSession> aer_session(m, "AerSessionWrapper");
+
+  aer_session.def(py::init<>(), "constructor");
+
+  aer_session.def("__repr__", [](const AerSession &session) {
+    std::stringstream ss;
+    ss << "AerSessionWrapper("
+       << "initialized=" << session.is_initialized()
+       << ", num_values=" << session.num_values()
+       << ", real_amplitudes=" << session.real_amplitudes();
+    ss << ")";
+    return ss.str();
+  });
+
+  aer_session.def(
+      "initialize",
+      [](AerSession &session, const std::shared_ptr<Circuit> &circuit,
+         py::object noise_model, const AER::Config &config,
+         const std::vector<std::pair<int_t, int_t>> &positions) {
+        Noise::NoiseModel noise_model_native;
+        if (noise_model)
+          noise_model_native.load_from_json(noise_model);
+        session.initialize(*circuit, noise_model_native, config, positions);
+      });
+
+  aer_session.def("is_initialized", &AerSession::is_initialized);
+  aer_session.def("num_values", &AerSession::num_values);
+  aer_session.def("real_amplitudes", &AerSession::real_amplitudes);
+
+  // The values are read from a contiguous float64 buffer without a copy and
+  // the GIL is released during the simulation
+  aer_session.def(
+      "evaluate",
+      [](AerSession &session,
+         const py::array_t<double, py::array::c_style | py::array::forcecast>
+             &values) {
+        const double *data = values.data();
+        const uint_t size = values.size();
+        std::vector<double> expvals;
+        {
+          py::gil_scoped_release release;
+          expvals = session.evaluate(data, size);
+        }
+        return py::array_t<double>(expvals.size(), expvals.data());
+      });
+
+  // Return (energy, gradient) of the first save_hamiltonian_expval
+  aer_session.def(
+      "gradient",
+      [](AerSession &session,
+         const py::array_t<double, py::array::c_style | py::array::forcecast>
+             &values) {
+        const double *data = values.data();
+        const uint_t size = values.size();
+        std::vector<double> grad;
+        double energy = 0.;
+        {
+          py::gil_scoped_release release;
+          grad = session.gradient(data, size, energy);
+        }
+        return py::make_tuple(energy,
+                              py::array_t<double>(grad.size(), grad.data()));
+      });
+}
+
+#endif
@@ -15,6 +15,8 @@ DISABLE_WARNING_POP
 #include "aer_controller_binding.hpp"
 #include "aer_state_binding.hpp"
 #include "aer_circuit_binding.hpp"
+#include "aer_session_binding.hpp"
+#include "aer_hamiltonian_binding.hpp"
 
 using namespace AER;
 
@@ -27,4 +29,6 @@ PYBIND11_MODULE(controller_wrappers, m) {
     bind_aer_controller(m);
     bind_aer_state(m);
     bind_aer_circuit(m);
+    bind_aer_session(m);
+    bind_aer_hamiltonian(m);
 }
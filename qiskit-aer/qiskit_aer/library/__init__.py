@@ -110,8 +110,10 @@ custom ``QuantumCircuit`` methods
 .. autosummary::
     :toctree: ../stubs/
 
+    SaveEnergyGradient
     SaveExpectationValue
     SaveExpectationValueVariance
+    SaveHamiltonianExpectationValue
     SaveProbabilities
     SaveProbabilitiesDict
     SaveAmplitudes
@@ -153,8 +155,10 @@ following ``QuantumCircuit`` methods which are patched when importing Aer.
     save_amplitudes_squared
     save_clifford
     save_density_matrix
+    save_energy_gradient
     save_expectation_value
     save_expectation_value_variance
+    save_hamiltonian_expectation_value
     save_matrix_product_state
     save_probabilities
     save_probabilities_dict
@@ -181,8 +185,10 @@ __all__ = [
     "SaveAmplitudesSquared",
     "SaveClifford",
     "SaveDensityMatrix",
+    "SaveEnergyGradient",
     "SaveExpectationValue",
     "SaveExpectationValueVariance",
+    "SaveHamiltonianExpectationValue",
     "SaveMatrixProductState",
     "SaveProbabilities",
     "SaveProbabilitiesDict",
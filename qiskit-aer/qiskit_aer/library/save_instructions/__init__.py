@@ -17,6 +17,10 @@ from .save_expectation_value import (
     save_expectation_value,
     SaveExpectationValueVariance,
     save_expectation_value_variance,
+    SaveHamiltonianExpectationValue,
+    save_hamiltonian_expectation_value,
+    SaveEnergyGradient,
+    save_energy_gradient,
 )
 from .save_probabilities import (
     SaveProbabilities,
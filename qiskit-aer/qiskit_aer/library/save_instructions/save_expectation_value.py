@@ -136,6 +136,167 @@ class SaveExpectationValueVariance(SaveAverageData):
         )
 
 
+class SaveHamiltonianExpectationValue(SaveAverageData):
+    """Save expectation value of a Pauli sum given as a table of Pauli masks."""
+
+    def __init__(
+        self,
+        operator,
+        label="hamiltonian_expectation_value",
+        per_term_label=None,
+        unnormalized=False,
+        pershot=False,
+        conditional=False,
+    ):
+        r"""Instruction to save the expectation value of a Pauli sum.
+
+        The operator is passed to the simulator as a table of
+        ``(x_mask, z_mask, coeff)`` terms, where bit ``j`` of a mask refers to
+        the ``j``-th qubit of the instruction and a bit set in both masks is
+        a Y. The simulator evaluates all terms natively and saves the
+        single value :math:`\sum_k c_k \langle P_k\rangle`.
+
+        Args:
+            operator (Pauli or SparsePauliOp or Operator or QubitHamiltonian):
+                a Hermitian operator on at most 64 qubits.
+            label (str): the key for retrieving saved data from results.
+            per_term_label (str or None): if set, the key for retrieving the
+                list of expectation values :math:`\langle P_k\rangle` of the
+                terms [Default: None].
+            unnormalized (bool): If True return save the unnormalized accumulated
+                                 or conditional accumulated expectation value
+                                 over all shot [Default: False].
+            pershot (bool): if True save a list of expectation values for each shot
+                            of the simulation rather than the average over
+                            all shots [Default: False].
+            conditional (bool): if True save the average or pershot data
+                                conditional on the current classical register
+                                values [Default: False].
+
+        Raises:
+            ValueError: if the input operator is not Hermitian or acts on
+                more than 64 qubits.
+
+        .. note::
+
+            This instruction can be directly appended to a circuit using the
+            :func:`save_hamiltonian_expectation_value` circuit method.
+        """
+        num_qubits, params, self._hamiltonian_file = _hamiltonian_params(operator)
+        self._per_term_label = per_term_label
+        super().__init__(
+            "save_hamiltonian_expval",
+            num_qubits,
+            label,
+            unnormalized=unnormalized,
+            pershot=pershot,
+            conditional=conditional,
+            params=params,
+        )
+
+    @property
+    def per_term_label(self):
+        """The key of the per term expectation values, or None."""
+        return self._per_term_label
+
+    @property
+    def hamiltonian_file(self):
+        """The :class:`~qiskit_aer.quantum_info.QubitHamiltonian` file the
+        simulator loads the terms from, or None."""
+        return self._hamiltonian_file
+
+
+class SaveEnergyGradient(SaveAverageData):
+    """Save the gradient of a Pauli sum energy with respect to the angles of
+    the Pauli rotations applied before the instruction."""
+
+    def __init__(
+        self,
+        operator,
+        label="energy_gradient",
+        energy_label=None,
+        pershot=False,
+        conditional=False,
+    ):
+        r"""Instruction to save the energy gradient by the adjoint method.
+
+        The gradient is taken with respect to the angle of every Pauli
+        rotation before the instruction (``MOSQ``, ``MOSQ_CR``, ``MOSQ_BLOCK``,
+        ``rx``, ``ry``, ``rz``, ``p``, ``u1``, ``rxx``, ``ryy``, ``rzz`` and
+        ``rzx``), in the order they are applied. It is computed with a single
+        reverse sweep over the circuit, so every other instruction before it
+        must be an invertible gate.
+
+        Args:
+            operator (Pauli or SparsePauliOp or Operator or QubitHamiltonian):
+                a Hermitian operator on at most 64 qubits.
+            label (str): the key for retrieving the gradient from results.
+            energy_label (str or None): if set, the key for retrieving the
+                energy :math:`\langle H\rangle` [Default: None].
+            pershot (bool): if True save a list of gradients for each shot
+                            of the simulation rather than the average over
+                            all shots [Default: False].
+            conditional (bool): if True save the average or pershot data
+                                conditional on the current classical register
+                                values [Default: False].
+
+        Raises:
+            ValueError: if the input operator is not Hermitian or acts on
+                more than 64 qubits.
+
+        .. note::
+
+            This instruction can be directly appended to a circuit using the
+            :func:`save_energy_gradient` circuit method.
+        """
+        num_qubits, params, self._hamiltonian_file = _hamiltonian_params(operator)
+        self._energy_label = energy_label
+        super().__init__(
+            "save_energy_gradient",
+            num_qubits,
+            label,
+            pershot=pershot,
+            conditional=conditional,
+            params=params,
+        )
+
+    @property
+    def energy_label(self):
+        """The key of the energy, or None."""
+        return self._energy_label
+
+    @property
+    def hamiltonian_file(self):
+        """The :class:`~qiskit_aer.quantum_info.QubitHamiltonian` file the
+        simulator loads the terms from, or None."""
+        return self._hamiltonian_file
+
+
+def _hamiltonian_params(operator):
+    # pylint: disable=cyclic-import
+    from ...quantum_info.operators.qubit_hamiltonian import QubitHamiltonian, pauli_masks
+
+    # The terms of a Hamiltonian file are loaded by the simulator
+    if isinstance(operator, QubitHamiltonian):
+        return operator.num_qubits, [], operator.filename
+
+    if isinstance(operator, Pauli):
+        operator = SparsePauliOp(operator)
+    elif not isinstance(operator, SparsePauliOp):
+        operator = SparsePauliOp.from_operator(Operator(operator))
+    if operator.num_qubits > 64:
+        raise ValueError("Operator acts on more than 64 qubits.")
+    # Pauli phases other than the Y phase are folded into the coefficients
+    coeffs = operator.coeffs * (-1j) ** operator.paulis.phase
+    if not allclose(coeffs.imag, 0):
+        raise ValueError("Input operator is not Hermitian.")
+    x_masks, z_masks = pauli_masks(operator.paulis)
+    params = [
+        [x, z, c] for x, z, c in zip(x_masks.tolist(), z_masks.tolist(), coeffs.real.tolist())
+    ]
+    return operator.num_qubits, params, None
+
+
 def _expval_params(operator, variance=False):
     # Convert O to SparsePauliOp representation
     if isinstance(operator, Pauli):
@@ -253,5 +414,104 @@ def save_expectation_value_variance(
     return self.append(instr, qubits)
 
 
+def save_hamiltonian_expectation_value(
+    self,
+    operator,
+    qubits,
+    label="hamiltonian_expectation_value",
+    per_term_label=None,
+    unnormalized=False,
+    pershot=False,
+    conditional=False,
+):
+    r"""Save the expectation value of a Pauli sum evaluated natively.
+
+    Args:
+        operator (Pauli or SparsePauliOp or Operator or QubitHamiltonian):
+            a Hermitian operator.
+        qubits (list): circuit qubits to apply instruction.
+        label (str): the key for retrieving saved data from results.
+        per_term_label (str or None): if set, the key for retrieving the
+            expectation values of the individual Pauli terms [Default: None].
+        unnormalized (bool): If True return save the unnormalized accumulated
+                             or conditional accumulated expectation value
+                             over all shot [Default: False].
+        pershot (bool): if True save a list of expectation values for each
+                        shot of the simulation rather than the average over
+                        all shots [Default: False].
+        conditional (bool): if True save the average or pershot data
+                            conditional on the current classical register
+                            values [Default: False].
+
+    Returns:
+        QuantumCircuit: with attached instruction.
+
+    Raises:
+        ValueError: if the input operator is not Hermitian.
+
+    .. note::
+
+        This method appends a :class:`SaveHamiltonianExpectationValue`
+        instruction to the quantum circuit.
+    """
+    instr = SaveHamiltonianExpectationValue(
+        operator,
+        label=label,
+        per_term_label=per_term_label,
+        unnormalized=unnormalized,
+        pershot=pershot,
+        conditional=conditional,
+    )
+    return self.append(instr, qubits)
+
+
+def save_energy_gradient(
+    self,
+    operator,
+    qubits,
+    label="energy_gradient",
+    energy_label=None,
+    pershot=False,
+    conditional=False,
+):
+    r"""Save the gradient of a Pauli sum energy by the adjoint method.
+
+    Args:
+        operator (Pauli or SparsePauliOp or Operator or QubitHamiltonian):
+            a Hermitian operator.
+        qubits (list): circuit qubits to apply instruction.
+        label (str): the key for retrieving the gradient from results.
+        energy_label (str or None): if set, the key for retrieving the
+            energy [Default: None].
+        pershot (bool): if True save a list of gradients for each shot of
+                        the simulation rather than the average over all
+                        shots [Default: False].
+        conditional (bool): if True save the average or pershot data
+                            conditional on the current classical register
+                            values [Default: False].
+
+    Returns:
+        QuantumCircuit: with attached instruction.
+
+    Raises:
+        ValueError: if the input operator is not Hermitian.
+
+    .. note::
+
+        This method appends a :class:`SaveEnergyGradient` instruction to the
+        quantum circuit.
+    """
+    instr = SaveEnergyGradient(
+        operator,
+        label=label,
+        energy_label=energy_label,
+        pershot=pershot,
+        conditional=conditional,
+    )
+    return self.append(instr, qubits)
+
+
 QuantumCircuit.save_expectation_value = save_expectation_value
 QuantumCircuit.save_expectation_value_variance = save_expectation_value_variance
+QuantumCircuit.save_hamiltonian_expectation_value = save_hamiltonian_expectation_value
+QuantumCircuit.save_energy_gradient = save_energy_gradient
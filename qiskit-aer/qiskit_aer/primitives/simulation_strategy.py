@@ -0,0 +1,72 @@
+# This code is part of Qiskit.
+#
+# (C) Copyright IBM 2024.
+#
+# This code is licensed under the Apache License, Version 2.0. You may
+# obtain a copy of this license in the LICENSE.txt file in the root directory
+# of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+#
+# Any modifications or derivative works of this code must retain this
+# copyright notice, and modified files need to carry a notice indicating
+# that they have been altered from the originals.
+
+"""Selection of the ``"auto"`` simulation strategy of the Aer primitives."""
+
+from __future__ import annotations
+
+import time
+
+SIMULATION_STRATEGIES = ("gates", "fusion", "mosq", "mosq_fusion")
+
+
+#SW
+class StrategySelector:
+    """Resolve ``simulation_strategy="auto"`` by timing each strategy.
+
+    The first run simulates the circuit with each of
+    :data:`SIMULATION_STRATEGIES` and keeps the fastest one, which is used by
+    all later runs, such as the remaining iterations of an optimizer. If the
+    first run binds several parameter sets, the calibration only binds the
+    first one and the full run follows with the selected strategy.
+    """
+
+    def __init__(self):
+        self.strategy = None
+        self.timings = {}
+
+    def run(self, backend, circuit, parameter_binds, **run_options):
+        """Run a circuit and return its result.
+
+        Args:
+            backend: the :class:`~qiskit_aer.AerSimulator` to run on.
+            circuit: the circuit to run.
+            parameter_binds: the parameter binds of the circuit.
+            run_options: options passed to ``backend.run``.
+
+        Returns:
+            Result: the result of the run.
+        """
+        if run_options.get("simulation_strategy") != "auto":
+            return backend.run(circuit, parameter_binds=parameter_binds, **run_options).result()
+        if self.strategy is None:
+            calibration_binds = [
+                {param: values[:1] for param, values in binds.items()} for binds in parameter_binds
+            ]
+            full = all(
+                len(values) <= 1 for binds in parameter_binds for values in binds.values()
+            )
+            best = None
+            for strategy in SIMULATION_STRATEGIES:
+                run_options["simulation_strategy"] = strategy
+                start = time.perf_counter()
+                result = backend.run(
+                    circuit, parameter_binds=calibration_binds, **run_options
+                ).result()
+                self.timings[strategy] = time.perf_counter() - start
+                if best is None or self.timings[strategy] < self.timings[best[0]]:
+                    best = (strategy, result)
+            self.strategy = best[0]
+            if full:
+                return best[1]
+        run_options["simulation_strategy"] = self.strategy
+        return backend.run(circuit, parameter_binds=parameter_binds, **run_options).result()
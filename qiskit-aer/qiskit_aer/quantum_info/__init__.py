@@ -26,7 +26,16 @@ States
    AerStatevector
    AerDensityMatrix
 
+Operators
+=========
+
+.. autosummary::
+   :toctree: ../stubs/
+
+   QubitHamiltonian
+
 """
 
 from .states import AerStatevector
 from .states import AerDensityMatrix
+from .operators import QubitHamiltonian
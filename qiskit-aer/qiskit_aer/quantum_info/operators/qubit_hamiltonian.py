@@ -0,0 +1,321 @@
+# This code is part of Qiskit.
+#
+# (C) Copyright IBM 2024.
+#
+# This code is licensed under the Apache License, Version 2.0. You may
+# obtain a copy of this license in the LICENSE.txt file in the root directory
+# of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+#
+# Any modifications or derivative works of this code must retain this
+# copyright notice, and modified files need to carry a notice indicating
+# that they have been altered from the originals.
+"""
+Qubit Hamiltonian stored in a memory-mapped binary file
+"""
+
+import os
+
+import numpy as np
+
+from qiskit.quantum_info import Pauli, PauliList, SparsePauliOp
+
+_MAGIC = b"AERQHAM"
+_VERSION = 1
+_HEADER = np.dtype(
+    [
+        ("magic", "S8"),
+        ("version", "<u4"),
+        ("num_qubits", "<u4"),
+        ("num_terms", "<u8"),
+        ("num_spatial_orbitals", "<u4"),
+        ("num_alpha", "<u4"),
+        ("num_beta", "<u4"),
+        ("reserved", "<u4"),
+        ("nuclear_repulsion_energy", "<f8"),
+        ("reference_energy", "<f8"),
+    ]
+)
+
+
+#SW
+class QubitHamiltonian:
+    """A Pauli sum in the binary format read natively by the simulator.
+
+    The file holds the ``x`` and ``z`` masks of each Pauli term packed into
+    64-bit integers, the real coefficients and the metadata of the molecular
+    problem the Hamiltonian was mapped from. It is written once with
+    :meth:`save` and memory-mapped afterwards, so loading takes milliseconds
+    instead of rebuilding the Pauli sum from the fermionic operator.
+
+    A :class:`QubitHamiltonian` can be passed to
+    :meth:`~qiskit.circuit.QuantumCircuit.save_hamiltonian_expectation_value`,
+    :meth:`~qiskit.circuit.QuantumCircuit.save_energy_gradient`,
+    :class:`~qiskit_aer.AerSession` and as the observable of a
+    ``(circuit, hamiltonian, parameter_values)`` pub of
+    :class:`~qiskit_aer.primitives.EstimatorV2`, in which case the simulator
+    maps the file itself and the terms are not passed through Python.
+    """
+
+    def __init__(self, filename):
+        """Map a qubit Hamiltonian file.
+
+        Args:
+            filename (str): path of a file written by :meth:`save`.
+
+        Raises:
+            ValueError: if the file is not a qubit Hamiltonian file.
+        """
+        header = np.fromfile(filename, dtype=_HEADER, count=1)
+        if header.size != 1 or header["magic"][0] != _MAGIC:
+            raise ValueError(f"{filename} is not a qubit Hamiltonian file.")
+        header = header[0]
+        if header["version"] != _VERSION:
+            raise ValueError(f"{filename} has unsupported version {header['version']}.")
+        num_terms = int(header["num_terms"])
+        self._filename = str(filename)
+        self._num_qubits = int(header["num_qubits"])
+        self._metadata = {
+            "num_spatial_orbitals": int(header["num_spatial_orbitals"]),
+            "num_particles": (int(header["num_alpha"]), int(header["num_beta"])),
+            "nuclear_repulsion_energy": float(header["nuclear_repulsion_energy"]),
+            "reference_energy": float(header["reference_energy"]),
+        }
+        if num_terms > 0:
+            masks = np.memmap(
+                filename, dtype="<u8", mode="r", offset=_HEADER.itemsize, shape=(2, num_terms)
+            )
+            self._x_masks, self._z_masks = masks[0], masks[1]
+            self._coeffs = np.memmap(
+                filename,
+                dtype="<f8",
+                mode="r",
+                offset=_HEADER.itemsize + masks.nbytes,
+                shape=(num_terms,),
+            )
+        else:
+            self._x_masks = self._z_masks = np.zeros(0, dtype=np.uint64)
+            self._coeffs = np.zeros(0)
+
+    @classmethod
+    def save(
+        cls,
+        filename,
+        operator,
+        num_spatial_orbitals=0,
+        num_particles=(0, 0),
+        nuclear_repulsion_energy=0.0,
+        reference_energy=float("nan"),
+    ):
+        """Write a Hermitian Pauli sum and its metadata to a file.
+
+        Args:
+            filename (str): path of the file to write.
+            operator (SparsePauliOp or Pauli): a Hermitian operator on at
+                most 64 qubits.
+            num_spatial_orbitals (int): number of spatial orbitals of the
+                molecular problem.
+            num_particles (tuple): number of alpha and beta particles.
+            nuclear_repulsion_energy (float): constant energy offset not
+                included in the operator.
+            reference_energy (float): reference ground state energy.
+
+        Returns:
+            QubitHamiltonian: the mapped file.
+
+        Raises:
+            ValueError: if the operator is not Hermitian or acts on more
+                than 64 qubits.
+        """
+        if isinstance(operator, Pauli):
+            operator = SparsePauliOp(operator)
+        if operator.num_qubits > 64:
+            raise ValueError("Operator acts on more than 64 qubits.")
+        coeffs = operator.coeffs * (-1j) ** operator.paulis.phase
+        if not np.allclose(coeffs.imag, 0):
+            raise ValueError("Input operator is not Hermitian.")
+        x_masks, z_masks = pauli_masks(operator.paulis)
+        _write(
+            filename,
+            operator.num_qubits,
+            x_masks,
+            z_masks,
+            coeffs.real,
+            num_spatial_orbitals,
+            num_particles,
+            nuclear_repulsion_energy,
+            reference_energy,
+        )
+        return cls(filename)
+
+    @classmethod
+    def from_fermionic_op(
+        cls,
+        filename,
+        fermionic_op,
+        num_spin_orbitals=None,
+        num_spatial_orbitals=0,
+        num_particles=(0, 0),
+        nuclear_repulsion_energy=0.0,
+        reference_energy=float("nan"),
+        atol=1e-8,
+        num_threads=0,
+    ):
+        """Map a fermionic operator by the Jordan-Wigner transformation and
+        write the qubit Hamiltonian to a file.
+
+        The mapping is the one of qiskit-nature's ``JordanWignerMapper``,
+        computed natively in parallel without building Pauli strings. Equal
+        Pauli terms are summed and terms with a coefficient of at most
+        ``atol`` in absolute value are dropped.
+
+        Args:
+            filename (str): path of the file to write.
+            fermionic_op (str or Mapping): a Hermitian fermionic operator as
+                a mapping of labels such as ``"+_0 -_1"`` to coefficients
+                (for example a qiskit-nature ``FermionicOp``), or the path of
+                a ``<molecule>_fermionic_op.txt`` text file.
+            num_spin_orbitals (int or None): number of spin orbitals, which
+                is the number of qubits. If ``None`` it is taken from the
+                operator.
+            num_spatial_orbitals (int): number of spatial orbitals of the
+                molecular problem.
+            num_particles (tuple): number of alpha and beta particles.
+            nuclear_repulsion_energy (float): constant energy offset not
+                included in the operator.
+            reference_energy (float): reference ground state energy.
+            atol (float): absolute tolerance of dropped terms.
+            num_threads (int): number of threads, or 0 for the OpenMP
+                default.
+
+        Returns:
+            QubitHamiltonian: the mapped file.
+
+        Raises:
+            ValueError: if the operator is not Hermitian or has more than
+                64 spin orbitals.
+        """
+        # pylint: disable=import-error, no-name-in-module
+        from qiskit_aer.backends.controller_wrappers import jordan_wigner, jordan_wigner_file
+
+        try:
+            if isinstance(fermionic_op, (str, bytes, os.PathLike)):
+                num_qubits, x_masks, z_masks, coeffs = jordan_wigner_file(
+                    os.fspath(fermionic_op), atol, num_threads
+                )
+            else:
+                if num_spin_orbitals is None:
+                    num_spin_orbitals = getattr(fermionic_op, "num_spin_orbitals", None) or 0
+                num_qubits, x_masks, z_masks, coeffs = jordan_wigner(
+                    list(fermionic_op.keys()),
+                    [complex(coeff) for coeff in fermionic_op.values()],
+                    num_spin_orbitals,
+                    atol,
+                    num_threads,
+                )
+        except Exception as err:
+            raise ValueError(f"Jordan-Wigner mapping failed: {err}") from err
+        if num_spin_orbitals is not None and num_spin_orbitals > num_qubits:
+            num_qubits = num_spin_orbitals
+        _write(
+            filename,
+            num_qubits,
+            x_masks,
+            z_masks,
+            coeffs,
+            num_spatial_orbitals,
+            num_particles,
+            nuclear_repulsion_energy,
+            reference_energy,
+        )
+        return cls(filename)
+
+    @property
+    def filename(self):
+        """Path of the mapped file."""
+        return self._filename
+
+    @property
+    def num_qubits(self):
+        """Number of qubits."""
+        return self._num_qubits
+
+    @property
+    def num_terms(self):
+        """Number of Pauli terms."""
+        return len(self._coeffs)
+
+    @property
+    def x_masks(self):
+        """Read-only array of the ``x`` masks of the terms."""
+        return self._x_masks
+
+    @property
+    def z_masks(self):
+        """Read-only array of the ``z`` masks of the terms."""
+        return self._z_masks
+
+    @property
+    def coeffs(self):
+        """Read-only array of the real coefficients of the terms."""
+        return self._coeffs
+
+    @property
+    def metadata(self):
+        """Dict of ``num_spatial_orbitals``, ``num_particles``,
+        ``nuclear_repulsion_energy`` and ``reference_energy``."""
+        return dict(self._metadata)
+
+    def to_sparse_pauli_op(self):
+        """Return the Pauli sum as a :class:`~qiskit.quantum_info.SparsePauliOp`."""
+        shifts = np.arange(self._num_qubits, dtype=np.uint64)
+        x = ((self._x_masks[:, None] >> shifts) & np.uint64(1)).astype(bool)
+        z = ((self._z_masks[:, None] >> shifts) & np.uint64(1)).astype(bool)
+        return SparsePauliOp(PauliList.from_symplectic(z, x), np.array(self._coeffs))
+
+    def __len__(self):
+        return self.num_terms
+
+    def __repr__(self):
+        return (
+            f"{type(self).__name__}('{self._filename}', num_qubits={self._num_qubits}, "
+            f"num_terms={self.num_terms})"
+        )
+
+
+def _write(
+    filename,
+    num_qubits,
+    x_masks,
+    z_masks,
+    coeffs,
+    num_spatial_orbitals,
+    num_particles,
+    nuclear_repulsion_energy,
+    reference_energy,
+):
+    header = np.zeros(1, dtype=_HEADER)
+    header["magic"] = _MAGIC
+    header["version"] = _VERSION
+    header["num_qubits"] = num_qubits
+    header["num_terms"] = len(coeffs)
+    header["num_spatial_orbitals"] = num_spatial_orbitals
+    header["num_alpha"], header["num_beta"] = num_particles
+    header["nuclear_repulsion_energy"] = nuclear_repulsion_energy
+    header["reference_energy"] = reference_energy
+    with open(filename, "wb") as file:
+        file.write(header.tobytes())
+        file.write(np.ascontiguousarray(x_masks, dtype="<u8").tobytes())
+        file.write(np.ascontiguousarray(z_masks, dtype="<u8").tobytes())
+        file.write(np.ascontiguousarray(coeffs, dtype="<f8").tobytes())
+
+
+def pauli_masks(paulis):
+    """Return the ``x`` and ``z`` masks of a :class:`~qiskit.quantum_info.PauliList`
+    as ``uint64`` arrays, bit ``j`` referring to qubit ``j``."""
+
+    def pack(bits):
+        packed = np.packbits(bits, axis=1, bitorder="little")
+        packed = np.pad(packed, ((0, 0), (0, 8 - packed.shape[1])))
+        return packed.view("<u8")[:, 0]
+
+    return pack(paulis.x), pack(paulis.z)
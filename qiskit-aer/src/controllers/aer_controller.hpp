@@ -58,6 +58,7 @@
 #include "simulators/multi_state_executor.hpp"
 
 #include "simulators/density_matrix/densitymatrix_executor.hpp"
+#include "simulators/statevector/real_statevector_executor.hpp"
 #include "simulators/statevector/statevector_executor.hpp"
 #include "simulators/tensor_network/tensor_net_executor.hpp"
 #include "simulators/unitary/unitary_executor.hpp"
@@ -141,6 +142,13 @@ protected:
   std::shared_ptr<CircuitExecutor::Base>
   make_circuit_executor(const Method method) const;
 
+  // Return true if a statevector circuit can be simulated with real
+  // amplitudes, and the executor for it
+  bool use_real_amplitudes(const Config &config, const Circuit &circ,
+                           const Noise::NoiseModel &noise,
+                           const Method method) const; //SW
+  std::shared_ptr<CircuitExecutor::Base> make_real_circuit_executor() const;
+
   // Return a vector of simulation methods for each circuit.
   // If the default method is automatic this will be computed based on the
   // circuit and noise model.
@@ -277,6 +285,8 @@ void Controller::set_config(const Config &config) {
     method_ = Method::superop;
   } else if (config.method == "tensor_network") {
     method_ = Method::tensor_network;
+  } else if (config.method == "subspace_statevector") {
+    method_ = Method::subspace_statevector; //SW
   } else if (config.method != "automatic") {
     throw std::runtime_error(std::string("Invalid simulation method (") +
                              method + std::string(")."));
@@ -543,7 +553,11 @@ Result Controller::execute(std::vector<std::shared_ptr<Circuit>> &circuits,
     try {
       uint_t res_pos = 0;
       for (uint_t i = 0; i < circuits.size(); i++) {
-        executors[i] = make_circuit_executor(methods[i]);
+        if (use_real_amplitudes(config, *circuits[i], noise_model,
+                                methods[i]))
+          executors[i] = make_real_circuit_executor(); //SW
+        else
+          executors[i] = make_circuit_executor(methods[i]);
         required_memory_mb_list[i] =
             executors[i]->required_memory_mb(config, *circuits[i], noise_model);
         for (uint_t j = 0; j < circuits[i]->num_bind_params; j++) {
@@ -760,6 +774,20 @@ Controller::make_circuit_executor(const Method method) const {
           QubitSuperoperator::State<QV::Superoperator<float>>>>();
     }
     break;
+  case Method::subspace_statevector: //SW
+    if (sim_device_ != Device::CPU) {
+      throw std::runtime_error(
+          "Simulation method \"subspace_statevector\" is only supported on "
+          "CPU");
+    }
+    if (sim_precision_ == Precision::Double) {
+      return std::make_shared<CircuitExecutor::Executor<
+          SubspaceStatevector::State<QV::SubspaceVector<double>>>>();
+    } else {
+      return std::make_shared<CircuitExecutor::Executor<
+          SubspaceStatevector::State<QV::SubspaceVector<float>>>>();
+    }
+    break;
   case Method::stabilizer: {
     return std::make_shared<CircuitExecutor::Executor<Stabilizer::State>>();
   } break;
@@ -788,6 +816,26 @@ Controller::make_circuit_executor(const Method method) const {
   }
 }
 
+bool Controller::use_real_amplitudes(const Config &config,
+                                     const Circuit &circ,
+                                     const Noise::NoiseModel &noise,
+                                     const Method method) const {
+  return config.statevector_real_amplitudes &&
+         method == Method::statevector && sim_device_ == Device::CPU &&
+         noise.is_ideal() && Statevector::is_real_circuit(circ);
+}
+
+std::shared_ptr<CircuitExecutor::Base>
+Controller::make_real_circuit_executor() const {
+  if (sim_precision_ == Precision::Double) {
+    return std::make_shared<Statevector::RealExecutor<
+        Statevector::RealState<QV::RealQubitVector<double>>>>();
+  } else {
+    return std::make_shared<Statevector::RealExecutor<
+        Statevector::RealState<QV::RealQubitVector<float>>>>();
+  }
+} //SW
+
 std::vector<Method>
 Controller::simulation_methods(const Config &config,
                                std::vector<std::shared_ptr<Circuit>> &circuits,
@@ -22,6 +22,7 @@
 #include "framework/matrix.hpp"
 #include "framework/python_parser.hpp"
 #include "framework/results/result.hpp"
+#include "framework/trace.hpp"
 
 //=========================================================================
 // Controller Execute interface
@@ -48,6 +49,9 @@ Result controller_execute(std::vector<std::shared_ptr<Circuit>> &input_circs,
   // printf("I'm in controller_execute()\n");
   controller_t controller;
 
+  //SW
+  apply_simulation_strategy(config);
+
   bool truncate = config.enable_truncation;
 
   if (noise_model.has_nonlocal_quantum_errors())
@@ -83,6 +87,7 @@ Result controller_execute(std::vector<std::shared_ptr<Circuit>> &input_circs,
 
   using myclock_t = std::chrono::high_resolution_clock;
   auto timer_start = myclock_t::now();
+  Tracing::Span binding_span("controller", "parameter_binding"); //SW
   try {
     // Load circuits
     for (size_t i = 0; i < num_circs; i++) {
@@ -226,9 +231,12 @@ Result controller_execute(std::vector<std::shared_ptr<Circuit>> &input_circs,
   }
   auto time_taken =
       std::chrono::duration<double>(myclock_t::now() - timer_start).count();
+  binding_span.end();
 
   controller.set_config(config);
+  Tracing::Span execute_span("controller", "execute"); //SW
   auto ret = controller.execute(circs, noise_model, config);
+  execute_span.end();
 
   for (size_t i = 0; i < ret.results.size(); ++i)
     ret.results[i].circ_id = template_circs[i]->circ_id;
@@ -0,0 +1,470 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_session_hpp_
+#define _aer_session_hpp_
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "framework/circuit.hpp"
+#include "framework/config.hpp"
+#include "framework/results/experiment_result.hpp"
+#include "framework/rng.hpp"
+#include "framework/types.hpp"
+#include "noise/noise_model.hpp"
+#include "transpile/mosq_block.hpp"
+#include "transpile/mosq_rewrite.hpp"
+
+#include "simulators/statevector/prefix_cache.hpp"
+#include "simulators/statevector/qubitvector.hpp"
+#include "simulators/statevector/real_qubitvector.hpp"
+#include "simulators/statevector/real_statevector_executor.hpp"
+#include "simulators/statevector/real_statevector_state.hpp"
+#include "simulators/statevector/statevector_state.hpp"
+
+namespace AER {
+
+//SW
+//=========================================================================
+// AerSession
+//=========================================================================
+// A parameterized circuit prepared once and evaluated for many parameter
+// values, as an optimizer does with a variational ansatz. The circuit is
+// loaded, transpiled and its simulator state allocated once; an evaluation
+// only writes the parameter values into the instructions, resets the
+// statevector buffer to |0...0> and runs the circuit. It returns the
+// expectation values of the save_expval and save_hamiltonian_expval
+// instructions of the circuit in order. The gradient of the energy of the
+// first save_hamiltonian_expval instruction with respect to the values is
+// computed with the adjoint method, for values that are angles of Pauli
+// rotations (see statevector/adjoint_gradient.hpp).
+//
+// Sessions run ideal circuits with the statevector method on the CPU, with
+// real amplitudes when every instruction is real for all parameter values.
+
+namespace SessionExecutor {
+
+//-------------------------------------------------------------------------
+// Executor interface
+//-------------------------------------------------------------------------
+class Base {
+public:
+  virtual ~Base() = default;
+
+  // Set the parameter values and return the expectation values
+  virtual std::vector<double> evaluate(const double *values,
+                                       const uint_t size) = 0;
+
+  // Set the parameter values and return the energy gradient, the energy is
+  // returned in energy
+  virtual std::vector<double> gradient(const double *values, const uint_t size,
+                                       double &energy) = 0;
+};
+
+//-------------------------------------------------------------------------
+// Executor for a state type
+//-------------------------------------------------------------------------
+template <class state_t>
+class Executor : public Base {
+public:
+  using pos_t = std::pair<uint_t, uint_t>;
+
+  // The circuit parameters at positions are tagged with their value index
+  Executor(Circuit &&circ, const Config &config, const uint_t num_values,
+           const int_t phase_index);
+
+  std::vector<double> evaluate(const double *values,
+                               const uint_t size) override;
+
+  std::vector<double> gradient(const double *values, const uint_t size,
+                               double &energy) override;
+
+protected:
+  // Set the parameter values and reset the state, return the global phase
+  double set_values(const double *values, const uint_t size);
+
+  // Apply the ops [circ_.ops.begin(), last), using the prefix cache
+  void apply_prefix(std::vector<Operations::Op>::const_iterator last,
+                    ExperimentResult &result, const double global_phase);
+
+  Circuit circ_;
+  state_t state_;
+  RngEngine rng_;
+
+  // Instruction and parameter index of each value, the global phase has the
+  // index phase_index_
+  std::vector<pos_t> positions_;
+  int_t phase_index_;
+
+  // Positions of the expectation value instructions
+  reg_t expval_ops_;
+
+  // Position of the instruction differentiated by gradient and, for each
+  // value, the index of its rotation in the gradient of the engine. A value
+  // with index -1 does not change the energy and one with -2 is not a
+  // rotation angle.
+  uint_t gradient_op_;
+  std::vector<int_t> rotation_index_;
+
+  uint_t prefix_cache_max_memory_mb_ = 0;
+};
+
+template <class state_t>
+Executor<state_t>::Executor(Circuit &&circ, const Config &config,
+                            const uint_t num_values, const int_t phase_index)
+    : circ_(std::move(circ)), phase_index_(phase_index) {
+  if (config.seed_simulator.has_value())
+    rng_.set_seed(config.seed_simulator.value());
+  else
+    rng_.set_seed(circ_.seed);
+  prefix_cache_max_memory_mb_ = config.prefix_cache_max_memory_mb;
+
+  int threads = 1;
+#ifdef _OPENMP
+  const int omp_threads = omp_get_max_threads();
+  threads = (config.max_parallel_threads.has_value() &&
+             config.max_parallel_threads.value() > 0)
+                ? std::min((int)config.max_parallel_threads.value(),
+                           omp_threads)
+                : std::max(1, omp_threads);
+#endif
+
+  state_.set_config(config);
+  state_.set_parallelization(threads);
+  state_.set_distribution(1);
+  state_.allocate(circ_.num_qubits, circ_.num_qubits);
+  state_.set_num_global_qubits(circ_.num_qubits);
+
+  // Transpile once, the tagged parameters are copied into the new ops
+  Noise::NoiseModel dummy_noise;
+  ExperimentResult dummy_result;
+  Config pass_config = config;
+  apply_simulation_strategy(pass_config);
+  Transpile::MOSQRewriting mosq_rewrite_pass;
+  mosq_rewrite_pass.set_config(pass_config);
+  mosq_rewrite_pass.optimize_circuit(circ_, dummy_noise, state_.opset(),
+                                     dummy_result);
+  Transpile::MOSQBlocking mosq_block_pass;
+  mosq_block_pass.set_config(config);
+  mosq_block_pass.optimize_circuit(circ_, dummy_noise, state_.opset(),
+                                   dummy_result);
+  if (!state_.opset().contains(circ_.opset())) {
+    std::stringstream msg;
+    msg << "AerSession: circuit contains instructions not supported by the "
+           "statevector method: "
+        << state_.opset().difference(circ_.opset());
+    throw std::invalid_argument(msg.str());
+  }
+
+  // Locate the tagged parameters
+  positions_.assign(num_values, pos_t(circ_.ops.size(), 0));
+  for (uint_t i = 0; i < circ_.ops.size(); ++i) {
+    auto &op = circ_.ops[i];
+    for (uint_t j = 0; j < op.params.size(); ++j) {
+      if (std::isnan(std::real(op.params[j]))) {
+        positions_[(uint_t)std::imag(op.params[j])] = pos_t(i, j);
+        op.params[j] = 0.;
+      }
+    }
+    if (op.type == Operations::OpType::save_expval ||
+        op.type == Operations::OpType::save_expval_var ||
+        op.type == Operations::OpType::save_hamiltonian_expval)
+      expval_ops_.push_back(i);
+  }
+  for (int_t k = 0; k < (int_t)num_values; ++k) {
+    if (k != phase_index_ && positions_[k].first == circ_.ops.size())
+      throw std::runtime_error(
+          "AerSession: a circuit parameter was removed by transpilation.");
+  }
+  if (expval_ops_.empty())
+    throw std::invalid_argument(
+        "AerSession: circuit has no expectation value instruction.");
+
+  // Rotations of the ops before the first Pauli sum energy
+  gradient_op_ = circ_.ops.size();
+  for (const auto pos : expval_ops_) {
+    if (circ_.ops[pos].type == Operations::OpType::save_hamiltonian_expval) {
+      gradient_op_ = pos;
+      break;
+    }
+  }
+  reg_t offsets(circ_.ops.size() + 1, 0);
+  for (uint_t i = 0; i < circ_.ops.size(); ++i)
+    offsets[i + 1] =
+        offsets[i] + Statevector::num_pauli_rotations(circ_.ops[i]);
+  rotation_index_.assign(num_values, -1);
+  for (int_t k = 0; k < (int_t)num_values; ++k) {
+    if (k == phase_index_ || positions_[k].first >= gradient_op_)
+      continue;
+    const auto &op = circ_.ops[positions_[k].first];
+    const uint_t j = positions_[k].second;
+    if (j < Statevector::num_pauli_rotations(op))
+      rotation_index_[k] = offsets[positions_[k].first] + j;
+    else
+      rotation_index_[k] = -2;
+  }
+}
+
+template <class state_t>
+double Executor<state_t>::set_values(const double *values, const uint_t size) {
+  if (size != positions_.size()) {
+    throw std::invalid_argument(
+        "AerSession: expected " + std::to_string(positions_.size()) +
+        " parameter values but got " + std::to_string(size) + ".");
+  }
+  double global_phase = circ_.global_phase_angle;
+  for (uint_t k = 0; k < size; ++k) {
+    if ((int_t)k == phase_index_)
+      global_phase = values[k];
+    else
+      circ_.ops[positions_[k].first].params[positions_[k].second] = values[k];
+  }
+
+  // The statevector buffer is kept, initialize_qreg only clears it
+  state_.set_global_phase(global_phase);
+  state_.initialize_qreg(circ_.num_qubits);
+  state_.initialize_creg(circ_.num_memory, circ_.num_registers);
+  return global_phase;
+}
+
+template <class state_t>
+void Executor<state_t>::apply_prefix(
+    std::vector<Operations::Op>::const_iterator last, ExperimentResult &result,
+    const double global_phase) {
+  if (prefix_cache_max_memory_mb_ > 0)
+    Statevector::apply_ops_with_prefix_cache(
+        state_, circ_.ops.cbegin(), last, global_phase, result, rng_, false,
+        prefix_cache_max_memory_mb_);
+  else
+    state_.apply_ops(circ_.ops.cbegin(), last, result, rng_, false);
+}
+
+template <class state_t>
+std::vector<double> Executor<state_t>::evaluate(const double *values,
+                                                const uint_t size) {
+  const double global_phase = set_values(values, size);
+  ExperimentResult result;
+
+  std::vector<double> expvals;
+  expvals.reserve(expval_ops_.size());
+  auto first = circ_.ops.cbegin();
+  for (const auto pos : expval_ops_) {
+    auto last = circ_.ops.cbegin() + pos;
+    if (first == circ_.ops.cbegin())
+      apply_prefix(last, result, global_phase);
+    else
+      state_.apply_ops(first, last, result, rng_, false);
+
+    const auto &op = *last;
+    if (op.type == Operations::OpType::save_hamiltonian_expval) {
+      std::vector<double> vals;
+      expvals.push_back(state_.expval_hamiltonian(op, vals));
+    } else {
+      std::vector<std::string> paulis;
+      paulis.reserve(op.expval_params.size());
+      for (const auto &param : op.expval_params)
+        paulis.push_back(std::get<0>(param));
+      const auto vals = state_.expval_paulis(op.qubits, paulis);
+      double expval = 0.;
+      for (uint_t i = 0; i < vals.size(); ++i)
+        expval += std::get<1>(op.expval_params[i]) * vals[i];
+      expvals.push_back(expval);
+    }
+    first = last + 1;
+  }
+  return expvals;
+}
+
+template <class state_t>
+std::vector<double> Executor<state_t>::gradient(const double *values,
+                                                const uint_t size,
+                                                double &energy) {
+  if (gradient_op_ == circ_.ops.size())
+    throw std::invalid_argument("AerSession: gradient requires a "
+                                "save_hamiltonian_expval instruction.");
+  for (const auto index : rotation_index_) {
+    if (index == -2)
+      throw std::invalid_argument(
+          "AerSession: gradient requires the parameters before the energy "
+          "to be angles of Pauli rotations.");
+  }
+  const double global_phase = set_values(values, size);
+
+  // The state is not needed after the gradient, which reverses it in place
+  ExperimentResult result;
+  const auto last = circ_.ops.cbegin() + gradient_op_;
+  apply_prefix(last, result, global_phase);
+  const auto rotation_grad =
+      state_.energy_gradient(circ_.ops.cbegin(), last, *last, energy, true);
+
+  std::vector<double> grad(size, 0.);
+  for (uint_t k = 0; k < size; ++k) {
+    if (rotation_index_[k] >= 0)
+      grad[k] = rotation_grad[rotation_index_[k]];
+  }
+  return grad;
+}
+
+} // namespace SessionExecutor
+
+//-------------------------------------------------------------------------
+// AerSession
+//-------------------------------------------------------------------------
+class AerSession {
+public:
+  using pos_t = std::pair<int_t, int_t>;
+
+  AerSession() = default;
+  virtual ~AerSession() = default;
+
+  // Prepare a circuit whose instruction parameters at positions are set by
+  // evaluate. A position (instruction, parameter) of
+  // (Config::GLOBAL_PHASE_POS, -1) sets the global phase.
+  void initialize(const Circuit &circ, const Noise::NoiseModel &noise,
+                  const Config &config, const std::vector<pos_t> &positions);
+
+  bool is_initialized() const { return executor_ != nullptr; }
+
+  uint_t num_values() const { return num_values_; }
+
+  bool real_amplitudes() const { return real_amplitudes_; }
+
+  // Return the expectation values of the circuit for the parameter values
+  std::vector<double> evaluate(const double *values, const uint_t size);
+  std::vector<double> evaluate(const std::vector<double> &values) {
+    return evaluate(values.data(), values.size());
+  }
+
+  // Return the gradient of the energy of the first save_hamiltonian_expval
+  // instruction for the parameter values, and the energy in energy
+  std::vector<double> gradient(const double *values, const uint_t size,
+                               double &energy);
+
+protected:
+  std::unique_ptr<SessionExecutor::Base> executor_;
+  uint_t num_values_ = 0;
+  bool real_amplitudes_ = false;
+};
+
+void AerSession::initialize(const Circuit &circ, const Noise::NoiseModel &noise,
+                            const Config &config,
+                            const std::vector<pos_t> &positions) {
+  if (config.method != "automatic" && config.method != "statevector") {
+    throw std::invalid_argument(
+        "AerSession: only the statevector method is supported.");
+  }
+  if (config.device != "CPU") {
+    throw std::invalid_argument("AerSession: only the CPU is supported.");
+  }
+  if (!noise.is_ideal()) {
+    throw std::invalid_argument("AerSession: noise is not supported.");
+  }
+
+  // Positions index the instructions of the circuit before truncation
+  Circuit session_circ = circ;
+  session_circ.set_params(false);
+  session_circ.set_metadata(config, config.enable_truncation);
+
+  // Tag each parameter with the index of its value. The tags survive the
+  // truncation and transpilation, which copy parameters into the new
+  // instructions.
+  int_t phase_index = -1;
+  for (uint_t k = 0; k < positions.size(); ++k) {
+    const auto instr_pos = positions[k].first;
+    const auto param_pos = positions[k].second;
+    if (instr_pos == Config::GLOBAL_PHASE_POS) {
+      phase_index = k;
+      continue;
+    }
+    if (instr_pos < 0 || (uint_t)instr_pos >= session_circ.ops.size() ||
+        param_pos < 0 ||
+        (uint_t)param_pos >= session_circ.ops[instr_pos].params.size()) {
+      throw std::invalid_argument(
+          "AerSession: parameter position out of range.");
+    }
+    session_circ.ops[instr_pos].params[param_pos] =
+        complex_t(std::numeric_limits<double>::quiet_NaN(), (double)k);
+  }
+  if (config.enable_truncation) {
+    session_circ.set_params(true);
+    session_circ.set_metadata(config, true);
+  }
+
+  // Real amplitudes are used if the circuit is real for generic values of
+  // the parameters, for which standard gates are either always or not real
+  bool real = config.statevector_real_amplitudes;
+  for (const double probe : {0.3, 1.1}) {
+    if (!real)
+      break;
+    Circuit probe_circ = session_circ;
+    for (auto &op : probe_circ.ops)
+      for (auto &param : op.params)
+        if (std::isnan(std::real(param)))
+          param = probe;
+    real = Statevector::is_real_circuit(probe_circ);
+  }
+
+  const bool single = (config.precision == "single");
+  executor_.reset();
+  num_values_ = positions.size();
+  real_amplitudes_ = real;
+  if (real && single)
+    executor_ = std::make_unique<SessionExecutor::Executor<
+        Statevector::RealState<QV::RealQubitVector<float>>>>(
+        std::move(session_circ), config, num_values_, phase_index);
+  else if (real)
+    executor_ = std::make_unique<SessionExecutor::Executor<
+        Statevector::RealState<QV::RealQubitVector<double>>>>(
+        std::move(session_circ), config, num_values_, phase_index);
+  else if (single)
+    executor_ = std::make_unique<SessionExecutor::Executor<
+        Statevector::State<QV::QubitVector<float>>>>(
+        std::move(session_circ), config, num_values_, phase_index);
+  else
+    executor_ = std::make_unique<SessionExecutor::Executor<
+        Statevector::State<QV::QubitVector<double>>>>(
+        std::move(session_circ), config, num_values_, phase_index);
+}
+
+std::vector<double> AerSession::evaluate(const double *values,
+                                         const uint_t size) {
+  if (!executor_)
+    throw std::runtime_error("AerSession: session is not initialized.");
+  return executor_->evaluate(values, size);
+}
+
+std::vector<double> AerSession::gradient(const double *values,
+                                         const uint_t size, double &energy) {
+  if (!executor_)
+    throw std::runtime_error("AerSession: session is not initialized.");
+  if (real_amplitudes_)
+    throw std::invalid_argument("AerSession: gradient is not supported with "
+                                "real amplitudes.");
+  return executor_->gradient(values, size, energy);
+}
+
+//-------------------------------------------------------------------------
+} // end namespace AER
+//-------------------------------------------------------------------------
+#endif
@@ -20,6 +20,7 @@
 #include "framework/config.hpp"
 #include "framework/operations.hpp"
 #include "framework/opset.hpp"
+#include "framework/qubit_hamiltonian.hpp"
 
 using complex_t = std::complex<double>;
 
@@ -144,6 +145,15 @@ public:
     check_gate_params(ops.back());
   }
 
+  void mosq_cr(const reg_t &qubits, const complex_t theta, const uint_t x_mask,
+               const uint_t y_mask, const uint_t z_mask,
+               const int_t cond_regidx = -1,
+               const std::shared_ptr<Operations::CExpr> expr = nullptr,
+               const std::string label = "") {
+    ops.push_back(Operations::make_MOSQ_CR(qubits, theta, x_mask, y_mask,
+                                           z_mask, cond_regidx, expr, label));
+  } //SW
+
   void diagonal(const reg_t &qubits, const cvector_t &vec,
                 const int_t cond_regidx = -1, const std::string label = "") {
     ops.push_back(Operations::make_diagonal(qubits, vec, cond_regidx, label));
@@ -213,6 +223,55 @@ public:
                                                snapshot_type, label));
   }
 
+  void save_hamiltonian_expval(const reg_t &qubits, const std::string &name,
+                               const std::vector<uint_t> &x_masks,
+                               const std::vector<uint_t> &z_masks,
+                               const std::vector<double> &coeffs,
+                               const std::string &snapshot_type,
+                               const std::string label = "",
+                               const std::string per_term_label = "") {
+    ops.push_back(Operations::make_save_hamiltonian_expval(
+        qubits, name, x_masks, z_masks, coeffs, snapshot_type, label,
+        per_term_label));
+  } //SW
+
+  // save_hamiltonian_expval or save_energy_gradient (name) of the Pauli sum
+  // stored in a QubitHamiltonian file
+  void save_hamiltonian_expval_file(const reg_t &qubits,
+                                    const std::string &name,
+                                    const std::string &path,
+                                    const std::string &snapshot_type,
+                                    const std::string label = "",
+                                    const std::string per_term_label = "") {
+    QubitHamiltonian hamiltonian(path);
+    if (hamiltonian.num_qubits() != qubits.size()) {
+      throw std::invalid_argument(
+          "Invalid save Hamiltonian expval instruction (Hamiltonian file \"" +
+          path + "\" does not match qubit number).");
+    }
+    const uint_t num_terms = hamiltonian.num_terms();
+    const std::vector<uint_t> x_masks(hamiltonian.x_masks(),
+                                      hamiltonian.x_masks() + num_terms);
+    const std::vector<uint_t> z_masks(hamiltonian.z_masks(),
+                                      hamiltonian.z_masks() + num_terms);
+    const std::vector<double> coeffs(hamiltonian.coeffs(),
+                                     hamiltonian.coeffs() + num_terms);
+    ops.push_back(Operations::make_save_hamiltonian_expval(
+        qubits, name, x_masks, z_masks, coeffs, snapshot_type, label,
+        per_term_label));
+  } //SW
+
+  void save_energy_gradient(const reg_t &qubits,
+                            const std::vector<uint_t> &x_masks,
+                            const std::vector<uint_t> &z_masks,
+                            const std::vector<double> &coeffs,
+                            const std::string &snapshot_type,
+                            const std::string label,
+                            const std::string energy_label = "") {
+    ops.push_back(Operations::make_save_energy_gradient(
+        qubits, x_masks, z_masks, coeffs, snapshot_type, label, energy_label));
+  } //SW
+
   void set_qerror_loc(const reg_t &qubits, const std::string &label,
                       const int_t conditional = -1,
                       const std::shared_ptr<Operations::CExpr> expr = nullptr) {
@@ -531,6 +590,8 @@ void Circuit::set_params(bool truncation) {
       case OpType::save_state:
       case OpType::save_expval:
       case OpType::save_expval_var:
+      case OpType::save_hamiltonian_expval:
+      case OpType::save_energy_gradient:
       case OpType::save_statevec:
       case OpType::save_statevec_dict:
       case OpType::save_densmat:
@@ -667,6 +728,8 @@ bool Circuit::check_result_ancestor(
   case OpType::save_state:
   case OpType::save_expval:
   case OpType::save_expval_var:
+  case OpType::save_hamiltonian_expval:
+  case OpType::save_energy_gradient:
   case OpType::save_statevec:
   case OpType::save_statevec_dict:
   case OpType::save_densmat:
@@ -154,6 +154,8 @@ struct Config {
   optional<uint_t> _fusion_enable_n_qubits_5;
   optional<bool> _fusion_enable_diagonal;
   optional<uint_t> _fusion_min_qubit;
+  optional<bool> _fusion_enable_mosq;
+  optional<double> _fusion_mosq_cost;
   optional<double> fusion_cost_factor;
   optional<bool> _fusion_enable_cost_based;
   optional<uint_t> _fusion_cost_1;
@@ -173,6 +175,16 @@ struct Config {
   optional<uint_t> extended_stabilizer_norm_estimation_default_samples;
   optional<reg_t> target_gpus;
   optional<bool> runtime_parameter_bind_enable;
+  // # MOSQ options
+  std::string simulation_strategy = "default";
+  std::string trace_file = "";
+  bool mosq_rewrite_enable = false;
+  bool mosq_block_enable = false;
+  optional<uint_t> mosq_block_max_qubit;
+  bool subspace_spin_sectors = true;
+  bool statevector_real_amplitudes = true;
+  uint_t prefix_cache_max_memory_mb = 0;
+  bool statevector_persistent_parallel = false;
 
   void clear() {
     shots = 1024;
@@ -256,6 +268,8 @@ struct Config {
     _fusion_enable_n_qubits_4.clear();
     _fusion_enable_n_qubits_5.clear();
     _fusion_min_qubit.clear();
+    _fusion_enable_mosq.clear();
+    _fusion_mosq_cost.clear();
     fusion_cost_factor.clear();
     _fusion_enable_cost_based.clear();
     _fusion_cost_1.clear();
@@ -276,6 +290,15 @@ struct Config {
 
     target_gpus.clear();
     runtime_parameter_bind_enable.clear();
+    simulation_strategy = "default";
+    trace_file = "";
+    mosq_rewrite_enable = false;
+    mosq_block_enable = false;
+    mosq_block_max_qubit.clear();
+    subspace_spin_sectors = true;
+    statevector_real_amplitudes = true;
+    prefix_cache_max_memory_mb = 0;
+    statevector_persistent_parallel = false;
   }
 
   void merge(const Config &other) {
@@ -404,6 +427,10 @@ struct Config {
       _fusion_enable_diagonal.value(other._fusion_enable_diagonal.value());
     if (other._fusion_min_qubit.has_value())
       _fusion_min_qubit.value(other._fusion_min_qubit.value());
+    if (other._fusion_enable_mosq.has_value())
+      _fusion_enable_mosq.value(other._fusion_enable_mosq.value());
+    if (other._fusion_mosq_cost.has_value())
+      _fusion_mosq_cost.value(other._fusion_mosq_cost.value());
     if (other.fusion_cost_factor.has_value())
       fusion_cost_factor.value(other.fusion_cost_factor.value());
 
@@ -424,6 +451,16 @@ struct Config {
     if (other.runtime_parameter_bind_enable.has_value())
       runtime_parameter_bind_enable.value(
           other.runtime_parameter_bind_enable.value());
+    simulation_strategy = other.simulation_strategy;
+    trace_file = other.trace_file;
+    mosq_rewrite_enable = other.mosq_rewrite_enable;
+    mosq_block_enable = other.mosq_block_enable;
+    if (other.mosq_block_max_qubit.has_value())
+      mosq_block_max_qubit.value(other.mosq_block_max_qubit.value());
+    subspace_spin_sectors = other.subspace_spin_sectors;
+    statevector_real_amplitudes = other.statevector_real_amplitudes;
+    prefix_cache_max_memory_mb = other.prefix_cache_max_memory_mb;
+    statevector_persistent_parallel = other.statevector_persistent_parallel;
   }
 };
 
@@ -530,6 +567,8 @@ inline void from_json(const json_t &js, Config &config) {
   get_value(config._fusion_enable_n_qubits_5, "_fusion_enable_n_qubits_5", js);
   get_value(config._fusion_enable_diagonal, "_fusion_enable_diagonal", js);
   get_value(config._fusion_min_qubit, "_fusion_min_qubit", js);
+  get_value(config._fusion_enable_mosq, "_fusion_enable_mosq", js);
+  get_value(config._fusion_mosq_cost, "_fusion_mosq_cost", js);
   get_value(config.fusion_cost_factor, "fusion_cost_factor", js);
 
   get_value(config.superoperator_parallel_threshold,
@@ -542,6 +581,49 @@ inline void from_json(const json_t &js, Config &config) {
   get_value(config.target_gpus, "target_gpus", js);
   get_value(config.runtime_parameter_bind_enable,
             "runtime_parameter_bind_enable", js);
+  get_value(config.simulation_strategy, "simulation_strategy", js);
+  get_value(config.trace_file, "trace_file", js);
+  get_value(config.mosq_rewrite_enable, "mosq_rewrite_enable", js);
+  get_value(config.mosq_block_enable, "mosq_block_enable", js);
+  get_value(config.mosq_block_max_qubit, "mosq_block_max_qubit", js);
+  get_value(config.subspace_spin_sectors, "subspace_spin_sectors", js);
+  get_value(config.statevector_real_amplitudes, "statevector_real_amplitudes",
+            js);
+  get_value(config.prefix_cache_max_memory_mb, "prefix_cache_max_memory_mb",
+            js);
+  get_value(config.statevector_persistent_parallel,
+            "statevector_persistent_parallel", js);
+}
+
+//SW
+// Set the passes of a simulation strategy
+// - "default": the fusion_enable and mosq_rewrite_enable options as given
+// - "gates": the circuit gates without fusion
+// - "fusion": cost-based gate fusion
+// - "mosq": Pauli rotations rewritten into MOSQ_CR, without fusion
+// - "mosq_fusion": MOSQ_CR rotations followed by gate fusion
+// - "auto": selected by timing each strategy in the estimators, the
+//   default passes otherwise
+inline void apply_simulation_strategy(Config &config) {
+  const auto &strategy = config.simulation_strategy;
+  if (strategy == "default" || strategy == "auto")
+    return;
+  if (strategy == "gates") {
+    config.fusion_enable = false;
+    config.mosq_rewrite_enable = false;
+  } else if (strategy == "fusion") {
+    config.fusion_enable = true;
+    config.mosq_rewrite_enable = false;
+  } else if (strategy == "mosq") {
+    config.fusion_enable = false;
+    config.mosq_rewrite_enable = true;
+  } else if (strategy == "mosq_fusion") {
+    config.fusion_enable = true;
+    config.mosq_rewrite_enable = true;
+  } else {
+    throw std::invalid_argument("Invalid simulation strategy \"" + strategy +
+                                "\".");
+  }
 }
 
 } // namespace AER
@@ -0,0 +1,298 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_framework_jordan_wigner_hpp_
+#define _aer_framework_jordan_wigner_hpp_
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "framework/types.hpp"
+#include "framework/utils.hpp"
+
+namespace AER {
+
+//SW
+//============================================================================
+// Jordan-Wigner mapping
+//============================================================================
+
+// A second-quantized operator as a sum of products of ladder operators,
+// written with the labels of qiskit-nature's FermionicOp: "+_i" creates and
+// "-_i" annihilates a fermion in spin orbital i, and the operators of a term
+// are applied right to left.
+struct FermionicOperator {
+  uint_t num_spin_orbitals = 0;
+  // The ladder operators of term k are ops[offsets[k]] ... ops[offsets[k+1]]
+  // encoded as 2 * index + creation
+  std::vector<uint_t> offsets = {0};
+  std::vector<uint_t> ops;
+  std::vector<complex_t> coeffs;
+
+  uint_t num_terms() const { return coeffs.size(); }
+
+  // Append a term given by its label
+  void add_term(const std::string &label, const complex_t coeff);
+};
+
+// A Pauli sum as a table of (x_mask, z_mask, coeff) terms, where bit j of a
+// mask refers to qubit j and a bit set in both masks is a Y
+struct PauliTable {
+  uint_t num_qubits = 0;
+  std::vector<uint_t> x_masks;
+  std::vector<uint_t> z_masks;
+  std::vector<double> coeffs;
+};
+
+// Read the text format of the MOSQ molecule cache: two header lines, the
+// second one "number spin orbitals=N, number terms=M", followed by one
+// "coeff * ( label )" line per term, each but the first prefixed by "+ "
+FermionicOperator load_fermionic_op(const std::string &path);
+
+// Map a Hermitian fermionic operator to qubits by the Jordan-Wigner
+// transformation
+//   a_j^dagger = Z_0 ... Z_{j-1} (X_j - i Y_j) / 2,
+// which is the mapping of qiskit-nature's JordanWignerMapper. The terms are
+// expanded in parallel and equal Pauli strings are summed in hash tables
+// sharded by Pauli, so no Pauli string is ever built. Terms whose summed
+// coefficient has an absolute value of at most atol are dropped, and the
+// remaining terms are sorted by their masks.
+PauliTable jordan_wigner(const FermionicOperator &op, const double atol = 1e-8,
+                         int num_threads = 0);
+
+/*******************************************************************************
+ *
+ * Implementation
+ *
+ ******************************************************************************/
+
+void FermionicOperator::add_term(const std::string &label,
+                                 const complex_t coeff) {
+  std::istringstream tokens(label);
+  std::string token;
+  while (tokens >> token) {
+    if (token.size() < 3 || (token[0] != '+' && token[0] != '-') ||
+        token[1] != '_') {
+      throw std::invalid_argument("FermionicOperator: invalid ladder operator "
+                                  "\"" +
+                                  token + "\" in label \"" + label + "\".");
+    }
+    const uint_t index = std::stoull(token.substr(2));
+    num_spin_orbitals = std::max(num_spin_orbitals, index + 1);
+    ops.push_back(2 * index + (token[0] == '+' ? 1 : 0));
+  }
+  offsets.push_back(ops.size());
+  coeffs.push_back(coeff);
+}
+
+FermionicOperator load_fermionic_op(const std::string &path) {
+  std::ifstream file(path);
+  if (!file)
+    throw std::invalid_argument("load_fermionic_op: can not open file (\"" +
+                                path + "\").");
+  FermionicOperator op;
+  std::string line;
+  for (uint_t n = 0; std::getline(file, line); ++n) {
+    if (n < 2) {
+      // The header declares the register length, which may exceed the
+      // largest index used by the terms
+      const auto pos = line.find("number spin orbitals=");
+      if (pos != std::string::npos)
+        op.num_spin_orbitals = std::stoull(line.substr(pos + 21));
+      continue;
+    }
+    const auto mult = line.find(" * ");
+    const auto open = line.find('(', mult);
+    const auto close = line.rfind(')');
+    if (mult == std::string::npos || open == std::string::npos ||
+        close == std::string::npos || close < open) {
+      if (line.find_first_not_of(" \t\r") == std::string::npos)
+        continue;
+      throw std::invalid_argument("load_fermionic_op: invalid line " +
+                                  std::to_string(n + 1) + " (\"" + path +
+                                  "\").");
+    }
+    // Skip the "+ " separating the terms
+    auto start = line.find_first_not_of(' ');
+    if (line[start] == '+' && start + 1 < line.size() && line[start + 1] == ' ')
+      start += 2;
+    op.add_term(line.substr(open + 1, close - open - 1),
+                std::stod(line.substr(start, mult - start)));
+  }
+  return op;
+}
+
+namespace JordanWigner {
+
+// Paulis are kept as X^x Z^z products during the expansion, so the product
+//   X^x1 Z^z1 X^x2 Z^z2 = (-1)^|z1 & x2| X^(x1 ^ x2) Z^(z1 ^ z2)
+// only changes the sign of a coefficient
+struct PauliKey {
+  uint_t x;
+  uint_t z;
+  bool operator==(const PauliKey &other) const {
+    return x == other.x && z == other.z;
+  }
+  bool operator<(const PauliKey &other) const {
+    return (x != other.x) ? (x < other.x) : (z < other.z);
+  }
+};
+
+struct PauliKeyHash {
+  size_t operator()(const PauliKey &key) const {
+    uint_t h = key.x * 0x9E3779B97F4A7C15ULL;
+    h ^= key.z + 0x632BE59BD9B4E019ULL + (h << 6) + (h >> 2);
+    return static_cast<size_t>(h ^ (h >> 29));
+  }
+};
+
+using PauliMap = std::unordered_map<PauliKey, complex_t, PauliKeyHash>;
+
+struct Term {
+  PauliKey pauli;
+  complex_t coeff;
+};
+
+// Expand term k of op into X^x Z^z products
+inline void expand(const FermionicOperator &op, const uint_t k,
+                   std::vector<Term> &terms, std::vector<Term> &buffer) {
+  terms.assign(1, {{0, 0}, op.coeffs[k]});
+  for (uint_t i = op.offsets[k]; i < op.offsets[k + 1]; ++i) {
+    // a_j^dagger = X_j Z_<j (1 + Z_j) / 2 and a_j = X_j Z_<j (1 - Z_j) / 2
+    const uint_t j = op.ops[i] >> 1;
+    const double sign = (op.ops[i] & 1) ? 0.5 : -0.5;
+    const uint_t x = 1ULL << j;
+    const uint_t z = x - 1;
+    buffer.clear();
+    for (const auto &term : terms) {
+      const double phase =
+          (Utils::popcount(term.pauli.z & x) & 1) ? -1. : 1.;
+      buffer.push_back({{term.pauli.x ^ x, term.pauli.z ^ z},
+                        0.5 * phase * term.coeff});
+      buffer.push_back({{term.pauli.x ^ x, term.pauli.z ^ z ^ x},
+                        sign * phase * term.coeff});
+    }
+    std::swap(terms, buffer);
+  }
+}
+
+} // namespace JordanWigner
+
+PauliTable jordan_wigner(const FermionicOperator &op, const double atol,
+                         int num_threads) {
+  using namespace JordanWigner;
+  if (op.num_spin_orbitals > 64) {
+    throw std::invalid_argument(
+        "jordan_wigner: more than 64 spin orbitals are not supported.");
+  }
+#ifdef _OPENMP
+  if (num_threads <= 0)
+    num_threads = omp_get_max_threads();
+#endif
+  // Small operators are not worth the threads
+  if (num_threads <= 0 || op.num_terms() < 1024)
+    num_threads = 1;
+  const uint_t num_shards = num_threads;
+
+  // Each thread sums the Paulis of its terms into its own shards, then
+  // shard s of all threads is merged by one thread
+  std::vector<std::vector<PauliMap>> local(num_threads,
+                                           std::vector<PauliMap>(num_shards));
+  std::vector<PauliMap> shards(num_shards);
+  const int_t num_terms = op.num_terms();
+#pragma omp parallel num_threads(num_threads) if (num_threads > 1)
+  {
+    int tid = 0;
+#ifdef _OPENMP
+    tid = omp_get_thread_num();
+#endif
+    std::vector<Term> terms, buffer;
+    PauliKeyHash hash;
+#pragma omp for schedule(dynamic, 256)
+    for (int_t k = 0; k < num_terms; ++k) {
+      expand(op, k, terms, buffer);
+      for (const auto &term : terms)
+        local[tid][hash(term.pauli) % num_shards][term.pauli] += term.coeff;
+    }
+
+#pragma omp for schedule(static, 1)
+    for (int_t s = 0; s < (int_t)num_shards; ++s) {
+      for (int_t t = 0; t < num_threads; ++t) {
+        for (const auto &term : local[t][s])
+          shards[s][term.first] += term.second;
+        PauliMap().swap(local[t][s]);
+      }
+    }
+  }
+
+  // X^x Z^z = (-i)^|x & z| P with P the Pauli string with Y where both
+  // masks are set
+  std::vector<std::pair<PauliKey, double>> paulis;
+  for (const auto &shard : shards) {
+    for (const auto &term : shard) {
+      complex_t coeff = term.second;
+      switch (Utils::popcount(term.first.x & term.first.z) & 3) {
+      case 1:
+        coeff *= complex_t(0., -1.);
+        break;
+      case 2:
+        coeff = -coeff;
+        break;
+      case 3:
+        coeff *= complex_t(0., 1.);
+        break;
+      }
+      if (std::abs(coeff) <= atol)
+        continue;
+      if (std::abs(coeff.imag()) > atol) {
+        throw std::invalid_argument(
+            "jordan_wigner: the fermionic operator is not Hermitian.");
+      }
+      paulis.emplace_back(term.first, coeff.real());
+    }
+  }
+  std::sort(paulis.begin(), paulis.end(),
+            [](const std::pair<PauliKey, double> &a,
+               const std::pair<PauliKey, double> &b) {
+              return a.first < b.first;
+            });
+
+  PauliTable table;
+  table.num_qubits = op.num_spin_orbitals;
+  table.x_masks.reserve(paulis.size());
+  table.z_masks.reserve(paulis.size());
+  table.coeffs.reserve(paulis.size());
+  for (const auto &pauli : paulis) {
+    table.x_masks.push_back(pauli.first.x);
+    table.z_masks.push_back(pauli.first.z);
+    table.coeffs.push_back(pauli.second);
+  }
+  return table;
+}
+
+//------------------------------------------------------------------------------
+} // end namespace AER
+//------------------------------------------------------------------------------
+#endif // end module
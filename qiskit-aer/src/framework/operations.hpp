@@ -387,6 +387,8 @@ enum class OpType {
   save_state,
   save_expval,
   save_expval_var,
+  save_hamiltonian_expval, //SW
+  save_energy_gradient,    //SW
   save_statevec,
   save_statevec_dict,
   save_densmat,
@@ -429,7 +431,8 @@ static const std::unordered_set<OpType> SAVE_TYPES = {
     OpType::save_statevec, OpType::save_statevec_dict, OpType::save_densmat,
     OpType::save_probs,    OpType::save_probs_ket,     OpType::save_amps,
     OpType::save_amps_sq,  OpType::save_stabilizer,    OpType::save_clifford,
-    OpType::save_unitary,  OpType::save_mps,           OpType::save_superop};
+    OpType::save_unitary,  OpType::save_mps,           OpType::save_superop,
+    OpType::save_hamiltonian_expval, OpType::save_energy_gradient}; //SW
 
 inline std::ostream &operator<<(std::ostream &stream, const OpType &type) {
   switch (type) {
@@ -456,6 +459,13 @@ inline std::ostream &operator<<(std::ostream &stream, const OpType &type) {
     break;
   case OpType::save_expval_var:
     stream << "save_expval_var";
+    break;
+  case OpType::save_hamiltonian_expval:
+    stream << "save_hamiltonian_expval";
+    break;
+  case OpType::save_energy_gradient:
+    stream << "save_energy_gradient";
+    break;
   case OpType::save_statevec:
     stream << "save_statevector";
     break;
@@ -747,7 +757,7 @@ inline void check_gate_params(const Op &op) {
       {"mcu", {1, 4}},     {"mcp", {1, 1}},      {"ecr", {2, 0}},
       {"crx", {1, 1}},     {"cry", {1, 1}},      {"crz", {1, 1}},
       {"H+S", {1, 0}},     {"SDG+H", {1, 0}},    {"MOSQ", {1, 1}}, 
-      {"MOSQ_CR", {1, 4}}, //SW
+      {"MOSQ_CR", {1, 1}}, {"MOSQ_BLOCK", {1, 1}}, //SW
   });
 
   auto it = param_tables.find(op.name);
@@ -758,6 +768,13 @@ inline void check_gate_params(const Op &op) {
   } else {
     check_length_qubits(op, std::get<0>(it->second));
     check_length_params(op, std::get<1>(it->second));
+    // MOSQ_CR takes [theta] with int_params [X_idx, Y_idx, Z_idx], and
+    // MOSQ_BLOCK one such rotation per theta //SW
+    if ((op.name == "MOSQ_CR" && op.int_params.size() != 3) ||
+        (op.name == "MOSQ_BLOCK" &&
+         op.int_params.size() != 3 * op.params.size()))
+      throw std::invalid_argument(R"(Invalid operation ")" + op.name +
+                                  R"(" ("int_params" is incorrect length).)");
   }
 }
 
@@ -988,6 +1005,23 @@ Op make_gate(const std::string &name, const reg_t &qubits,
   return op;
 }
 
+// Pauli rotation exp(-i theta/2 P) up to a global phase, with the Pauli string
+// P given by its 64 bit X/Y/Z qubit masks. Only theta is a parameter, so
+// runtime parameter binding leaves the masks alone.
+Op make_MOSQ_CR(const reg_t &qubits, const complex_t theta,
+                const uint_t x_mask, const uint_t y_mask, const uint_t z_mask,
+                const int_t conditional,
+                const std::shared_ptr<CExpr> expr = nullptr,
+                const std::string &label = ""); //SW
+Op make_MOSQ_CR(const reg_t &qubits, const complex_t theta,
+                const uint_t x_mask, const uint_t y_mask, const uint_t z_mask,
+                const int_t conditional, const std::shared_ptr<CExpr> expr,
+                const std::string &label) {
+  Op op = make_gate("MOSQ_CR", qubits, {theta}, {}, conditional, expr, label);
+  op.int_params = {x_mask, y_mask, z_mask};
+  return op;
+} //SW
+
 template <typename T> // real or complex numeric type
 inline Op make_u1(uint_t qubit, T lam) {
   Op op;
@@ -1118,7 +1152,9 @@ inline Op make_save_state(const reg_t &qubits, const std::string &name,
       {"save_density_matrix", OpType::save_densmat},
       {"save_stabilizer", OpType::save_stabilizer},
       {"save_expval", OpType::save_expval},
-      {"save_expval_var", OpType::save_expval_var}};
+      {"save_expval_var", OpType::save_expval_var},
+      {"save_hamiltonian_expval", OpType::save_hamiltonian_expval},
+      {"save_energy_gradient", OpType::save_energy_gradient}};
 
   auto type_it = types.find(name);
   if (type_it == types.end()) {
@@ -1181,6 +1217,81 @@ inline Op make_save_expval(const reg_t &qubits, const std::string &name,
   return op;
 }
 
+//SW
+// A Pauli sum given as a table of terms: int_params holds the masks
+// [x_mask, z_mask] of each term and params its real coefficient. Bit j of a
+// mask refers to qubits[j], and a set bit in both masks is a Y. The per term
+// expectation values are also saved to per_term_label if it is not empty.
+inline Op make_save_hamiltonian_expval(const reg_t &qubits,
+                                       const std::string &name,
+                                       const std::vector<uint_t> &x_masks,
+                                       const std::vector<uint_t> &z_masks,
+                                       const std::vector<double> &coeffs,
+                                       const std::string &snapshot_type,
+                                       const std::string &label,
+                                       const std::string &per_term_label = "") {
+  if (x_masks.size() != coeffs.size() || z_masks.size() != coeffs.size()) {
+    throw std::invalid_argument(
+        "Invalid save Hamiltonian expval instruction (mask and coefficient "
+        "tables have different lengths).");
+  }
+  if (qubits.size() > 64) {
+    throw std::invalid_argument(
+        "Invalid save Hamiltonian expval instruction (more than 64 qubits).");
+  }
+
+  auto op = make_save_state(qubits, name, snapshot_type, label);
+  if (!per_term_label.empty())
+    op.string_params.push_back(per_term_label);
+
+  const uint_t qubit_mask =
+      (qubits.size() < 64) ? (1ULL << qubits.size()) - 1 : ~0ULL;
+  op.int_params.reserve(2 * coeffs.size());
+  op.params.reserve(coeffs.size());
+  for (uint_t i = 0; i < coeffs.size(); ++i) {
+    if ((x_masks[i] | z_masks[i]) & ~qubit_mask) {
+      throw std::invalid_argument(
+          "Invalid save Hamiltonian expval instruction (Pauli mask does not "
+          "match qubit number).");
+    }
+    op.int_params.push_back(x_masks[i]);
+    op.int_params.push_back(z_masks[i]);
+    op.params.push_back(coeffs[i]);
+  }
+  return op;
+}
+
+// The gradient of the Pauli sum energy with respect to the angles of the
+// Pauli rotations applied before the instruction, saved to label. The Pauli
+// sum is stored as for save_hamiltonian_expval and the energy is also saved
+// to energy_label if it is not empty.
+inline Op make_save_energy_gradient(const reg_t &qubits,
+                                    const std::vector<uint_t> &x_masks,
+                                    const std::vector<uint_t> &z_masks,
+                                    const std::vector<double> &coeffs,
+                                    const std::string &snapshot_type,
+                                    const std::string &label,
+                                    const std::string &energy_label = "") {
+  return make_save_hamiltonian_expval(qubits, "save_energy_gradient", x_masks,
+                                      z_masks, coeffs, snapshot_type, label,
+                                      energy_label);
+}
+
+// Pauli label of term i of a save_hamiltonian_expval instruction
+inline std::string hamiltonian_term_pauli(const Op &op, const uint_t i) {
+  const uint_t N = op.qubits.size();
+  const uint_t x_mask = op.int_params[2 * i];
+  const uint_t z_mask = op.int_params[2 * i + 1];
+  std::string pauli(N, 'I');
+  for (uint_t j = 0; j < N; ++j) {
+    const bool x = (x_mask >> j) & 1;
+    const bool z = (z_mask >> j) & 1;
+    if (x || z)
+      pauli[N - 1 - j] = x ? (z ? 'Y' : 'X') : 'Z';
+  }
+  return pauli;
+} //SW
+
 template <typename inputdata_t>
 inline Op make_set_vector(const reg_t &qubits, const std::string &name,
                           const inputdata_t &params) {
@@ -1399,6 +1510,9 @@ template <typename inputdata_t>
 Op input_to_op_save_expval(const inputdata_t &input, bool variance);
 template <typename inputdata_t>
 Op input_to_op_save_amps(const inputdata_t &input, bool squared);
+template <typename inputdata_t>
+Op input_to_op_save_hamiltonian_expval(const inputdata_t &input,
+                                        const OpType type); //SW
 
 // Control-Flow
 template <typename inputdata_t>
@@ -1466,6 +1580,12 @@ Op input_to_op(const inputdata_t &input) {
     return input_to_op_save_expval(input, false);
   if (name == "save_expval_var")
     return input_to_op_save_expval(input, true);
+  if (name == "save_hamiltonian_expval")
+    return input_to_op_save_hamiltonian_expval(
+        input, OpType::save_hamiltonian_expval); //SW
+  if (name == "save_energy_gradient")
+    return input_to_op_save_hamiltonian_expval(
+        input, OpType::save_energy_gradient); //SW
   if (name == "save_statevector")
     return input_to_op_save_default(input, OpType::save_statevec);
   if (name == "save_statevector_dict")
@@ -1604,6 +1724,13 @@ Op input_to_op_gate(const inputdata_t &input) {
   // Conditional
   add_conditional(Allowed::Yes, op, input);
 
+  // MOSQ_CR instructions carry [theta, X_idx, Y_idx, Z_idx] as params //SW
+  if (op.name == "MOSQ_CR" && op.params.size() == 4) {
+    for (uint_t i = 1; i < 4; ++i)
+      op.int_params.push_back((uint_t)op.params[i].real());
+    op.params.resize(1);
+  }
+
   // Validation
   check_empty_name(op);
   check_empty_qubits(op);
@@ -2044,6 +2171,46 @@ Op input_to_op_save_expval(const inputdata_t &input, bool variance) {
 
   return op;
 }
+//SW
+template <typename inputdata_t>
+Op input_to_op_save_hamiltonian_expval(const inputdata_t &input,
+                                        const OpType type) {
+  Op op = input_to_op_save_default(input, type);
+
+  // Terms are given as [x_mask, z_mask, coeff] with masks relative to qubits
+  std::vector<uint_t> x_masks, z_masks;
+  std::vector<double> coeffs;
+  if (Parser<inputdata_t>::check_key("params", input) &&
+      Parser<inputdata_t>::is_array("params", input)) {
+    for (const auto &term_ : Parser<inputdata_t>::get_value("params", input)) {
+      const auto &term = Parser<inputdata_t>::get_as_list(term_);
+      x_masks.push_back(
+          Parser<inputdata_t>::template get_list_elem<uint_t>(term, 0));
+      z_masks.push_back(
+          Parser<inputdata_t>::template get_list_elem<uint_t>(term, 1));
+      coeffs.push_back(
+          Parser<inputdata_t>::template get_list_elem<double>(term, 2));
+    }
+  } else {
+    throw std::invalid_argument(
+        "Invalid save Hamiltonian expval \"params\".");
+  }
+  // The energy gradient saves the energy instead of the term values
+  std::string per_term_label;
+  Parser<inputdata_t>::get_value(per_term_label,
+                                 (type == OpType::save_energy_gradient)
+                                     ? "energy_label"
+                                     : "per_term_label",
+                                 input);
+
+  auto snapshot_type = op.save_type;
+  op = make_save_hamiltonian_expval(op.qubits, op.name, x_masks, z_masks,
+                                    coeffs, "single", op.string_params[0],
+                                    per_term_label);
+  op.save_type = snapshot_type;
+  return op;
+}
+
 template <typename inputdata_t>
 Op input_to_op_save_amps(const inputdata_t &input, bool squared) {
   // Initialized default save instruction params
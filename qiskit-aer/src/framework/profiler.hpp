@@ -0,0 +1,361 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_framework_profiler_hpp_
+#define _aer_framework_profiler_hpp_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <vector>
+
+#if defined(AER_PERF_EVENTS) && defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define AER_HARDWARE_COUNTERS
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "framework/results/experiment_result.hpp"
+#include "framework/types.hpp"
+
+namespace AER {
+namespace Profiling {
+
+//SW
+// Per-op-type profiling of the ops applied by a State.
+//
+// The profiler is compiled in with the AER_PROFILING definition (the
+// AER_PROFILING CMake flag). Without it Profile and Timer are empty classes
+// and a profiled op costs nothing. With it each op takes two steady_clock
+// reads and one update of a flat table indexed by the op kind.
+//
+// A table is owned by one State, which is only updated by the thread
+// applying its ops, so no locking is needed. It is emitted once per
+// experiment by State::add_metadata under the "profile" metadata key:
+//   {"<kind>": {"calls", "time", "bytes", "mean_qubits", "max_qubits"}}
+// with the time in seconds and the bytes an estimate of the statevector
+// memory read and written. The achieved "bandwidth" is in GB/s.
+//
+// With the AER_PERF_EVENTS definition on Linux each op also reads the
+// "cycles", "instructions" and "llc_misses" hardware counters of the threads
+// of the process with perf_event_open, and the "profile_peak_bandwidth" of a
+// STREAM triad is measured once to compare the achieved bandwidth with.
+
+enum class Kind {
+  cx,
+  rz,
+  h,
+  s,
+  sdg,
+  hs,
+  sdgh,
+  gate, // other gates
+  mosq,
+  mosq_cr,
+  mosq_block,
+  diagonal,
+  matrix_1,
+  matrix_2,
+  matrix_3,
+  matrix_4,
+  matrix_5,
+  matrix_n, // dense matrices on more than 5 qubits
+  expval,
+  hamiltonian_expval,
+  persistent_run, // ops applied in one parallel region
+  num_kinds
+};
+
+inline const char *kind_name(const Kind kind) {
+  static const char *names[] = {
+      "cx",       "rz",       "h",        "s",          "sdg",
+      "hs",       "sdgh",     "gate",     "MOSQ",       "MOSQ_CR",
+      "MOSQ_BLOCK", "diagonal", "matrix_1", "matrix_2", "matrix_3",
+      "matrix_4", "matrix_5", "matrix_n", "expval",     "hamiltonian_expval",
+      "persistent_run"};
+  return names[static_cast<int>(kind)];
+}
+
+// Kind of a dense matrix on num_qubits qubits
+inline Kind matrix_kind(const uint_t num_qubits) {
+  if (num_qubits == 0 || num_qubits > 5)
+    return Kind::matrix_n;
+  return static_cast<Kind>(static_cast<int>(Kind::matrix_1) + num_qubits - 1);
+}
+
+// Values of the hardware counters
+struct Events {
+  uint_t cycles = 0;
+  uint_t instructions = 0;
+  uint_t llc_misses = 0;
+
+  Events operator-(const Events &other) const {
+    Events diff;
+    diff.cycles = cycles - other.cycles;
+    diff.instructions = instructions - other.instructions;
+    diff.llc_misses = llc_misses - other.llc_misses;
+    return diff;
+  }
+};
+
+struct Counters {
+  uint_t calls = 0;
+  uint_t nanoseconds = 0;
+  uint_t bytes = 0;
+  uint_t qubits = 0;
+  uint_t max_qubits = 0;
+  Events events;
+};
+
+#ifdef AER_HARDWARE_COUNTERS
+
+// Cycles, instructions and last level cache misses of the user code of the
+// OpenMP threads. A group of counters is opened on each thread of a parallel
+// region of the maximum number of threads, which are the threads reused by
+// the parallel regions of the kernels. The counters of a thread are read by
+// the thread starting and stopping a Timer, so the events of the kernels of
+// parallel experiments are mixed.
+//
+// If the counters can not be opened, e.g. without a PMU in a virtual machine
+// or with a perf_event_paranoid setting above 2, they are disabled.
+class HardwareCounters {
+public:
+  static HardwareCounters &instance() {
+    static HardwareCounters counters;
+    return counters;
+  }
+
+  bool enabled() const { return !leaders_.empty(); }
+
+  // Sum of the counters of the threads
+  Events read() const {
+    Events total;
+    struct {
+      uint64_t nr;
+      uint64_t values[3];
+    } data;
+    for (const int fd : leaders_) {
+      if (::read(fd, &data, sizeof(data)) != sizeof(data))
+        continue;
+      total.cycles += data.values[0];
+      total.instructions += data.values[1];
+      total.llc_misses += data.values[2];
+    }
+    return total;
+  }
+
+  ~HardwareCounters() {
+    for (const int fd : fds_)
+      ::close(fd);
+  }
+  HardwareCounters(const HardwareCounters &) = delete;
+  HardwareCounters &operator=(const HardwareCounters &) = delete;
+
+private:
+  HardwareCounters() {
+    bool failed = false;
+#pragma omp parallel
+    {
+      std::array<int, 3> fds;
+      fds[0] = open_event(PERF_COUNT_HW_CPU_CYCLES, -1);
+      fds[1] = open_event(PERF_COUNT_HW_INSTRUCTIONS, fds[0]);
+      fds[2] = open_event(PERF_COUNT_HW_CACHE_MISSES, fds[0]);
+#pragma omp critical
+      {
+        for (const int fd : fds) {
+          if (fd >= 0)
+            fds_.push_back(fd);
+          else
+            failed = true;
+        }
+        leaders_.push_back(fds[0]);
+      }
+    }
+    if (failed)
+      leaders_.clear();
+  }
+
+  // Open a counter of the calling thread in the group of a leader
+  static int open_event(const uint64_t config, const int leader) {
+    if (leader == -2)
+      return -2;
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    const int fd = static_cast<int>(
+        syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0));
+    return fd >= 0 ? fd : -2;
+  }
+
+  std::vector<int> leaders_;
+  std::vector<int> fds_;
+};
+
+// Peak bandwidth in GB/s of the OpenMP threads, the best of a few STREAM
+// triads on arrays larger than the last level cache
+inline double peak_bandwidth() {
+  static const double peak = [] {
+    const int_t size = 1LL << 23;
+    std::vector<double> a(size, 1.), b(size, 2.), c(size, 0.);
+    double best = 0.;
+    for (int repeat = 0; repeat < 5; ++repeat) {
+      const auto start = std::chrono::steady_clock::now();
+#pragma omp parallel for
+      for (int_t i = 0; i < size; ++i)
+        c[i] = a[i] + 3. * b[i];
+      const std::chrono::duration<double> elapsed =
+          std::chrono::steady_clock::now() - start;
+      best = std::max(best, 3e-9 * size * sizeof(double) / elapsed.count());
+    }
+    return best;
+  }();
+  return peak;
+}
+
+#endif
+
+#ifdef AER_PROFILING
+
+class Profile {
+public:
+  void add(const Kind kind, const uint_t nanoseconds, const uint_t num_qubits,
+           const uint_t bytes, const Events &events = Events()) {
+    Counters &counters = table_[static_cast<int>(kind)];
+    ++counters.calls;
+    counters.nanoseconds += nanoseconds;
+    counters.bytes += bytes;
+    counters.qubits += num_qubits;
+    if (num_qubits > counters.max_qubits)
+      counters.max_qubits = num_qubits;
+    counters.events.cycles += events.cycles;
+    counters.events.instructions += events.instructions;
+    counters.events.llc_misses += events.llc_misses;
+  }
+
+  const Counters &counters(const Kind kind) const {
+    return table_[static_cast<int>(kind)];
+  }
+
+  void clear() { table_.fill(Counters()); }
+
+  void add_metadata(ExperimentResult &result) const {
+    for (int i = 0; i < static_cast<int>(Kind::num_kinds); ++i) {
+      const Counters &counters = table_[i];
+      if (counters.calls == 0)
+        continue;
+      const std::string name = kind_name(static_cast<Kind>(i));
+      result.metadata.add(counters.calls, "profile", name, "calls");
+      result.metadata.add(1e-9 * counters.nanoseconds, "profile", name,
+                          "time");
+      result.metadata.add(counters.bytes, "profile", name, "bytes");
+      result.metadata.add(double(counters.qubits) / counters.calls, "profile",
+                          name, "mean_qubits");
+      result.metadata.add(counters.max_qubits, "profile", name, "max_qubits");
+      if (counters.nanoseconds > 0)
+        result.metadata.add(double(counters.bytes) / counters.nanoseconds,
+                            "profile", name, "bandwidth");
+#ifdef AER_HARDWARE_COUNTERS
+      if (HardwareCounters::instance().enabled()) {
+        result.metadata.add(counters.events.cycles, "profile", name, "cycles");
+        result.metadata.add(counters.events.instructions, "profile", name,
+                            "instructions");
+        result.metadata.add(counters.events.llc_misses, "profile", name,
+                            "llc_misses");
+      }
+#endif
+    }
+#ifdef AER_HARDWARE_COUNTERS
+    result.metadata.add(peak_bandwidth(), "profile_peak_bandwidth");
+#endif
+  }
+
+private:
+  std::array<Counters, static_cast<int>(Kind::num_kinds)> table_;
+};
+
+// Time the enclosing scope as one op of a kind
+class Timer {
+public:
+  using clock_t = std::chrono::steady_clock;
+
+  Timer(Profile &profile, const Kind kind, const uint_t num_qubits,
+        const uint_t bytes)
+      : profile_(profile), kind_(kind), num_qubits_(num_qubits), bytes_(bytes) {
+#ifdef AER_HARDWARE_COUNTERS
+    if (HardwareCounters::instance().enabled())
+      events_ = HardwareCounters::instance().read();
+#endif
+    start_ = clock_t::now();
+  }
+
+  ~Timer() {
+    const auto elapsed = clock_t::now() - start_;
+    Events events;
+#ifdef AER_HARDWARE_COUNTERS
+    if (HardwareCounters::instance().enabled())
+      events = HardwareCounters::instance().read() - events_;
+#endif
+    profile_.add(
+        kind_,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+        num_qubits_, bytes_, events);
+  }
+
+  Timer(const Timer &) = delete;
+  Timer &operator=(const Timer &) = delete;
+
+private:
+  Profile &profile_;
+  const Kind kind_;
+  const uint_t num_qubits_;
+  const uint_t bytes_;
+  clock_t::time_point start_;
+  Events events_;
+};
+
+#else
+
+class Profile {
+public:
+  void add(const Kind, const uint_t, const uint_t, const uint_t,
+           const Events & = Events()) {}
+  void clear() {}
+  void add_metadata(ExperimentResult &) const {}
+};
+
+class Timer {
+public:
+  Timer(Profile &, const Kind, const uint_t, const uint_t) {}
+  Timer(const Timer &) = delete;
+  Timer &operator=(const Timer &) = delete;
+};
+
+#endif
+
+//-------------------------------------------------------------------------
+} // end namespace Profiling
+} // end namespace AER
+//-------------------------------------------------------------------------
+#endif
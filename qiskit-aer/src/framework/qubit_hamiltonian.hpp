@@ -0,0 +1,220 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_framework_qubit_hamiltonian_hpp_
+#define _aer_framework_qubit_hamiltonian_hpp_
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN64) && !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "framework/types.hpp"
+
+namespace AER {
+
+//SW
+//============================================================================
+// QubitHamiltonian class
+//============================================================================
+
+// A qubit Hamiltonian stored as a binary table of Pauli terms, written once
+// per molecule so that the Pauli sum does not have to be rebuilt from the
+// fermionic operator on every run. The file is memory-mapped read-only and
+// the term tables are used in place.
+//
+// File layout (little endian, 8 byte aligned):
+//   char     magic[8]                  "AERQHAM\0"
+//   uint32   version                   1
+//   uint32   num_qubits                at most 64
+//   uint64   num_terms
+//   uint32   num_spatial_orbitals      0 if unknown
+//   uint32   num_alpha, num_beta       number of particles
+//   uint32   reserved
+//   double   nuclear_repulsion_energy
+//   double   reference_energy          NaN if unknown
+//   uint64   x_masks[num_terms]
+//   uint64   z_masks[num_terms]
+//   double   coeffs[num_terms]
+// Bit j of a mask refers to qubit j and a bit set in both masks is a Y, as
+// for the save_hamiltonian_expval instruction.
+
+class QubitHamiltonian {
+public:
+  // "AERQHAM" with its terminating null
+  static constexpr const char *magic = "AERQHAM";
+  static constexpr size_t magic_size = 8;
+  static constexpr uint32_t version = 1;
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t num_qubits;
+    uint64_t num_terms;
+    uint32_t num_spatial_orbitals;
+    uint32_t num_alpha;
+    uint32_t num_beta;
+    uint32_t reserved;
+    double nuclear_repulsion_energy;
+    double reference_energy;
+  };
+  static_assert(sizeof(Header) == 56, "unexpected QubitHamiltonian header");
+
+  QubitHamiltonian() = default;
+  explicit QubitHamiltonian(const std::string &path) { load(path); }
+  ~QubitHamiltonian() { unmap(); }
+
+  QubitHamiltonian(const QubitHamiltonian &) = delete;
+  QubitHamiltonian &operator=(const QubitHamiltonian &) = delete;
+
+  // Map the file at path, replacing the current table
+  void load(const std::string &path);
+
+  // Write a term table and its metadata to path
+  static void save(const std::string &path, const Header &header,
+                   const uint64_t *x_masks, const uint64_t *z_masks,
+                   const double *coeffs);
+
+  const Header &header() const { return *header_; }
+  uint_t num_qubits() const { return header_->num_qubits; }
+  uint_t num_terms() const { return header_->num_terms; }
+
+  const uint64_t *x_masks() const {
+    return reinterpret_cast<const uint64_t *>(header_ + 1);
+  }
+  const uint64_t *z_masks() const { return x_masks() + num_terms(); }
+  const double *coeffs() const {
+    return reinterpret_cast<const double *>(z_masks() + num_terms());
+  }
+
+protected:
+  void unmap();
+
+  const Header *header_ = nullptr;
+  // Mapped region, or the buffer the file was read into where mmap is not
+  // available
+  void *data_ = nullptr;
+  size_t size_ = 0;
+  std::vector<uint64_t> buffer_;
+};
+
+/*******************************************************************************
+ *
+ * Implementation
+ *
+ ******************************************************************************/
+
+void QubitHamiltonian::load(const std::string &path) {
+  unmap();
+  auto invalid = [&path](const std::string &msg) {
+    return std::invalid_argument("QubitHamiltonian: " + msg + " (\"" + path +
+                                 "\").");
+  };
+
+#if !defined(_WIN64) && !defined(_WIN32)
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw invalid("can not open file");
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw invalid("can not stat file");
+  }
+  size_ = st.st_size;
+  if (size_ >= sizeof(Header)) {
+    data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data_ == MAP_FAILED)
+      data_ = nullptr;
+  }
+  ::close(fd);
+  if (data_ == nullptr && size_ >= sizeof(Header))
+    throw invalid("can not map file");
+#else
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file)
+    throw invalid("can not open file");
+  size_ = file.tellg();
+  buffer_.resize((size_ + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+  file.seekg(0);
+  file.read(reinterpret_cast<char *>(buffer_.data()), size_);
+  data_ = buffer_.data();
+#endif
+  if (size_ < sizeof(Header)) {
+    unmap();
+    throw invalid("file too short");
+  }
+
+  header_ = reinterpret_cast<const Header *>(data_);
+  std::string error;
+  if (std::memcmp(header_->magic, magic, magic_size) != 0)
+    error = "not a qubit Hamiltonian file";
+  else if (header_->version != version)
+    error = "unsupported version " + std::to_string(header_->version);
+  else if (header_->num_qubits > 64)
+    error = "more than 64 qubits";
+  else if (size_ != sizeof(Header) + 3 * sizeof(uint64_t) * num_terms())
+    error = "file size does not match the number of terms";
+  if (!error.empty()) {
+    unmap();
+    throw invalid(error);
+  }
+}
+
+void QubitHamiltonian::save(const std::string &path, const Header &header,
+                            const uint64_t *x_masks, const uint64_t *z_masks,
+                            const double *coeffs) {
+  Header head = header;
+  std::memcpy(head.magic, magic, magic_size);
+  head.version = version;
+  head.reserved = 0;
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file)
+    throw std::invalid_argument("QubitHamiltonian: can not open file (\"" +
+                                path + "\").");
+  const size_t bytes = sizeof(uint64_t) * head.num_terms;
+  file.write(reinterpret_cast<const char *>(&head), sizeof(Header));
+  file.write(reinterpret_cast<const char *>(x_masks), bytes);
+  file.write(reinterpret_cast<const char *>(z_masks), bytes);
+  file.write(reinterpret_cast<const char *>(coeffs), bytes);
+  if (!file)
+    throw std::runtime_error("QubitHamiltonian: can not write file (\"" +
+                             path + "\").");
+}
+
+void QubitHamiltonian::unmap() {
+#if !defined(_WIN64) && !defined(_WIN32)
+  if (data_ != nullptr)
+    ::munmap(data_, size_);
+#endif
+  buffer_.clear();
+  buffer_.shrink_to_fit();
+  header_ = nullptr;
+  data_ = nullptr;
+  size_ = 0;
+}
+
+//------------------------------------------------------------------------------
+} // end namespace AER
+//------------------------------------------------------------------------------
+#endif // end module
@@ -0,0 +1,210 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_framework_trace_hpp_
+#define _aer_framework_trace_hpp_
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace AER {
+namespace Tracing {
+
+//SW
+// Timeline of a simulation in the Chrome trace event format, which is read
+// by chrome://tracing and https://ui.perfetto.dev.
+//
+// A Recording started with the trace_file option collects complete ("X")
+// events of the spans closed while it is active and appends them to the
+// file when it ends. The file is truncated when a recording starts on a new
+// file name, so the runs of an optimizer loop end up in one timeline. The
+// closing bracket of the JSON array is omitted, as permitted by the format,
+// so other writers can append their events with the same clock: the event
+// timestamps are steady_clock (CLOCK_MONOTONIC) microseconds.
+//
+// Without an active recording a Span only reads an atomic flag.
+class Trace {
+public:
+  static Trace &instance() {
+    static Trace trace;
+    return trace;
+  }
+
+  static bool active() {
+    return instance().active_.load(std::memory_order_relaxed);
+  }
+
+  // Microseconds of the steady clock
+  static double now() {
+    return 1e-3 * std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                      .count();
+  }
+
+  // Small id of the calling thread
+  static int thread_id() {
+    static std::atomic<int> next_id(1);
+    thread_local int id = next_id++;
+    return id;
+  }
+
+  // Start collecting events for a file
+  void start(const std::string &filename) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (depth_ > 0) {
+      ++depth_;
+      return;
+    }
+    if (filename != filename_) {
+      std::ofstream file(filename, std::ios::out | std::ios::trunc);
+      if (!file)
+        throw std::invalid_argument("Could not open trace file \"" +
+                                    filename + "\".");
+      filename_ = filename;
+      file << "[\n"
+           << R"({"name":"process_name","ph":"M","pid":1,"tid":0,)"
+           << R"("args":{"name":"qiskit-aer"}},)" << "\n";
+    }
+    ++depth_;
+    active_.store(true, std::memory_order_relaxed);
+  }
+
+  // Append the collected events to the file
+  void stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (depth_ == 0 || --depth_ > 0)
+      return;
+    active_.store(false, std::memory_order_relaxed);
+    std::ofstream file(filename_, std::ios::out | std::ios::app);
+    for (const auto &event : events_)
+      file << event;
+    events_.clear();
+  }
+
+  // JSON string contents of a name, e.g. of a gate with a user label
+  static std::string escape(const std::string &str) {
+    std::string escaped;
+    escaped.reserve(str.size());
+    for (const unsigned char c : str) {
+      if (c == '"' || c == '\\') {
+        escaped += '\\';
+        escaped += c;
+      } else if (c < 0x20) {
+        char code[7];
+        std::snprintf(code, sizeof(code), "\\u%04x", c);
+        escaped += code;
+      } else {
+        escaped += c;
+      }
+    }
+    return escaped;
+  }
+
+  // Add a complete event, args being the members of its args object. The
+  // name and category are escaped, args must already be valid JSON.
+  void add(const char *category, const std::string &name, const double ts,
+           const double dur, const std::string &args) {
+    std::ostringstream event;
+    event.precision(3);
+    event << std::fixed << R"({"name":")" << escape(name) << R"(","cat":")"
+          << escape(category) << R"(","ph":"X","ts":)" << ts
+          << ",\"dur\":" << dur
+          << ",\"pid\":1,\"tid\":" << thread_id() << ",\"args\":{" << args
+          << "}},\n";
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.push_back(event.str());
+  }
+
+private:
+  Trace() = default;
+
+  std::atomic<bool> active_{false};
+  std::mutex mutex_;
+  int depth_ = 0;
+  std::string filename_;
+  std::vector<std::string> events_;
+};
+
+// Record the spans closed during its lifetime if filename is not empty
+class Recording {
+public:
+  explicit Recording(const std::string &filename)
+      : enabled_(!filename.empty()) {
+    if (enabled_)
+      Trace::instance().start(filename);
+  }
+  ~Recording() {
+    if (enabled_)
+      Trace::instance().stop();
+  }
+  Recording(const Recording &) = delete;
+  Recording &operator=(const Recording &) = delete;
+
+private:
+  const bool enabled_;
+};
+
+// A span from its construction to its destruction
+class Span {
+public:
+  explicit Span(const char *category)
+      : active_(Trace::active()), category_(category) {
+    if (active_)
+      start_ = Trace::now();
+  }
+  Span(const char *category, const std::string &name) : Span(category) {
+    if (active_)
+      name_ = name;
+  }
+  ~Span() { end(); }
+  Span(const Span &) = delete;
+  Span &operator=(const Span &) = delete;
+
+  // Whether the span is recorded, to skip building its name and args
+  explicit operator bool() const { return active_; }
+
+  void set_name(const std::string &name) { name_ = name; }
+
+  // Set the members of the args object, e.g. "\"qubits\":[0,1]"
+  void set_args(std::string args) { args_ = std::move(args); }
+
+  // Record the span now instead of at its destruction
+  void end() {
+    if (active_) {
+      Trace::instance().add(category_, name_, start_, Trace::now() - start_,
+                            args_);
+      active_ = false;
+    }
+  }
+
+private:
+  bool active_;
+  const char *category_;
+  std::string name_;
+  std::string args_;
+  double start_ = 0.;
+};
+
+//-------------------------------------------------------------------------
+} // end namespace Tracing
+} // end namespace AER
+//-------------------------------------------------------------------------
+#endif
@@ -15,7 +15,10 @@
 #ifndef QASM_SIMULATOR_COMMON_MACROS_HPP
 #define QASM_SIMULATOR_COMMON_MACROS_HPP
 
-#if defined(__GNUC__) && defined(__x86_64__) && defined(__AVX2__)
+// The AVX2 kernels live in their own translation unit (qv_avx2.cpp) built
+// with the SIMD flags and are selected at runtime by is_avx2_supported(), so
+// the rest of the code base must not require __AVX2__ to dispatch to them.
+#if defined(__GNUC__) && defined(__x86_64__)
 #define GNUC_AVX2
 #endif
 
@@ -22,6 +22,7 @@
 #include "framework/results/experiment_result.hpp"
 #include "framework/results/result.hpp"
 #include "framework/rng.hpp"
+#include "framework/trace.hpp"
 #include "framework/types.hpp"
 #include "noise/noise_model.hpp"
 
@@ -207,6 +208,15 @@ protected:
                                           RngEngine &rng, const uint_t iparam,
                                           bool final_op);
 
+  // Apply the operations before the first measurement of a circuit run with
+  // measure sampling //SW
+  virtual void apply_ops_before_sampling(state_t &state, OpItr first,
+                                         OpItr last, double global_phase,
+                                         ExperimentResult &result,
+                                         RngEngine &rng, bool final_ops) {
+    state.apply_ops(first, last, result, rng, final_ops);
+  }
+
   template <typename InputIterator>
   void measure_sampler(InputIterator first_meas, InputIterator last_meas,
                        uint_t shots, state_t &state, ExperimentResult &result,
@@ -490,15 +500,30 @@ void Executor<state_t>::set_parallelization(const Config &config,
   if (explicit_parallelization_)
     return;
 
+  //SW
+  // The parameter sets of a statevector circuit below the OpenMP qubit
+  // threshold, whose state update is serial anyway, run on independent
+  // states in parallel. Larger circuits run them one after the other with a
+  // parallel state update.
+  const bool parallel_bind_params =
+      circ.num_bind_params > 1 && num_process_per_experiment_ == 1 &&
+      (method_ == Method::statevector ||
+       method_ == Method::subspace_statevector) &&
+      circ.num_qubits < (uint_t)omp_qubit_threshold_;
+  const bool sampling =
+      !noise.has_quantum_errors() && check_measure_sampling_opt(circ);
+
   // Check for trivial parallelization conditions
   switch (method_) {
   case Method::statevector:
+  case Method::subspace_statevector: //SW
   case Method::stabilizer:
   case Method::unitary:
   case Method::matrix_product_state: {
+    if (parallel_bind_params)
+      break;
     if (circ.shots == 1 || num_process_per_experiment_ > 1 ||
-        (!noise.has_quantum_errors() && check_measure_sampling_opt(circ) &&
-         circ.num_bind_params == 1)) {
+        (sampling && circ.num_bind_params == 1)) {
       parallel_shots_ = 1;
       parallel_state_update_ =
           std::max<int>({1, max_parallel_threads_ / parallel_experiments_});
@@ -550,7 +575,11 @@ void Executor<state_t>::set_parallelization(const Config &config,
     // If circ memory is 0, set it to 1 so that we don't divide by zero
     circ_memory_mb = std::max<int>({1, circ_memory_mb});
 
+    // With measure sampling a parameter set is simulated once for all shots
     int shots = circ.shots;
+    if (parallel_bind_params)
+      shots = sampling ? circ.num_bind_params
+                       : circ.shots * circ.num_bind_params;
     parallel_shots_ = std::min<int>(
         {static_cast<int>(mem_size / (circ_memory_mb * 2)), max_shots, shots});
   }
@@ -567,6 +596,12 @@ void Executor<state_t>::run_circuit(Circuit &circ,
                                     const Device device, ResultItr result_it) {
   // Start individual circuit timer
   auto timer_start = myclock_t::now(); // state circuit timer
+  Tracing::Span span("executor", "circuit"); //SW
+  if (span)
+    span.set_args("\"num_qubits\":" + std::to_string(circ.num_qubits) +
+                  ",\"num_ops\":" + std::to_string(circ.ops.size()) +
+                  ",\"num_bind_params\":" +
+                  std::to_string(circ.num_bind_params));
 
   // Execute in try block so we can catch errors and return the error message
   // for individual circuit failures.
@@ -787,10 +822,11 @@ void Executor<state_t>::run_circuit_with_sampling(Circuit &circ,
         state.set_max_sampling_shots(circ.shots);
       }
 
-      if (circ.global_phase_for_params.size() == circ.num_bind_params)
-        state.set_global_phase(circ.global_phase_for_params[iparam]);
-      else
-        state.set_global_phase(circ.global_phase_angle);
+      const double global_phase =
+          (circ.global_phase_for_params.size() == circ.num_bind_params)
+              ? circ.global_phase_for_params[iparam]
+              : circ.global_phase_angle;
+      state.set_global_phase(global_phase);
 
         // allocate qubit register
 #ifdef AER_CUSTATEVEC
@@ -811,8 +847,9 @@ void Executor<state_t>::run_circuit_with_sampling(Circuit &circ,
                                            result, rng, iparam, final_ops);
       } else {
         // printf("I'm in apply_ops()\n");
-        state.apply_ops(circ.ops.cbegin(), circ.ops.cbegin() + first_meas,
-                        result, rng, final_ops);
+        apply_ops_before_sampling(state, circ.ops.cbegin(),
+                                  circ.ops.cbegin() + first_meas, global_phase,
+                                  result, rng, final_ops);
       }
 
       // Get measurement operations and set of measured qubits
@@ -1008,6 +1045,21 @@ template <class state_t>
 void Executor<state_t>::run_circuit_with_parameter_binding(
     state_t &state, OpItr first, OpItr last, ExperimentResult &result,
     RngEngine &rng, const uint_t iparam, bool final_op) {
+  // A gradient reverses all the ops before it, so the whole circuit is bound
+  // and applied at once
+  if (std::any_of(first, last, [](const Operations::Op &op) {
+        return op.type == Operations::OpType::save_energy_gradient;
+      })) {
+    std::vector<Operations::Op> binded_ops(first, last);
+    for (auto &op : binded_ops) {
+      if (op.has_bind_params)
+        op = Operations::bind_parameter(op, iparam, num_bind_params_);
+    }
+    state.apply_ops(binded_ops.cbegin(), binded_ops.cend(), result, rng,
+                    final_op);
+    return;
+  } //SW
+
   OpItr op_begin = first;
   OpItr op = first;
 
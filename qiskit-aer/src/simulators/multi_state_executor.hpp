@@ -141,6 +141,9 @@ protected:
 
   void apply_save_expval(Branch &root, const Operations::Op &op,
                          ResultItr result);
+
+  void apply_save_hamiltonian_expval(Branch &root, const Operations::Op &op,
+                                     ResultItr result); //SW
 };
 
 template <class state_t>
@@ -852,13 +855,19 @@ void MultiStateExecutor<state_t>::apply_save_expval(Branch &root,
   double expval(0.);
   double sq_expval(0.);
 
-  for (const auto &param : op.expval_params) {
+  std::vector<std::string> paulis;
+  paulis.reserve(op.expval_params.size());
+  for (const auto &param : op.expval_params)
+    paulis.push_back(std::get<0>(param));
+  const auto vals =
+      states_[root.state_index()].expval_paulis(op.qubits, paulis); //SW
+
+  for (uint_t i = 0; i < vals.size(); ++i) {
     // param is tuple (pauli, coeff, sq_coeff)
-    auto val =
-        states_[root.state_index()].expval_pauli(op.qubits, std::get<0>(param));
-    expval += std::get<1>(param) * val;
+    const auto &param = op.expval_params[i];
+    expval += std::get<1>(param) * vals[i];
     if (variance) {
-      sq_expval += std::get<2>(param) * val;
+      sq_expval += std::get<2>(param) * vals[i];
     }
   }
 
@@ -891,6 +900,30 @@ void MultiStateExecutor<state_t>::apply_save_expval(Branch &root,
   }
 }
 
+template <class state_t>
+void MultiStateExecutor<state_t>::apply_save_hamiltonian_expval(
+    Branch &root, const Operations::Op &op, ResultItr result) {
+  std::vector<double> vals;
+  const double energy =
+      states_[root.state_index()].expval_hamiltonian(op, vals);
+
+  std::vector<bool> copied(Base::num_bind_params_, false);
+  for (uint_t i = 0; i < root.num_shots(); i++) {
+    uint_t ip = root.param_index(i);
+    if (!copied[ip]) {
+      const auto &creg = states_[root.state_index()].creg();
+      (result + ip)
+          ->save_data_average(creg, op.string_params[0], energy, op.type,
+                              op.save_type);
+      if (op.string_params.size() > 1)
+        (result + ip)
+            ->save_data_average(creg, op.string_params[1], vals, op.type,
+                                op.save_type);
+      copied[ip] = true;
+    }
+  }
+} //SW
+
 //-------------------------------------------------------------------------
 } // end namespace CircuitExecutor
 //-------------------------------------------------------------------------
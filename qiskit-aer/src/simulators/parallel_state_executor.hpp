@@ -136,6 +136,10 @@ protected:
   // Apply a save expectation value instruction
   void apply_save_expval(const Operations::Op &op, ExperimentResult &result);
 
+  // Apply a save Hamiltonian expectation value instruction
+  void apply_save_hamiltonian_expval(const Operations::Op &op,
+                                     ExperimentResult &result); //SW
+
   // swap between chunks
   virtual void apply_chunk_swap(const reg_t &qubits);
 
@@ -1129,6 +1133,24 @@ void ParallelStateExecutor<state_t>::apply_save_expval(
   }
 }
 
+template <class state_t>
+void ParallelStateExecutor<state_t>::apply_save_hamiltonian_expval(
+    const Operations::Op &op, ExperimentResult &result) {
+  // Terms are evaluated one at a time over the chunks
+  const uint_t num_terms = op.params.size();
+  std::vector<double> vals(num_terms);
+  double energy(0.);
+  for (uint_t i = 0; i < num_terms; ++i) {
+    vals[i] = expval_pauli(op.qubits, Operations::hamiltonian_term_pauli(op, i));
+    energy += std::real(op.params[i]) * vals[i];
+  }
+  result.save_data_average(Base::states_[0].creg(), op.string_params[0],
+                           energy, op.type, op.save_type);
+  if (op.string_params.size() > 1)
+    result.save_data_average(Base::states_[0].creg(), op.string_params[1],
+                             std::move(vals), op.type, op.save_type);
+} //SW
+
 template <class state_t>
 void ParallelStateExecutor<state_t>::apply_chunk_swap(const reg_t &qubits) {
   uint_t q0, q1;
@@ -19,7 +19,9 @@
 #include "simulators/extended_stabilizer/extended_stabilizer_state.hpp"
 #include "simulators/matrix_product_state/matrix_product_state.hpp"
 #include "simulators/stabilizer/stabilizer_state.hpp"
+#include "simulators/statevector/real_statevector_state.hpp"
 #include "simulators/statevector/statevector_state.hpp"
+#include "simulators/subspace_statevector/subspace_state.hpp"
 #include "simulators/superoperator/superoperator_state.hpp"
 #include "simulators/tensor_network/tensor_net_state.hpp"
 #include "simulators/unitary/unitary_state.hpp"
@@ -36,7 +38,8 @@ enum class Method {
   extended_stabilizer,
   unitary,
   superop,
-  tensor_network
+  tensor_network,
+  subspace_statevector //SW
 };
 
 enum class Device { CPU, GPU, ThrustCPU };
@@ -53,7 +56,8 @@ const std::unordered_map<Method, std::string> method_names_ = {
     {Method::extended_stabilizer, "extended_stabilizer"},
     {Method::unitary, "unitary"},
     {Method::superop, "superop"},
-    {Method::tensor_network, "tensor_network"}};
+    {Method::tensor_network, "tensor_network"},
+    {Method::subspace_statevector, "subspace_statevector"}}; //SW
 
 //-------------------------------------------------------------------------
 } // end namespace AER
@@ -0,0 +1,215 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _statevector_adjoint_gradient_hpp_
+#define _statevector_adjoint_gradient_hpp_
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include <cctype>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "framework/operations.hpp"
+#include "framework/types.hpp"
+#include "framework/utils.hpp"
+
+namespace AER {
+namespace Statevector {
+
+//SW
+//============================================================================
+// Adjoint-method energy gradients
+//============================================================================
+
+// The energy gradient of a circuit with respect to the angles of its Pauli
+// rotations is computed with the adjoint method: the statevector |phi> and
+// |lambda> = H |psi> of the final state |psi> are swept back through the
+// circuit together. A rotation
+//   U(theta) = (1 + e^{i theta}) / 2 + (1 - e^{i theta}) / 2 P
+// (the MOSQ_CR convention, equal to exp(-i theta/2 P) up to a global phase)
+// has dU/dtheta = i/2 (1 - P) U, so with |phi> the state right after it and
+// |lambda> undone down to it
+//   dE/dtheta = Im <lambda|P|phi>,
+// as <lambda|phi> is the real energy. Every other op in the sweep is undone
+// with its inverse, which only has to be exact up to a global phase.
+
+// A Pauli rotation with the X, Y and Z masks of MOSQ_CR (a Y bit is only set
+// in y_mask)
+struct PauliRotation {
+  double theta;
+  uint_t x_mask;
+  uint_t y_mask;
+  uint_t z_mask;
+};
+
+// Number of Pauli rotations whose angles are differentiated in op: one per
+// angle for MOSQ, MOSQ_CR and MOSQ_BLOCK and the standard rotation gates rx,
+// ry, rz, p, u1, rxx, ryy, rzz and rzx; zero for the other ops
+inline uint_t num_pauli_rotations(const Operations::Op &op) {
+  static const std::unordered_set<std::string> gates(
+      {"MOSQ", "MOSQ_CR", "rx", "ry", "rz", "p", "u1", "rxx", "ryy", "rzz",
+       "rzx"});
+  if (op.type != Operations::OpType::gate)
+    return 0;
+  if (op.name == "MOSQ_BLOCK")
+    return op.int_params.size() / 3;
+  return gates.count(op.name) ? 1 : 0;
+}
+
+// Append the Pauli rotations of op in the order they are applied
+inline void pauli_rotations(const Operations::Op &op,
+                            std::vector<PauliRotation> &rotations) {
+  const uint_t num_rotations = num_pauli_rotations(op);
+  if (num_rotations == 0)
+    return;
+  if (op.name == "MOSQ_BLOCK") {
+    for (uint_t r = 0; r < num_rotations; ++r)
+      rotations.push_back({std::real(op.params[r]), op.int_params[3 * r],
+                           op.int_params[3 * r + 1],
+                           op.int_params[3 * r + 2]});
+    return;
+  }
+  if (op.name == "MOSQ_CR") {
+    rotations.push_back({std::real(op.params[0]), op.int_params[0],
+                         op.int_params[1], op.int_params[2]});
+    return;
+  }
+
+  // A single Pauli letter on every qubit of the gate
+  uint_t x_mask = 0, y_mask = 0, z_mask = 0;
+  auto set = [&](const char pauli, const uint_t qubit) {
+    uint_t &mask = (pauli == 'X') ? x_mask : ((pauli == 'Y') ? y_mask : z_mask);
+    mask |= (1ULL << qubit);
+  };
+  if (op.name == "MOSQ") {
+    for (const auto q : op.qubits)
+      set('Z', q);
+  } else if (op.name == "rzx") {
+    set('Z', op.qubits[0]);
+    set('X', op.qubits[1]);
+  } else {
+    const char pauli = (op.name == "p" || op.name == "u1")
+                           ? 'Z'
+                           : static_cast<char>(std::toupper(op.name[1]));
+    for (const auto q : op.qubits)
+      set(pauli, q);
+  }
+  rotations.push_back({std::real(op.params[0]), x_mask, y_mask, z_mask});
+}
+
+// Return an op that undoes op up to a global phase. Pauli rotations are
+// undone with the statevector kernels and are not handled here.
+inline Operations::Op adjoint_op(const Operations::Op &op) {
+  static const std::unordered_set<std::string> self_inverse(
+      {"id",   "delay", "x",   "y",      "z",      "h",        "cx",
+       "CX",   "cy",    "cz",  "swap",   "ccx",    "ccz",      "cswap",
+       "mcx",  "mcy",   "mcz", "mcswap", "mcx_gray", "pauli",  "ecr"});
+  static const std::unordered_map<std::string, std::string> inverse_names(
+      {{"s", "sdg"},
+       {"sdg", "s"},
+       {"t", "tdg"},
+       {"tdg", "t"},
+       {"sx", "sxdg"},
+       {"sxdg", "sx"},
+       {"csx", "csxdg"},
+       {"csxdg", "csx"},
+       {"mcsx", "mcsxdg"},
+       {"mcsxdg", "mcsx"},
+       {"H+S", "SDG+H"},
+       {"SDG+H", "H+S"}});
+  // Gates undone by negating all their angles
+  static const std::unordered_set<std::string> negate(
+      {"cp", "cu1", "crx", "cry", "crz", "mcp", "mcphase", "mcu1", "mcrx",
+       "mcry", "mcrz"});
+  // u2(phi, lam) = u3(pi/2, phi, lam)
+  static const std::unordered_map<std::string, std::string> u2_names(
+      {{"u2", "u3"}, {"cu2", "cu3"}, {"mcu2", "mcu3"}});
+
+  auto not_reversible = [&op]() {
+    return std::invalid_argument(
+        "save_energy_gradient: instruction \"" + op.name +
+        "\" before the gradient can not be reversed.");
+  };
+  if (op.conditional)
+    throw not_reversible();
+
+  Operations::Op inv = op;
+  switch (op.type) {
+  case Operations::OpType::matrix:
+    for (auto &mat : inv.mats)
+      mat = Utils::dagger(mat);
+    return inv;
+  case Operations::OpType::diagonal_matrix:
+    for (auto &param : inv.params)
+      param = std::conj(param);
+    return inv;
+  case Operations::OpType::gate:
+    break;
+  default:
+    throw not_reversible();
+  }
+
+  if (self_inverse.count(op.name))
+    return inv;
+  auto name_it = inverse_names.find(op.name);
+  if (name_it != inverse_names.end()) {
+    inv.name = name_it->second;
+    return inv;
+  }
+  if (negate.count(op.name)) {
+    for (auto &param : inv.params)
+      param = -param;
+    return inv;
+  }
+  if (op.name == "r" || op.name == "mcr") {
+    // r(theta, phi)^dagger = r(-theta, phi)
+    inv.params[0] = -op.params[0];
+    return inv;
+  }
+  // u3(theta, phi, lam)^dagger = u3(-theta, -lam, -phi), and the phase gamma
+  // of the 4 parameter u gates is negated
+  auto u_params = [&inv](const complex_t theta, const complex_t phi,
+                         const complex_t lam) {
+    inv.params[0] = -theta;
+    inv.params[1] = -lam;
+    inv.params[2] = -phi;
+    if (inv.params.size() > 3)
+      inv.params[3] = -inv.params[3];
+  };
+  auto u2_it = u2_names.find(op.name);
+  if (u2_it != u2_names.end()) {
+    inv.name = u2_it->second;
+    inv.params.resize(3);
+    u_params(M_PI / 2., op.params[0], op.params[1]);
+    return inv;
+  }
+  if (op.name == "u3" || op.name == "u" || op.name == "U" ||
+      op.name == "cu3" || op.name == "mcu3" || op.name == "cu" ||
+      op.name == "mcu") {
+    u_params(op.params[0], op.params[1], op.params[2]);
+    return inv;
+  }
+  throw not_reversible();
+}
+
+//------------------------------------------------------------------------------
+} // end namespace Statevector
+} // end namespace AER
+//------------------------------------------------------------------------------
+#endif // end module
@@ -0,0 +1,301 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _statevector_prefix_cache_hpp_
+#define _statevector_prefix_cache_hpp_
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "framework/operations.hpp"
+#include "framework/results/experiment_result.hpp"
+#include "framework/rng.hpp"
+#include "framework/types.hpp"
+
+namespace AER {
+namespace Statevector {
+
+//SW
+//============================================================================
+// PrefixCache class
+//============================================================================
+
+// Snapshots of a statevector taken at parameter boundaries of a circuit and
+// kept across runs. A variational optimizer such as COBYLA reruns the same
+// ansatz with a few changed angles, so a run resumes from the deepest
+// snapshot whose preceding gates are unchanged instead of |0...0>.
+//
+// The cache holds the snapshots of the most recent circuit structure (gate
+// names, qubits and integer parameters). Snapshots are evenly spread over
+// the parameterized gates of the leading unitary part of the circuit, as
+// many as fit in the memory budget. After a run every snapshot matches the
+// parameters of that run: snapshots behind the first changed gate are kept
+// and the deeper ones are retaken while the run passes them.
+
+template <typename value_t>
+class PrefixCache {
+public:
+  using OpItr = std::vector<Operations::Op>::const_iterator;
+
+  // One cache per amplitude type for the whole process
+  static PrefixCache &instance() {
+    static PrefixCache cache;
+    return cache;
+  }
+
+  // Apply ops [first, last) to a statevector in its initial state, resuming
+  // from a snapshot when possible, and add the cache statistics to the
+  // result metadata. The cache is bypassed while another thread uses it.
+  template <class state_t>
+  void apply_ops(state_t &state, OpItr first, OpItr last, double global_phase,
+                 ExperimentResult &result, RngEngine &rng, bool final_ops,
+                 uint_t max_memory_mb);
+
+protected:
+  PrefixCache() = default;
+
+  // Return true for operations whose effect only depends on their
+  // parameters, so the state after them can be reused
+  static bool cacheable(const Operations::Op &op);
+
+  // Structure key and parameter values of ops [first, last)
+  void get_structure(OpItr first, OpItr last, uint_t num_qubits,
+                     reg_t &key) const;
+  void get_values(OpItr first, OpItr last, std::vector<complex_t> &values,
+                  reg_t &offsets) const;
+
+  // Choose snapshot positions before parameterized operations
+  void set_positions(uint_t max_snapshots);
+
+  std::mutex mutex_;
+
+  reg_t key_;
+  double global_phase_ = 0.;
+  std::vector<complex_t> values_;
+  reg_t offsets_; // values of op i are values_[offsets_[i], offsets_[i+1])
+
+  reg_t positions_; // snapshot i is the state before op positions_[i]
+  std::vector<std::vector<value_t>> snapshots_;
+  std::vector<complex_t> phases_;
+  uint_t num_valid_ = 0; // snapshots [0, num_valid_) match values_
+  uint_t max_memory_mb_ = 0;
+
+  uint_t lookups_ = 0;
+  uint_t hits_ = 0;
+  uint_t total_bytes_saved_ = 0;
+};
+
+// Phase of a state kept outside of its amplitudes, which is stored with the
+// snapshots. Overloaded for states which track such a phase.
+template <class state_t>
+complex_t get_snapshot_phase(const state_t &) {
+  return 1.;
+}
+template <class state_t>
+void set_snapshot_phase(state_t &, const complex_t) {}
+
+// Apply ops using the prefix cache of the amplitude type of the state
+template <class state_t>
+void apply_ops_with_prefix_cache(
+    state_t &state, std::vector<Operations::Op>::const_iterator first,
+    std::vector<Operations::Op>::const_iterator last, double global_phase,
+    ExperimentResult &result, RngEngine &rng, bool final_ops,
+    uint_t max_memory_mb) {
+  using value_t = typename std::remove_cv<typename std::remove_pointer<
+      typename std::decay<decltype(state.qreg().data())>::type>::type>::type;
+  PrefixCache<value_t>::instance().apply_ops(state, first, last, global_phase,
+                                             result, rng, final_ops,
+                                             max_memory_mb);
+}
+
+//============================================================================
+// Implementation
+//============================================================================
+
+template <typename value_t>
+bool PrefixCache<value_t>::cacheable(const Operations::Op &op) {
+  if (op.conditional)
+    return false;
+  switch (op.type) {
+  case Operations::OpType::gate:
+  case Operations::OpType::matrix:
+  case Operations::OpType::diagonal_matrix:
+  case Operations::OpType::multiplexer:
+  case Operations::OpType::barrier:
+  case Operations::OpType::nop:
+    return true;
+  default:
+    return false;
+  }
+}
+
+template <typename value_t>
+void PrefixCache<value_t>::get_structure(OpItr first, OpItr last,
+                                         uint_t num_qubits, reg_t &key) const {
+  key.clear();
+  key.push_back(num_qubits);
+  for (auto op = first; op != last; ++op) {
+    key.push_back(static_cast<uint_t>(op->type));
+    key.push_back(std::hash<std::string>()(op->name));
+    key.push_back(op->qubits.size());
+    key.insert(key.end(), op->qubits.begin(), op->qubits.end());
+    key.push_back(op->int_params.size());
+    key.insert(key.end(), op->int_params.begin(), op->int_params.end());
+    key.push_back(op->params.size());
+    key.push_back(op->mats.size());
+    for (const auto &mat : op->mats)
+      key.push_back(mat.size());
+  }
+}
+
+template <typename value_t>
+void PrefixCache<value_t>::get_values(OpItr first, OpItr last,
+                                      std::vector<complex_t> &values,
+                                      reg_t &offsets) const {
+  values.clear();
+  offsets.assign(1, 0);
+  for (auto op = first; op != last; ++op) {
+    values.insert(values.end(), op->params.begin(), op->params.end());
+    for (const auto &mat : op->mats)
+      values.insert(values.end(), mat.data(), mat.data() + mat.size());
+    offsets.push_back(values.size());
+  }
+}
+
+template <typename value_t>
+void PrefixCache<value_t>::set_positions(uint_t max_snapshots) {
+  reg_t param_ops;
+  for (uint_t i = 0; i + 1 < offsets_.size(); i++) {
+    if (offsets_[i + 1] > offsets_[i])
+      param_ops.push_back(i);
+  }
+  const uint_t num_params = param_ops.size();
+  const uint_t num_snapshots = std::min(max_snapshots, num_params);
+  positions_.resize(num_snapshots);
+  for (uint_t i = 0; i < num_snapshots; i++)
+    positions_[i] = param_ops[(i + 1) * num_params / (num_snapshots + 1)];
+  snapshots_.resize(num_snapshots);
+  snapshots_.shrink_to_fit();
+  phases_.resize(num_snapshots);
+  num_valid_ = 0;
+}
+
+template <typename value_t>
+template <class state_t>
+void PrefixCache<value_t>::apply_ops(state_t &state, OpItr first, OpItr last,
+                                     double global_phase,
+                                     ExperimentResult &result, RngEngine &rng,
+                                     bool final_ops, uint_t max_memory_mb) {
+  // A gradient reverses all the ops before it, which must be applied in a
+  // single pass
+  const bool gradient =
+      std::any_of(first, last, [](const Operations::Op &op) {
+        return op.type == Operations::OpType::save_energy_gradient;
+      });
+  std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+  if (gradient || !lock.try_lock()) {
+    state.apply_ops(first, last, result, rng, final_ops);
+    return;
+  }
+
+  auto &qreg = state.qreg();
+  const uint_t state_bytes = qreg.size() * sizeof(value_t);
+
+  // Only the leading unitary part of the circuit is cached
+  OpItr stop = first;
+  while (stop != last && cacheable(*stop))
+    ++stop;
+
+  reg_t key;
+  get_structure(first, stop, qreg.num_qubits(), key);
+  std::vector<complex_t> values;
+  reg_t offsets;
+  get_values(first, stop, values, offsets);
+
+  // Find the first operation whose parameters changed since the last run
+  uint_t first_changed = 0;
+  if (key != key_ || max_memory_mb != max_memory_mb_) {
+    key_ = key;
+    offsets_ = offsets;
+    max_memory_mb_ = max_memory_mb;
+    set_positions((max_memory_mb << 20) / state_bytes);
+    lookups_ = 0;
+    hits_ = 0;
+    total_bytes_saved_ = 0;
+  } else if (std::memcmp(&global_phase, &global_phase_, sizeof(double)) == 0) {
+    // The snapshots were taken with exactly this phase, so its bits are
+    // compared as part of the key
+    const auto diff =
+        std::mismatch(values.begin(), values.end(), values_.begin());
+    if (diff.first == values.end()) {
+      first_changed = stop - first;
+    } else {
+      const uint_t index = diff.first - values.begin();
+      first_changed =
+          std::upper_bound(offsets_.begin(), offsets_.end(), index) -
+          offsets_.begin() - 1;
+    }
+  }
+  global_phase_ = global_phase;
+  values_ = std::move(values);
+
+  // Snapshots before first_changed stay valid
+  uint_t resume = 0;
+  while (resume < num_valid_ && positions_[resume] <= first_changed)
+    resume++;
+  num_valid_ = resume;
+
+  lookups_++;
+  uint_t begin = 0;
+  if (resume > 0) {
+    hits_++;
+    begin = positions_[resume - 1];
+    const auto &snapshot = snapshots_[resume - 1];
+    qreg.initialize_from_data(snapshot.data(), snapshot.size());
+    set_snapshot_phase(state, phases_[resume - 1]);
+  }
+  const uint_t bytes_saved = begin * state_bytes;
+  total_bytes_saved_ += bytes_saved;
+
+  // Apply the remaining operations taking the deeper snapshots on the way
+  for (uint_t i = resume; i < positions_.size(); i++) {
+    if (positions_[i] > begin)
+      state.apply_ops(first + begin, first + positions_[i], result, rng, false);
+    begin = positions_[i];
+    snapshots_[i].assign(qreg.data(), qreg.data() + qreg.size());
+    phases_[i] = get_snapshot_phase(state);
+    num_valid_ = i + 1;
+  }
+  state.apply_ops(first + begin, last, result, rng, final_ops);
+
+  result.metadata.add(true, "prefix_cache", "enabled");
+  result.metadata.add(resume > 0, "prefix_cache", "hit");
+  result.metadata.add(positions_.size(), "prefix_cache", "snapshots");
+  result.metadata.add(positions_.size() * state_bytes, "prefix_cache",
+                      "memory_bytes");
+  result.metadata.add(bytes_saved, "prefix_cache", "bytes_saved");
+  result.metadata.add(total_bytes_saved_, "prefix_cache",
+                      "total_bytes_saved");
+  result.metadata.add((double)hits_ / lookups_, "prefix_cache", "hit_rate");
+}
+
+//------------------------------------------------------------------------------
+} // end namespace Statevector
+} // end namespace AER
+//------------------------------------------------------------------------------
+#endif // end module
@@ -21,6 +21,7 @@
 #include <complex>
 #include <cstdint>
 #include <iostream>
+#include <numeric>
 #include <spdlog/spdlog.h>
 #include <sstream>
 #include <stdexcept>
@@ -423,6 +424,37 @@ public:
                             const std::string &pauli, bool variance,
                             std::complex<double> param, bool last,
                             const complex_t initial_phase = 1.0) const;
+
+  // Return the expectation values of a list of N-qubit Pauli matrices
+  std::vector<double>
+  expval_paulis(const reg_t &qubits,
+                const std::vector<std::string> &paulis) const {
+    std::vector<double> vals;
+    vals.reserve(paulis.size());
+    for (const auto &pauli : paulis)
+      vals.push_back(expval_pauli(qubits, pauli));
+    return vals;
+  } //SW
+
+  // Return the expectation values of Paulis given by their X and Z masks
+  std::vector<double> expval_pauli_masks(const reg_t &x_masks,
+                                         const reg_t &z_masks) const {
+    reg_t qubits(num_qubits_);
+    std::iota(qubits.begin(), qubits.end(), 0);
+    std::vector<std::string> paulis;
+    paulis.reserve(x_masks.size());
+    for (uint_t i = 0; i < x_masks.size(); ++i) {
+      std::string pauli(num_qubits_, 'I');
+      for (uint_t q = 0; q < num_qubits_; ++q) {
+        const bool x = (x_masks[i] >> q) & 1;
+        const bool z = (z_masks[i] >> q) & 1;
+        if (x || z)
+          pauli[num_qubits_ - 1 - q] = x ? (z ? 'Y' : 'X') : 'Z';
+      }
+      paulis.push_back(pauli);
+    }
+    return expval_paulis(qubits, paulis);
+  } //SW
   //-----------------------------------------------------------------------
   // JSON configuration settings
   //-----------------------------------------------------------------------
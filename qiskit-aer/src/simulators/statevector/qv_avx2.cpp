@@ -16,6 +16,9 @@
 #include <cstdint>
 #include <cstring>
 #include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 #include <type_traits>
 #include <utility>
 
@@ -451,6 +454,81 @@ inline void reorder(const uint64_t *qreg_orig, uint64_t *qreg, FloatType *mat) {
   }
 }
 
+static m256_t<double> _mm256_add(const m256_t<double> &left,
+                                 const m256_t<double> &right) {
+  return _mm256_add_pd(left, right);
+}
+
+static m256_t<float> _mm256_add(const m256_t<float> &left,
+                                const m256_t<float> &right) {
+  return _mm256_add_ps(left, right);
+}
+
+static m256_t<double> _mm256_fmaddsub(const m256_t<double> &left,
+                                      const m256_t<double> &right,
+                                      const m256_t<double> &ret) {
+  return _mm256_fmaddsub_pd(left, right, ret);
+}
+
+static m256_t<float> _mm256_fmaddsub(const m256_t<float> &left,
+                                     const m256_t<float> &right,
+                                     const m256_t<float> &ret) {
+  return _mm256_fmaddsub_ps(left, right, ret);
+}
+
+static auto _mm256_loadu(double const *d) { return _mm256_loadu_pd(d); }
+
+static auto _mm256_loadu(float const *f) { return _mm256_loadu_ps(f); }
+
+// Permute the complex numbers of a register, the permutation is given in
+// 32 bit words so that both precisions share the same cross-lane shuffle
+static m256_t<double> _mm256_permute_complex(const m256_t<double> &vec,
+                                             const __m256i &perm) {
+  return _mm256_castps_pd(
+      _mm256_permutevar8x32_ps(_mm256_castpd_ps(vec), perm));
+}
+
+static m256_t<float> _mm256_permute_complex(const m256_t<float> &vec,
+                                            const __m256i &perm) {
+  return _mm256_permutevar8x32_ps(vec, perm);
+}
+
+// Multiply packed complex numbers by complex coefficients given as registers
+// with the real (resp. imaginary) part duplicated in both slots of a number
+template <typename FloatType>
+static inline m256_t<FloatType>
+_mm_complex_multiply_dup(const m256_t<FloatType> &vec,
+                         const m256_t<FloatType> &real,
+                         const m256_t<FloatType> &imag) {
+  m256_t<FloatType> swapped = vec;
+  swapped = _mm256_swith_real_and_imag(swapped);
+  return _mm256_fmaddsub(vec, real, _mm256_mul(swapped, imag));
+}
+
+inline uint64_t _popcount(const uint64_t mask) {
+#if defined(_MSC_VER)
+  return __popcnt64(mask);
+#else
+  return __builtin_popcountll(mask);
+#endif
+}
+
+// Run func(k) for k in [0, END). A serial run does not open a parallel
+// region, as the kernels are also called per cache block (MOSQ_BLOCK) where
+// the region setup would cost as much as the work.
+template <typename Lambda>
+inline void _parallel_for(const int64_t END, const size_t omp_threads,
+                          Lambda &&func) {
+  if (omp_threads > 1) {
+#pragma omp parallel for num_threads(omp_threads)
+    for (int64_t k = 0; k < END; k++)
+      func(k);
+    return;
+  }
+  for (int64_t k = 0; k < END; k++)
+    func(k);
+}
+
 } // End anonymous namespace
 
 namespace AER {
@@ -1221,5 +1299,158 @@ Avx apply_diagonal_matrix_avx<float>(float *qv_data_, const uint64_t data_size,
   return Avx::Applied;
 }
 
+
+template <typename FloatType>
+Avx apply_MOSQ_avx(FloatType *qv_data, const uint64_t data_size,
+                   const uint64_t z_mask, const FloatType *phases,
+                   const size_t omp_threads) {
+  // Complex numbers per register: 2 for double, 4 for float
+  constexpr uint64_t lanes = 16 / sizeof(FloatType);
+  if (data_size < lanes)
+    return Avx::NotApplied;
+
+  // The factor of lane j is phases[parity(base) ^ parity(j)], so one factor
+  // register per parity of the register base index covers every register
+  FloatType tmp[2][8];
+  m256_t<FloatType> factor_real[2], factor_imag[2];
+  for (uint64_t parity = 0; parity < 2; ++parity) {
+    for (uint64_t j = 0; j < lanes; ++j) {
+      const uint64_t odd = parity ^ (_popcount(j & z_mask) & 1);
+      for (uint64_t w = 0; w < 2; ++w) {
+        tmp[0][2 * j + w] = phases[2 * odd];
+        tmp[1][2 * j + w] = phases[2 * odd + 1];
+      }
+    }
+    factor_real[parity] = _mm256_loadu(tmp[0]);
+    factor_imag[parity] = _mm256_loadu(tmp[1]);
+  }
+
+  const uint64_t base_mask = z_mask & ~(lanes - 1);
+  const int64_t END = data_size / lanes;
+
+  _parallel_for(END, omp_threads, [&](const int64_t k) {
+    const uint64_t i = uint64_t(k) * lanes;
+    const uint64_t parity = _popcount(i & base_mask) & 1;
+    const m256_t<FloatType> vec = _mm256_load(&qv_data[i * 2]);
+    _mm256_store(&qv_data[i * 2],
+                 _mm_complex_multiply_dup<FloatType>(vec, factor_real[parity],
+                                                     factor_imag[parity]));
+  });
+  return Avx::Applied;
+} //SW
+
+template Avx apply_MOSQ_avx<double>(double *data, const uint64_t data_size,
+                                    const uint64_t z_mask,
+                                    const double *phases,
+                                    const size_t omp_threads);
+
+template Avx apply_MOSQ_avx<float>(float *data, const uint64_t data_size,
+                                   const uint64_t z_mask, const float *phases,
+                                   const size_t omp_threads);
+
+template <typename FloatType>
+Avx apply_MOSQ_CR_avx(FloatType *qv_data, const uint64_t data_size,
+                      const uint64_t xy_mask, const uint64_t y_mask,
+                      const uint64_t z_mask, const FloatType *coeffs,
+                      const size_t omp_threads) {
+  // Complex numbers per register: 2 for double, 4 for float
+  constexpr uint64_t lanes = 16 / sizeof(FloatType);
+  constexpr uint64_t words = 8 / lanes;
+
+  // A register must hold amplitudes of only one side of the pairs, so the
+  // highest X/Y bit has to be above the bits addressing the lanes
+  if (xy_mask < lanes || (data_size >> 1) < lanes)
+    return Avx::NotApplied;
+
+  uint64_t x_max = 63;
+  while (((xy_mask >> x_max) & 1) == 0)
+    --x_max;
+  const uint64_t mask_l = (1ULL << x_max) - 1;
+  const uint64_t mask_u = ~((1ULL << (x_max + 1)) - 1);
+  const uint64_t yz_mask = y_mask | z_mask;
+  const uint64_t xy_lanes = xy_mask & (lanes - 1);
+  const uint64_t xy_block = xy_mask ^ xy_lanes;
+  const uint64_t num_y = _popcount(y_mask);
+
+  // Lane j of a register pairs with lane j ^ xy_lanes of its partner register.
+  // The permutation is an involution, so it also writes the partner back.
+  int perm[8];
+  for (uint64_t w = 0; w < 8; ++w)
+    perm[w] = int(((w / words) ^ xy_lanes) * words + w % words);
+  const __m256i vperm = _mm256_setr_epi32(perm[0], perm[1], perm[2], perm[3],
+                                          perm[4], perm[5], perm[6], perm[7]);
+
+  // Coefficients are {diag, upper[4], lower[4]} indexed by the phase
+  // selector of a pair. The selector of lane j only depends on the Y/Z parity
+  // of the register base index and of j, so two coefficient sets suffice.
+  FloatType tmp[4][8];
+  for (uint64_t j = 0; j < lanes; ++j) {
+    for (uint64_t w = 0; w < 2; ++w) {
+      tmp[0][2 * j + w] = coeffs[0];
+      tmp[1][2 * j + w] = coeffs[1];
+    }
+  }
+  const m256_t<FloatType> diag_real = _mm256_loadu(tmp[0]);
+  const m256_t<FloatType> diag_imag = _mm256_loadu(tmp[1]);
+
+  m256_t<FloatType> upper_real[2], upper_imag[2], lower_real[2], lower_imag[2];
+  for (uint64_t parity = 0; parity < 2; ++parity) {
+    for (uint64_t j = 0; j < lanes; ++j) {
+      const uint64_t odd = parity ^ (_popcount(j & yz_mask) & 1);
+      const uint64_t sel = (num_y + (odd << 1)) & 3;
+      for (uint64_t w = 0; w < 2; ++w) {
+        tmp[0][2 * j + w] = coeffs[2 + 2 * sel];
+        tmp[1][2 * j + w] = coeffs[3 + 2 * sel];
+        tmp[2][2 * j + w] = coeffs[10 + 2 * sel];
+        tmp[3][2 * j + w] = coeffs[11 + 2 * sel];
+      }
+    }
+    upper_real[parity] = _mm256_loadu(tmp[0]);
+    upper_imag[parity] = _mm256_loadu(tmp[1]);
+    lower_real[parity] = _mm256_loadu(tmp[2]);
+    lower_imag[parity] = _mm256_loadu(tmp[3]);
+  }
+
+  const int64_t END = (data_size >> 1) / lanes;
+
+  _parallel_for(END, omp_threads, [&](const int64_t k) {
+    const uint64_t pair = uint64_t(k) * lanes;
+    const uint64_t i0 = ((pair << 1) & mask_u) | (pair & mask_l);
+    const uint64_t i1 = i0 ^ xy_block;
+    const uint64_t parity = _popcount(i0 & yz_mask) & 1;
+
+    const m256_t<FloatType> vec0 = _mm256_load(&qv_data[i0 * 2]);
+    const m256_t<FloatType> vec1 =
+        _mm256_permute_complex(_mm256_load(&qv_data[i1 * 2]), vperm);
+
+    const m256_t<FloatType> ret0 = _mm256_add(
+        _mm_complex_multiply_dup<FloatType>(vec0, diag_real, diag_imag),
+        _mm_complex_multiply_dup<FloatType>(vec1, upper_real[parity],
+                                            upper_imag[parity]));
+    const m256_t<FloatType> ret1 = _mm256_add(
+        _mm_complex_multiply_dup<FloatType>(vec0, lower_real[parity],
+                                            lower_imag[parity]),
+        _mm_complex_multiply_dup<FloatType>(vec1, diag_real, diag_imag));
+
+    _mm256_store(&qv_data[i0 * 2], ret0);
+    _mm256_store(&qv_data[i1 * 2], _mm256_permute_complex(ret1, vperm));
+  });
+  return Avx::Applied;
+} //SW
+
+template Avx apply_MOSQ_CR_avx<double>(double *data, const uint64_t data_size,
+                                       const uint64_t xy_mask,
+                                       const uint64_t y_mask,
+                                       const uint64_t z_mask,
+                                       const double *coeffs,
+                                       const size_t omp_threads);
+
+template Avx apply_MOSQ_CR_avx<float>(float *data, const uint64_t data_size,
+                                      const uint64_t xy_mask,
+                                      const uint64_t y_mask,
+                                      const uint64_t z_mask,
+                                      const float *coeffs,
+                                      const size_t omp_threads);
+
 } /* End namespace QV */
 } /* End namespace AER */
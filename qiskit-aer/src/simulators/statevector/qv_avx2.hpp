@@ -33,6 +33,22 @@ Avx apply_diagonal_matrix_avx(FloatType *data, const uint64_t data_size,
                               const uint64_t *qregs, const size_t qregs_size,
                               const FloatType *vec, const size_t omp_threads);
 
+// Apply a diagonal Pauli Z-string rotation (MOSQ): every amplitude is
+// multiplied by the complex phases[parity] of its parity over z_mask.
+template <typename FloatType>
+Avx apply_MOSQ_avx(FloatType *data, const uint64_t data_size,
+                   const uint64_t z_mask, const FloatType *phases,
+                   const size_t omp_threads); //SW
+
+// Apply a Pauli rotation (MOSQ_CR) to all amplitude pairs connected by
+// xy_mask. coeffs holds the complex pair matrix entries
+// {diag, upper[4], lower[4]} indexed by the phase selector of a pair.
+template <typename FloatType>
+Avx apply_MOSQ_CR_avx(FloatType *data, const uint64_t data_size,
+                      const uint64_t xy_mask, const uint64_t y_mask,
+                      const uint64_t z_mask, const FloatType *coeffs,
+                      const size_t omp_threads); //SW
+
 } // end namespace QV
 } // end namespace AER
 #endif
@@ -0,0 +1,328 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _qv_real_qubit_vector_hpp_
+#define _qv_real_qubit_vector_hpp_
+
+#include <algorithm>
+#include <array>
+#include <complex>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "framework/linalg/vector.hpp"
+#include "framework/types.hpp"
+#include "simulators/statevector/indexes.hpp"
+
+namespace AER {
+namespace QV {
+
+//SW
+//============================================================================
+// RealQubitVector class
+//============================================================================
+
+// Statevector with real amplitudes. Circuits of real gates on a real initial
+// state, such as UCCSD ansatze whose excitation rotations (Pauli strings with
+// an odd number of Y) are real orthogonal matrices, never leave the real
+// subspace, so half of the memory and bandwidth of a complex statevector is
+// spent on zeros. Gates that are real up to a global phase are applied as
+// their real part; the global phase is kept by the owner of the vector.
+
+template <typename data_t = double>
+class RealQubitVector {
+public:
+  RealQubitVector() = default;
+  RealQubitVector(const RealQubitVector &obj) = delete;
+  RealQubitVector &operator=(const RealQubitVector &obj) = delete;
+
+  //-----------------------------------------------------------------------
+  // Utility functions
+  //-----------------------------------------------------------------------
+
+  void set_num_qubits(uint_t num_qubits);
+  uint_t num_qubits() const { return num_qubits_; }
+  uint_t size() const { return data_.size(); }
+  data_t *data() const { return const_cast<data_t *>(data_.data()); }
+
+  // Initialize to |0...0>
+  void initialize();
+
+  // Initialize from a copy of num_states amplitudes
+  void initialize_from_data(const data_t *data, const size_t num_states);
+
+  //-----------------------------------------------------------------------
+  // Operations
+  //-----------------------------------------------------------------------
+
+  // Apply a real single-qubit matrix in column-major order
+  void apply_matrix(uint_t qubit, const std::array<double, 4> &mat);
+
+  void apply_x(uint_t qubit);
+  void apply_cnot(uint_t control, uint_t target);
+  void apply_cz(uint_t control, uint_t target);
+  void apply_swap(uint_t qubit0, uint_t qubit1);
+
+  // Negate the amplitudes with odd parity on z_mask
+  void apply_parity_sign(uint_t z_mask);
+
+  // Apply the real part e^{-i theta/2} MOSQ_CR(theta) = exp(-i theta/2 P) of
+  // a rotation whose Pauli string has an odd number of Y qubits
+  void apply_rotation(double theta, uint_t x_mask, uint_t y_mask,
+                      uint_t z_mask);
+
+  //-----------------------------------------------------------------------
+  // Measurement
+  //-----------------------------------------------------------------------
+
+  double norm() const;
+
+  // Expectation values of Paulis given by their X and Z masks, where a bit
+  // set in both masks is a Y. Paulis are evaluated together per X mask.
+  std::vector<double> expval_pauli_masks(const reg_t &x_masks,
+                                         const reg_t &z_masks) const;
+
+  // Return the complex statevector phase * |data>
+  AER::Vector<std::complex<data_t>>
+  copy_to_vector(std::complex<double> phase = 1.) const;
+
+  //-----------------------------------------------------------------------
+  // OpenMP configuration settings
+  //-----------------------------------------------------------------------
+
+  void set_omp_threads(int n) {
+    if (n > 0)
+      omp_threads_ = n;
+  }
+  void set_omp_threshold(int n) {
+    if (n > 0)
+      omp_threshold_ = n;
+  }
+
+protected:
+  uint_t num_qubits_ = 0;
+  std::vector<data_t> data_;
+
+  uint_t omp_threads_ = 1;
+  uint_t omp_threshold_ = 14;
+
+  uint_t omp_threads_managed() const {
+    return (num_qubits_ > omp_threshold_ && omp_threads_ > 1) ? omp_threads_
+                                                              : 1;
+  }
+};
+
+//============================================================================
+// Implementation: Utility functions
+//============================================================================
+
+template <typename data_t>
+void RealQubitVector<data_t>::set_num_qubits(uint_t num_qubits) {
+  if (num_qubits > 63) {
+    throw std::invalid_argument(
+        "RealQubitVector: more than 63 qubits are not supported.");
+  }
+  // The buffer is kept when the number of qubits is unchanged
+  if (num_qubits == num_qubits_ && !data_.empty())
+    return;
+  num_qubits_ = num_qubits;
+  data_.clear();
+  data_.shrink_to_fit();
+}
+
+template <typename data_t>
+void RealQubitVector<data_t>::initialize() {
+  data_.assign(1ULL << num_qubits_, 0.);
+  data_[0] = 1.;
+}
+
+template <typename data_t>
+void RealQubitVector<data_t>::initialize_from_data(const data_t *data,
+                                                   const size_t num_states) {
+  if (data_.size() != num_states) {
+    throw std::runtime_error(
+        "RealQubitVector::initialize input vector is incorrect length (" +
+        std::to_string(data_.size()) + "!=" + std::to_string(num_states) +
+        ")");
+  }
+  std::copy(data, data + num_states, data_.begin());
+}
+
+//============================================================================
+// Implementation: Operations
+//============================================================================
+
+template <typename data_t>
+void RealQubitVector<data_t>::apply_matrix(uint_t qubit,
+                                           const std::array<double, 4> &mat) {
+  const data_t m00 = mat[0], m10 = mat[1], m01 = mat[2], m11 = mat[3];
+  data_t *data = data_.data();
+  auto func = [&](const areg_t<2> &inds) -> void {
+    const data_t u = data[inds[0]];
+    const data_t v = data[inds[1]];
+    data[inds[0]] = m00 * u + m01 * v;
+    data[inds[1]] = m10 * u + m11 * v;
+  };
+  apply_lambda(0, data_.size(), omp_threads_managed(), func,
+               areg_t<1>({{qubit}}));
+}
+
+template <typename data_t>
+void RealQubitVector<data_t>::apply_x(uint_t qubit) {
+  data_t *data = data_.data();
+  auto func = [&](const areg_t<2> &inds) -> void {
+    std::swap(data[inds[0]], data[inds[1]]);
+  };
+  apply_lambda(0, data_.size(), omp_threads_managed(), func,
+               areg_t<1>({{qubit}}));
+}
+
+template <typename data_t>
+void RealQubitVector<data_t>::apply_cnot(uint_t control, uint_t target) {
+  data_t *data = data_.data();
+  auto func = [&](const areg_t<4> &inds) -> void {
+    std::swap(data[inds[1]], data[inds[3]]);
+  };
+  apply_lambda(0, data_.size(), omp_threads_managed(), func,
+               areg_t<2>({{control, target}}));
+}
+
+template <typename data_t>
+void RealQubitVector<data_t>::apply_cz(uint_t control, uint_t target) {
+  data_t *data = data_.data();
+  auto func = [&](const areg_t<4> &inds) -> void { data[inds[3]] *= -1; };
+  apply_lambda(0, data_.size(), omp_threads_managed(), func,
+               areg_t<2>({{control, target}}));
+}
+
+template <typename data_t>
+void RealQubitVector<data_t>::apply_swap(uint_t qubit0, uint_t qubit1) {
+  data_t *data = data_.data();
+  auto func = [&](const areg_t<4> &inds) -> void {
+    std::swap(data[inds[1]], data[inds[2]]);
+  };
+  apply_lambda(0, data_.size(), omp_threads_managed(), func,
+               areg_t<2>({{qubit0, qubit1}}));
+}
+
+template <typename data_t>
+void RealQubitVector<data_t>::apply_parity_sign(uint_t z_mask) {
+  data_t *data = data_.data();
+  auto func = [&](const uint_t k, const uint_t parity) -> void {
+    if (parity)
+      data[k] = -data[k];
+  };
+  apply_lambda_MOSQ(0, data_.size(), omp_threads_managed(), func, z_mask);
+}
+
+template <typename data_t>
+void RealQubitVector<data_t>::apply_rotation(double theta, uint_t x_mask,
+                                             uint_t y_mask, uint_t z_mask) {
+  if (!(mask_weight(y_mask) & 1)) {
+    throw std::invalid_argument(
+        "RealQubitVector: rotations of Pauli strings with an even number of "
+        "Y qubits are not real.");
+  }
+  // With an odd number of Y the phase selector of the pair kernel is 1 or 3
+  // and the pair matrix is [[c, -s], [s, c]] or [[c, s], [-s, c]]
+  const data_t c = std::cos(theta / 2);
+  const data_t s = std::sin(theta / 2);
+  data_t *data = data_.data();
+  auto func = [&](const areg_t<2> &inds, const uint_t sel) -> void {
+    const data_t u = data[inds[0]];
+    const data_t v = data[inds[1]];
+    const data_t t = (sel == 1) ? s : -s;
+    data[inds[0]] = c * u - t * v;
+    data[inds[1]] = t * u + c * v;
+  };
+  apply_lambda_MOSQ_CR(0, data_.size(), omp_threads_managed(), func,
+                       x_mask | y_mask, y_mask, z_mask);
+}
+
+//============================================================================
+// Implementation: Measurement
+//============================================================================
+
+template <typename data_t>
+double RealQubitVector<data_t>::norm() const {
+  double val = 0.;
+  const int_t dim = data_.size();
+#pragma omp parallel for if (omp_threads_managed() > 1)                        \
+    num_threads(omp_threads_managed()) reduction(+ : val)
+  for (int_t k = 0; k < dim; ++k)
+    val += double(data_[k]) * data_[k];
+  return val;
+}
+
+template <typename data_t>
+std::vector<double>
+RealQubitVector<data_t>::expval_pauli_masks(const reg_t &x_masks,
+                                            const reg_t &z_masks) const {
+  std::vector<double> vals(x_masks.size(), 0.);
+  std::map<uint_t, std::vector<uint_t>> groups;
+  for (uint_t t = 0; t < x_masks.size(); ++t) {
+    // Paulis with an odd number of Y have zero expectation value on a real
+    // state
+    if (!(mask_weight(x_masks[t] & z_masks[t]) & 1))
+      groups[x_masks[t]].push_back(t);
+  }
+
+  // <P> = (-1)^(ny/2) sum_k data[k ^ x] data[k] (-1)^|k & z|
+  const int_t dim = data_.size();
+  for (const auto &group : groups) {
+    const uint_t x_mask = group.first;
+    const auto &terms = group.second;
+    const uint_t num_terms = terms.size();
+
+#pragma omp parallel if (omp_threads_managed() > 1)                            \
+    num_threads(omp_threads_managed())
+    {
+      std::vector<double> acc(num_terms, 0.);
+#pragma omp for
+      for (int_t k = 0; k < dim; ++k) {
+        const double val = double(data_[k ^ x_mask]) * data_[k];
+        for (uint_t t = 0; t < num_terms; ++t)
+          acc[t] += (mask_weight(k & z_masks[terms[t]]) & 1) ? -val : val;
+      }
+#pragma omp critical
+      for (uint_t t = 0; t < num_terms; ++t)
+        vals[terms[t]] += acc[t];
+    }
+    for (const auto t : terms)
+      if (mask_weight(x_mask & z_masks[t]) & 2)
+        vals[t] = -vals[t];
+  }
+  return vals;
+}
+
+template <typename data_t>
+AER::Vector<std::complex<data_t>>
+RealQubitVector<data_t>::copy_to_vector(std::complex<double> phase) const {
+  const int_t dim = data_.size();
+  AER::Vector<std::complex<data_t>> ret(dim, false);
+  const std::complex<data_t> p(phase);
+#pragma omp parallel for if (omp_threads_managed() > 1)                        \
+    num_threads(omp_threads_managed())
+  for (int_t k = 0; k < dim; ++k)
+    ret[k] = p * data_[k];
+  return ret;
+}
+
+//------------------------------------------------------------------------------
+} // end namespace QV
+} // end namespace AER
+//------------------------------------------------------------------------------
+#endif // end module
@@ -0,0 +1,74 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _real_statevector_executor_hpp_
+#define _real_statevector_executor_hpp_
+
+#include "simulators/circuit_executor.hpp"
+#include "simulators/statevector/prefix_cache.hpp"
+#include "simulators/statevector/real_statevector_state.hpp"
+
+namespace AER {
+namespace Statevector {
+
+//SW
+// The prefix cache keeps the phase of the real amplitudes with its snapshots
+template <class statevec_t>
+complex_t get_snapshot_phase(const RealState<statevec_t> &state) {
+  return state.phase();
+}
+template <class statevec_t>
+void set_snapshot_phase(RealState<statevec_t> &state, const complex_t phase) {
+  state.set_phase(phase);
+}
+
+//-------------------------------------------------------------------------
+// Executor for the real amplitude statevector
+//-------------------------------------------------------------------------
+// A single state executor which resumes runs from the prefix cache like the
+// complex statevector executor.
+template <class state_t>
+class RealExecutor : public CircuitExecutor::Executor<state_t> {
+  using Base = CircuitExecutor::Executor<state_t>;
+
+public:
+  RealExecutor() {}
+  virtual ~RealExecutor() {}
+
+protected:
+  // Memory budget of the prefix cache, 0 disables it
+  uint_t prefix_cache_max_memory_mb_ = 0;
+
+  void set_config(const Config &config) override {
+    Base::set_config(config);
+    prefix_cache_max_memory_mb_ = config.prefix_cache_max_memory_mb;
+  }
+
+  void apply_ops_before_sampling(state_t &state, CircuitExecutor::OpItr first,
+                                 CircuitExecutor::OpItr last,
+                                 double global_phase, ExperimentResult &result,
+                                 RngEngine &rng, bool final_ops) override {
+    if (prefix_cache_max_memory_mb_ > 0)
+      apply_ops_with_prefix_cache(state, first, last, global_phase, result,
+                                  rng, final_ops, prefix_cache_max_memory_mb_);
+    else
+      state.apply_ops(first, last, result, rng, final_ops);
+  }
+};
+
+//------------------------------------------------------------------------------
+} // end namespace Statevector
+} // end namespace AER
+//------------------------------------------------------------------------------
+#endif // end module
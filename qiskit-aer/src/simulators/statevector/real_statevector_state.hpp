@@ -0,0 +1,460 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _real_statevector_state_hpp
+#define _real_statevector_state_hpp
+
+#include <algorithm>
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <sstream>
+
+#include "framework/circuit.hpp"
+#include "framework/config.hpp"
+#include "framework/linalg/linalg.hpp"
+#include "framework/trace.hpp"
+#include "framework/utils.hpp"
+#include "real_qubitvector.hpp"
+#include "simulators/state.hpp"
+
+namespace AER {
+namespace Statevector {
+
+//SW
+// Statevector state with real amplitudes, used instead of the complex
+// statevector for circuits that are provably real (see is_real_circuit):
+// every gate is a real matrix up to a global phase, which is accumulated
+// separately and only applied when the statevector is saved.
+
+// OpSet of supported instructions
+const Operations::OpSet RealStateOpSet(
+    // Op types
+    {Operations::OpType::gate, Operations::OpType::barrier,
+     Operations::OpType::qerror_loc, Operations::OpType::save_expval,
+     Operations::OpType::save_expval_var,
+     Operations::OpType::save_hamiltonian_expval,
+     Operations::OpType::save_statevec, Operations::OpType::save_state},
+    // Gates
+    {"id", "delay", "x", "y", "z", "h", "ry", "rz", "p", "u1", "u3", "u", "U",
+     "r", "cx", "CX", "cz", "swap", "MOSQ", "MOSQ_CR"});
+
+// Tolerance for the imaginary part of a gate that is treated as real
+const double real_gate_threshold = 1e-12;
+
+// Column-major matrix of a single-qubit gate of RealStateOpSet, or an empty
+// vector for the other gates
+inline cvector_t real_state_single_qubit_matrix(const Operations::Op &op) {
+  if (op.name == "id" || op.name == "delay")
+    return Linalg::VMatrix::I;
+  if (op.name == "x")
+    return Linalg::VMatrix::X;
+  if (op.name == "y")
+    return Linalg::VMatrix::Y;
+  if (op.name == "z")
+    return Linalg::VMatrix::Z;
+  if (op.name == "h")
+    return Linalg::VMatrix::H;
+  if (op.name == "ry")
+    return Linalg::VMatrix::ry(op.params[0]);
+  if (op.name == "rz")
+    return Linalg::VMatrix::rz(op.params[0]);
+  if (op.name == "p" || op.name == "u1")
+    return Linalg::VMatrix::phase(op.params[0]);
+  if (op.name == "r")
+    return Linalg::VMatrix::r(op.params[0], op.params[1]);
+  if (op.name == "u3" || op.name == "u" || op.name == "U")
+    return Linalg::VMatrix::u3(op.params[0], op.params[1], op.params[2]);
+  return cvector_t();
+}
+
+// Split a matrix into a global phase and a real matrix. Returns false if the
+// matrix is not real up to a global phase.
+inline bool real_up_to_phase(const cvector_t &mat, complex_t &phase,
+                             std::vector<double> &real) {
+  phase = 1.;
+  for (const auto &val : mat) {
+    if (std::abs(val) > real_gate_threshold) {
+      phase = val / std::abs(val);
+      break;
+    }
+  }
+  real.resize(mat.size());
+  for (uint_t i = 0; i < mat.size(); ++i) {
+    const complex_t val = mat[i] / phase;
+    if (std::abs(std::imag(val)) > real_gate_threshold)
+      return false;
+    real[i] = std::real(val);
+  }
+  return true;
+}
+
+// True if the instruction maps real states to real states up to a global
+// phase
+inline bool is_real_op(const Operations::Op &op) {
+  if (!RealStateOpSet.contains(op.type) || op.conditional)
+    return false;
+  if (op.type != Operations::OpType::gate)
+    return true;
+  if (!RealStateOpSet.contains_gates(op.name))
+    return false;
+
+  complex_t phase;
+  std::vector<double> real;
+  if (op.name == "MOSQ_CR" || op.name == "MOSQ") {
+    // Pauli strings with an odd number of Y give real rotations; diagonal
+    // strings give the phases [1, e^{i theta}] on the parity
+    if (op.name == "MOSQ_CR" && (op.int_params[0] | op.int_params[1]))
+      return Utils::popcount(op.int_params[1]) & 1;
+    return real_up_to_phase(
+        {1., std::exp(complex_t(0., 1.) * std::real(op.params[0]))}, phase,
+        real);
+  }
+  const auto mat = real_state_single_qubit_matrix(op);
+  return mat.size() == 0 || real_up_to_phase(mat, phase, real);
+}
+
+// True if every instruction of the circuit keeps the real |0...0> state
+// real up to a global phase
+inline bool is_real_circuit(const Circuit &circ) {
+  for (const auto &op : circ.ops) {
+    if (op.has_bind_params) {
+      for (uint_t i = 0; i < circ.num_bind_params; ++i)
+        if (!is_real_op(
+                Operations::bind_parameter(op, i, circ.num_bind_params)))
+          return false;
+    } else if (!is_real_op(op)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//=========================================================================
+// RealState subclass
+//=========================================================================
+
+template <class statevec_t = QV::RealQubitVector<double>>
+class RealState : public QuantumState::State<statevec_t> {
+public:
+  using BaseState = QuantumState::State<statevec_t>;
+
+  RealState() : BaseState(RealStateOpSet) {}
+  virtual ~RealState() = default;
+
+  //-----------------------------------------------------------------------
+  // Base class overrides
+  //-----------------------------------------------------------------------
+
+  // Return the string name of the State class
+  virtual std::string name() const override { return "statevector"; }
+
+  // Apply an operation
+  // If the op is not in allowed_ops an exeption will be raised.
+  virtual void apply_op(const Operations::Op &op, ExperimentResult &result,
+                        RngEngine &rng, bool final_op = false) override;
+
+  // Initializes an n-qubit state to the all |0> state
+  virtual void initialize_qreg(uint_t num_qubits) override;
+
+  // Returns the required memory for storing an n-qubit state in megabytes.
+  virtual size_t
+  required_memory_mb(uint_t num_qubits,
+                     const std::vector<Operations::Op> &ops) const override;
+
+  // Config: {"statevector_parallel_threshold": 14}
+  virtual void set_config(const Config &config) override;
+
+  virtual void apply_global_phase() override;
+
+  // Add the op profile if compiled with AER_PROFILING
+  virtual void add_metadata(ExperimentResult &result) const override {
+    result.metadata.add(true, "real_amplitudes");
+    BaseState::profile_.add_metadata(result);
+  }
+
+  // Return the expectation value of a N-qubit Pauli operator
+  virtual double expval_pauli(const reg_t &qubits,
+                              const std::string &pauli) override;
+
+  virtual std::vector<double> expval_pauli_masks(const reg_t &qubits,
+                                                 const reg_t &x_masks,
+                                                 const reg_t &z_masks) override;
+
+  // Phase multiplying the real amplitudes
+  complex_t phase() const { return phase_; }
+  void set_phase(const complex_t phase) { phase_ = phase; }
+
+protected:
+  void apply_gate(const Operations::Op &op);
+
+  // Profiling kind of a gate
+  static Profiling::Kind profile_kind(const std::string &name);
+
+  // Estimated bytes read and written by passes over the statevector
+  uint_t statevector_bytes(const uint_t passes) const {
+    return passes * BaseState::qreg_.size() *
+           sizeof(*BaseState::qreg_.data());
+  }
+
+  // Members of the args object of the trace span of an op
+  std::string trace_args(const Operations::Op &op) const;
+
+  void apply_save_statevector(const Operations::Op &op,
+                              ExperimentResult &result);
+
+  // Global phase of the state, which is phase_ times the real qreg_
+  complex_t phase_ = 1.;
+
+  int omp_qubit_threshold_ = 14;
+};
+
+//============================================================================
+// Implementation: Base class method overrides
+//============================================================================
+
+template <class statevec_t>
+void RealState<statevec_t>::apply_op(const Operations::Op &op,
+                                     ExperimentResult &result, RngEngine &rng,
+                                     bool final_op) {
+  Tracing::Span span("op");
+  if (span) {
+    span.set_name(op.name);
+    span.set_args(trace_args(op));
+  }
+  switch (op.type) {
+  case Operations::OpType::barrier:
+  case Operations::OpType::qerror_loc:
+    break;
+  case Operations::OpType::gate: {
+    Profiling::Timer timer(BaseState::profile_, profile_kind(op.name),
+                           op.qubits.size(), statevector_bytes(2));
+    apply_gate(op);
+  } break;
+  case Operations::OpType::save_expval:
+  case Operations::OpType::save_expval_var: {
+    Profiling::Timer timer(BaseState::profile_, Profiling::Kind::expval,
+                           op.qubits.size(),
+                           op.expval_params.size() * statevector_bytes(1));
+    BaseState::apply_save_expval(op, result);
+  } break;
+  case Operations::OpType::save_hamiltonian_expval: {
+    Profiling::Timer timer(BaseState::profile_,
+                           Profiling::Kind::hamiltonian_expval,
+                           op.qubits.size(), statevector_bytes(1));
+    BaseState::apply_save_hamiltonian_expval(op, result);
+  } break;
+  case Operations::OpType::save_state:
+  case Operations::OpType::save_statevec:
+    apply_save_statevector(op, result);
+    break;
+  default:
+    throw std::invalid_argument(
+        "Statevector::RealState::invalid instruction \'" + op.name + "\'.");
+  }
+}
+
+template <class statevec_t>
+void RealState<statevec_t>::initialize_qreg(uint_t num_qubits) {
+  BaseState::qreg_.set_omp_threshold(omp_qubit_threshold_);
+  if (BaseState::threads_ > 0)
+    BaseState::qreg_.set_omp_threads(BaseState::threads_);
+  BaseState::qreg_.set_num_qubits(num_qubits);
+  BaseState::qreg_.initialize();
+  phase_ = 1.;
+  apply_global_phase();
+}
+
+template <class statevec_t>
+size_t RealState<statevec_t>::required_memory_mb(
+    uint_t num_qubits, const std::vector<Operations::Op> &ops) const {
+  (void)ops; // avoid unused variable compiler warning
+  // 2^n real amplitudes of 8 (or 4) bytes
+  const int_t shift_mb = std::max<int_t>(0, num_qubits + 3 - 20);
+  return 1ULL << shift_mb;
+}
+
+template <class statevec_t>
+void RealState<statevec_t>::set_config(const Config &config) {
+  BaseState::set_config(config);
+  omp_qubit_threshold_ = config.statevector_parallel_threshold;
+}
+
+template <class statevec_t>
+void RealState<statevec_t>::apply_global_phase() {
+  if (BaseState::has_global_phase_)
+    phase_ *= BaseState::global_phase_;
+}
+
+//============================================================================
+// Implementation: Profiling
+//============================================================================
+
+template <class statevec_t>
+Profiling::Kind RealState<statevec_t>::profile_kind(const std::string &name) {
+  if (name == "cx" || name == "CX")
+    return Profiling::Kind::cx;
+  if (name == "rz")
+    return Profiling::Kind::rz;
+  if (name == "h")
+    return Profiling::Kind::h;
+  if (name == "MOSQ")
+    return Profiling::Kind::mosq;
+  if (name == "MOSQ_CR")
+    return Profiling::Kind::mosq_cr;
+  return Profiling::Kind::gate;
+}
+
+template <class statevec_t>
+std::string
+RealState<statevec_t>::trace_args(const Operations::Op &op) const {
+  std::ostringstream args;
+  args << "\"qubits\":[";
+  for (uint_t i = 0; i < op.qubits.size(); ++i)
+    args << (i > 0 ? "," : "") << op.qubits[i];
+  args << "]";
+  if (op.name == "MOSQ_CR" && op.int_params.size() == 3)
+    args << ",\"mask_weight\":"
+         << Utils::popcount(op.int_params[0] | op.int_params[1] |
+                            op.int_params[2]);
+  // Threads of the kernels, which run serially below the OpenMP threshold
+  const bool parallel =
+      BaseState::qreg_.num_qubits() > (uint_t)omp_qubit_threshold_ &&
+      BaseState::threads_ > 1;
+  args << ",\"threads\":" << (parallel ? BaseState::threads_ : 1);
+  return args.str();
+}
+
+//============================================================================
+// Implementation: Gates
+//============================================================================
+
+template <class statevec_t>
+void RealState<statevec_t>::apply_gate(const Operations::Op &op) {
+  if (op.name == "cx" || op.name == "CX") {
+    BaseState::qreg_.apply_cnot(op.qubits[0], op.qubits[1]);
+    return;
+  }
+  if (op.name == "cz") {
+    BaseState::qreg_.apply_cz(op.qubits[0], op.qubits[1]);
+    return;
+  }
+  if (op.name == "swap") {
+    BaseState::qreg_.apply_swap(op.qubits[0], op.qubits[1]);
+    return;
+  }
+
+  const std::string err =
+      "Statevector::RealState: gate \'" + op.name + "\' is not real.";
+  complex_t phase;
+  std::vector<double> real;
+
+  if (op.name == "MOSQ_CR" && (op.int_params[0] | op.int_params[1])) {
+    // MOSQ_CR(theta) = e^{i theta/2} exp(-i theta/2 P)
+    if (!(Utils::popcount(op.int_params[1]) & 1))
+      throw std::invalid_argument(err);
+    const double theta = std::real(op.params[0]);
+    BaseState::qreg_.apply_rotation(theta, op.int_params[0], op.int_params[1],
+                                    op.int_params[2]);
+    phase_ *= std::exp(complex_t(0., theta / 2));
+    return;
+  }
+  if (op.name == "MOSQ_CR" || op.name == "MOSQ") {
+    // Phases [1, e^{i theta}] on the parity of the Z qubits
+    if (!real_up_to_phase(
+            {1., std::exp(complex_t(0., 1.) * std::real(op.params[0]))}, phase,
+            real))
+      throw std::invalid_argument(err);
+    uint_t z_mask = 0;
+    if (op.name == "MOSQ_CR") {
+      z_mask = op.int_params[2];
+    } else {
+      for (const auto q : op.qubits)
+        z_mask ^= (1ULL << q);
+    }
+    if (real[1] < 0)
+      BaseState::qreg_.apply_parity_sign(z_mask);
+    return;
+  }
+
+  const auto mat = real_state_single_qubit_matrix(op);
+  if (mat.size() == 0 || !real_up_to_phase(mat, phase, real))
+    throw std::invalid_argument(err);
+  if (op.name == "x") {
+    BaseState::qreg_.apply_x(op.qubits[0]);
+  } else if (op.name != "id" && op.name != "delay") {
+    BaseState::qreg_.apply_matrix(op.qubits[0],
+                                  {real[0], real[1], real[2], real[3]});
+  }
+  phase_ *= phase;
+}
+
+//============================================================================
+// Implementation: Save data
+//============================================================================
+
+template <class statevec_t>
+void RealState<statevec_t>::apply_save_statevector(const Operations::Op &op,
+                                                   ExperimentResult &result) {
+  if (op.qubits.size() != BaseState::qreg_.num_qubits()) {
+    throw std::invalid_argument(op.name +
+                                " was not applied to all qubits."
+                                " Only the full statevector can be saved.");
+  }
+  std::string key =
+      (op.string_params[0] == "_method_") ? "statevector" : op.string_params[0];
+  result.save_data_pershot(BaseState::creg(), key,
+                           BaseState::qreg_.copy_to_vector(phase_),
+                           Operations::OpType::save_statevec, op.save_type);
+}
+
+template <class statevec_t>
+double RealState<statevec_t>::expval_pauli(const reg_t &qubits,
+                                           const std::string &pauli) {
+  uint_t x_mask = 0, z_mask = 0;
+  // Pauli labels are little-endian in the qubits
+  for (uint_t j = 0; j < pauli.size(); ++j) {
+    const char c = pauli[pauli.size() - 1 - j];
+    if (c == 'X' || c == 'Y')
+      x_mask |= (1ULL << j);
+    if (c == 'Z' || c == 'Y')
+      z_mask |= (1ULL << j);
+  }
+  return expval_pauli_masks(qubits, reg_t({x_mask}), reg_t({z_mask}))[0];
+}
+
+template <class statevec_t>
+std::vector<double>
+RealState<statevec_t>::expval_pauli_masks(const reg_t &qubits,
+                                          const reg_t &x_masks,
+                                          const reg_t &z_masks) {
+  auto relabel = [&qubits](uint_t mask) {
+    uint_t ret = 0;
+    for (uint_t j = 0; mask; ++j, mask >>= 1)
+      if (mask & 1)
+        ret |= (1ULL << qubits[j]);
+    return ret;
+  };
+  reg_t x_abs(x_masks.size()), z_abs(z_masks.size());
+  for (uint_t i = 0; i < x_masks.size(); ++i) {
+    x_abs[i] = relabel(x_masks[i]);
+    z_abs[i] = relabel(z_masks[i]);
+  }
+  return BaseState::qreg_.expval_pauli_masks(x_abs, z_abs);
+}
+
+//------------------------------------------------------------------------------
+} // end namespace Statevector
+} // end namespace AER
+//------------------------------------------------------------------------------
+#endif
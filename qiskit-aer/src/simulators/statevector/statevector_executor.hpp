@@ -17,6 +17,9 @@
 
 #include "simulators/batch_shots_executor.hpp"
 #include "simulators/parallel_state_executor.hpp"
+#include "simulators/statevector/prefix_cache.hpp"
+#include "transpile/mosq_block.hpp"
+#include "transpile/mosq_rewrite.hpp"
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -31,6 +34,7 @@ namespace AER {
 namespace Statevector {
 
 using ResultItr = std::vector<ExperimentResult>::iterator;
+using OpItr = std::vector<Operations::Op>::const_iterator;
 
 //-------------------------------------------------------------------------
 // Executor for statevector
@@ -49,6 +53,9 @@ public:
   virtual ~Executor() {}
 
 protected:
+  // Memory budget of the prefix cache, 0 disables it //SW
+  uint_t prefix_cache_max_memory_mb_ = 0;
+
   void set_config(const Config &config) override;
 
   bool shot_branching_supported(void) override { return true; }
@@ -81,6 +88,16 @@ protected:
                          const Config &config, RngEngine &init_rng,
                          ResultItr result_it, bool sample_noise) override;
 
+  // Resume from the prefix cache when it is enabled //SW
+  void apply_ops_before_sampling(state_t &state, OpItr first, OpItr last,
+                                 double global_phase, ExperimentResult &result,
+                                 RngEngine &rng, bool final_ops) override;
+
+  // Rewrite Pauli rotations into MOSQ_CR operations and merge runs of them
+  // into MOSQ_BLOCK operations
+  void transpile_mosq(Circuit &circ, const Config &config,
+                            ResultItr result_it) const; //SW
+
   bool allocate_states(uint_t num_states, const Config &config) override {
     return BasePar::allocate_states(num_states, config);
   }
@@ -211,6 +228,7 @@ template <class state_t>
 void Executor<state_t>::set_config(const Config &config) {
   BasePar::set_config(config);
   BaseBatch::set_config(config);
+  prefix_cache_max_memory_mb_ = config.prefix_cache_max_memory_mb; //SW
 }
 
 template <class state_t>
@@ -223,6 +241,7 @@ void Executor<state_t>::run_circuit_with_sampling(Circuit &circ,
     return BasePar::run_circuit_with_sampling(circ, config, init_rng,
                                               result_it);
   } else {
+    transpile_mosq(circ, config, result_it);
     return BaseBatch::run_circuit_with_sampling(circ, config, init_rng,
                                                 result_it);
   }
@@ -236,11 +255,44 @@ void Executor<state_t>::run_circuit_shots(
     return BasePar::run_circuit_shots(circ, noise, config, init_rng, result_it,
                                       sample_noise);
   } else {
+    if (!sample_noise)
+      transpile_mosq(circ, config, result_it);
     return BaseBatch::run_circuit_shots(circ, noise, config, init_rng,
                                         result_it, sample_noise);
   }
 }
 
+template <class state_t>
+void Executor<state_t>::apply_ops_before_sampling(
+    state_t &state, OpItr first, OpItr last, double global_phase,
+    ExperimentResult &result, RngEngine &rng, bool final_ops) {
+  if (prefix_cache_max_memory_mb_ > 0 && Base::sim_device_ == Device::CPU)
+    apply_ops_with_prefix_cache(state, first, last, global_phase, result, rng,
+                                final_ops, prefix_cache_max_memory_mb_);
+  else
+    state.apply_ops(first, last, result, rng, final_ops);
+} //SW
+
+template <class state_t>
+void Executor<state_t>::transpile_mosq(Circuit &circ, const Config &config,
+                                       ResultItr result_it) const {
+  Noise::NoiseModel dummy_noise;
+  state_t dummy_state;
+  ExperimentResult mosq_result;
+  Transpile::MOSQRewriting mosq_rewrite_pass;
+  mosq_rewrite_pass.set_config(config);
+  mosq_rewrite_pass.optimize_circuit(circ, dummy_noise, dummy_state.opset(),
+                                     mosq_result);
+  Transpile::MOSQBlocking mosq_block_pass;
+  mosq_block_pass.set_config(config);
+  mosq_block_pass.optimize_circuit(circ, dummy_noise, dummy_state.opset(),
+                                   mosq_result);
+  for (uint_t i = 0; i < circ.num_bind_params; i++) {
+    ExperimentResult &result = *(result_it + i);
+    result.metadata.copy(mosq_result.metadata);
+  }
+} //SW
+
 template <class state_t>
 bool Executor<state_t>::apply_parallel_op(const Operations::Op &op,
                                           ExperimentResult &result,
@@ -273,6 +325,9 @@ bool Executor<state_t>::apply_parallel_op(const Operations::Op &op,
     case Operations::OpType::save_expval_var:
       BasePar::apply_save_expval(op, result);
       break;
+    case Operations::OpType::save_hamiltonian_expval:
+      BasePar::apply_save_hamiltonian_expval(op, result);
+      break; //SW
     case Operations::OpType::save_densmat:
       apply_save_density_matrix(op, result);
       break;
@@ -408,6 +463,9 @@ bool Executor<state_t>::apply_branching_op(CircuitExecutor::Branch &root,
     case Operations::OpType::save_expval_var:
       Base::apply_save_expval(root, op, result);
       break;
+    case Operations::OpType::save_hamiltonian_expval:
+      Base::apply_save_hamiltonian_expval(root, op, result);
+      break; //SW
     case Operations::OpType::save_densmat:
       apply_save_density_matrix(root, op, result);
       break;
@@ -21,7 +21,9 @@
 
 #include "framework/config.hpp"
 #include "framework/json.hpp"
+#include "framework/trace.hpp"
 #include "framework/utils.hpp"
+#include "adjoint_gradient.hpp"
 #include "qubitvector.hpp"
 #include "simulators/chunk_utils.hpp"
 #include "simulators/state.hpp"
@@ -34,9 +36,6 @@ namespace AER {
 
 namespace Statevector {
 
-//SW: Timer type
-using myclock_t = std::chrono::high_resolution_clock;
-
 using OpType = Operations::OpType;
 
 // OpSet of supported instructions
@@ -58,6 +57,8 @@ const Operations::OpSet StateOpSet(
      OpType::set_statevec,
      OpType::save_expval,
      OpType::save_expval_var,
+     OpType::save_hamiltonian_expval,
+     OpType::save_energy_gradient,
      OpType::save_probs,
      OpType::save_probs_ket,
      OpType::save_amps,
@@ -80,7 +81,7 @@ const Operations::OpSet StateOpSet(
         "mcsx", "csxdg", "mcsxdg", "delay",   "pauli", "mcx_gray", "cu",
         "mcu",  "mcp",   "ecr",    "mcphase", "crx",   "cry",      "crz",
         "mcu",  "mcp",   "ecr",    "mcphase", "crx",   "cry",      "crz",
-        "H+S",  "SDG+H", "MOSQ",   "MOSQ_CR", //SW
+        "H+S",  "SDG+H", "MOSQ",   "MOSQ_CR", "MOSQ_BLOCK", //SW
     });
 
 // Allowed gates enum class
@@ -114,7 +115,8 @@ enum class Gates {
   hs, //SW
   sdgh, //SW
   mosq, //SW
-  mosq_cr //SW
+  mosq_cr, //SW
+  mosq_block //SW
 };
 
 //=========================================================================
@@ -141,6 +143,12 @@ public:
   void apply_op(const Operations::Op &op, ExperimentResult &result,
                 RngEngine &rng, bool final_op = false) override;
 
+  //SW: Apply a sequence of operations, the runs of slice-local ops in one
+  // parallel region each if statevector_persistent_parallel is set
+  void apply_ops(QuantumState::Base::OpItr first,
+                 QuantumState::Base::OpItr last, ExperimentResult &result,
+                 RngEngine &rng, bool final_ops = false) override;
+
   // memory allocation (previously called before inisitalize_qreg)
   bool allocate(uint_t num_qubits, uint_t block_bits,
                 uint_t num_parallel_shots = 1) override;
@@ -162,6 +170,13 @@ public:
   // if the controller/engine allows threads for it
   virtual void set_config(const Config &config) override;
 
+  //SW: Add the op profile if compiled with AER_PROFILING
+  virtual void add_metadata(ExperimentResult &result) const override {
+    BaseState::profile_.add_metadata(result);
+    if (num_persistent_runs_ > 0)
+      result.metadata.add(num_persistent_runs_, "persistent_parallel", "runs");
+  }
+
   // Sample n-measurement outcomes without applying the measure operation
   // to the system state
   std::vector<SampleVector> sample_measure(const reg_t &qubits, uint_t shots,
@@ -170,6 +185,22 @@ public:
   // Helper function for computing expectation value
   virtual double expval_pauli(const reg_t &qubits,
                               const std::string &pauli) override;
+
+  // Expectation values of Paulis grouped by X mask
+  virtual std::vector<double>
+  expval_paulis(const reg_t &qubits,
+                const std::vector<std::string> &paulis) override; //SW
+
+  // Expectation values of Paulis given by X and Z masks on qubits
+  virtual std::vector<double>
+  expval_pauli_masks(const reg_t &qubits, const reg_t &x_masks,
+                     const reg_t &z_masks) override; //SW
+
+  // Energy gradient by the adjoint method (see adjoint_gradient.hpp)
+  virtual std::vector<double>
+  energy_gradient(QuantumState::Base::OpItr first,
+                  QuantumState::Base::OpItr last, const Operations::Op &op,
+                  double &energy, bool final_op = false) override; //SW
   //-----------------------------------------------------------------------
   // Additional methods
   //-----------------------------------------------------------------------
@@ -239,10 +270,39 @@ public:
   // Apply the global phase
   void apply_global_phase();
 
-  // //SW
-  // double time_taken = 0.0;
-
 protected:
+  //SW
+  //-----------------------------------------------------------------------
+  // Profiling
+  //-----------------------------------------------------------------------
+
+  // Profiling kind of a gate
+  static Profiling::Kind profile_kind(const Gates gate);
+
+  // Estimated bytes read and written by passes over the statevector
+  uint_t statevector_bytes(const uint_t passes) const {
+    return passes * BaseState::qreg_.size() *
+           sizeof(*BaseState::qreg_.data());
+  }
+
+  // Members of the args object of the trace span of an op
+  std::string trace_args(const Operations::Op &op);
+
+  //SW
+  //-----------------------------------------------------------------------
+  // Persistent parallel region
+  //-----------------------------------------------------------------------
+
+  // Whether op only couples amplitudes within a slice of the statevector,
+  // the slices being the chunks of slice_bits qubits
+  bool is_slice_local(const Operations::Op &op, const uint_t slice_bits) const;
+
+  // Apply the slice-local ops [first, last) in one parallel region, each
+  // thread applying all of them to its own slice through a State viewing it
+  void apply_slice_run(QuantumState::Base::OpItr first,
+                       QuantumState::Base::OpItr last, const uint_t slice_bits,
+                       ExperimentResult &result, RngEngine &rng);
+
   //-----------------------------------------------------------------------
   // Save data instructions
   //-----------------------------------------------------------------------
@@ -323,6 +383,12 @@ protected:
   // OpenMP qubit threshold
   int omp_qubit_threshold_ = 14;
 
+  // Apply runs of slice-local ops in one parallel region //SW
+  bool persistent_parallel_ = false;
+
+  // Number of runs applied in one parallel region
+  uint_t num_persistent_runs_ = 0;
+
   // QubitVector sample measure index size
   int sample_measure_index_size_ = 10;
 
@@ -412,6 +478,7 @@ const stringmap_t<Gates> State<statevec_t>::gateset_(
      {"pauli", Gates::pauli},   // Multi-qubit Pauli gate
      {"MOSQ", Gates::mosq},   //SW
      {"MOSQ_CR", Gates::mosq_cr}, //SW
+     {"MOSQ_BLOCK", Gates::mosq_block}, //SW
      {"mcx_gray", Gates::mcx}});
 
 //=========================================================================
@@ -497,6 +564,7 @@ void State<statevec_t>::set_config(const Config &config) {
 
   // Set OMP threshold for state update functions
   omp_qubit_threshold_ = config.statevector_parallel_threshold;
+  persistent_parallel_ = config.statevector_persistent_parallel; //SW
 
   // Set the sample measure indexing size
   if (config.statevector_sample_measure_opt) {
@@ -523,8 +591,11 @@ void State<statevec_t>::apply_op(const Operations::Op &op,
                                  ExperimentResult &result, RngEngine &rng,
                                  bool final_op) {
   // printf("apply_op\n");
-  auto timer_start = myclock_t::now();
-  auto timer_stop = myclock_t::now();
+  Tracing::Span span("op"); //SW
+  if (span) {
+    span.set_name(op.name);
+    span.set_args(trace_args(op));
+  }
   if (BaseState::creg().check_conditional(op)) {
     switch (op.type) {
     case OpType::barrier:
@@ -549,21 +620,17 @@ void State<statevec_t>::apply_op(const Operations::Op &op,
     case OpType::gate:
       apply_gate(op);
       break;
-    case OpType::matrix:
+    case OpType::matrix: {
+      Profiling::Timer timer(BaseState::profile_,
+                             Profiling::matrix_kind(op.qubits.size()),
+                             op.qubits.size(), statevector_bytes(2)); //SW
       apply_matrix(op);
-  //SW
-  timer_stop = myclock_t::now(); // stop timer
-  if(op.qubits.size()==2) this->time_Fuse2 += std::chrono::duration<double>(timer_stop - timer_start).count();
-  else if(op.qubits.size()==3) this->time_Fuse3 += std::chrono::duration<double>(timer_stop - timer_start).count();
-  else if(op.qubits.size()==4) this->time_Fuse4 += std::chrono::duration<double>(timer_stop - timer_start).count();
-  else if(op.qubits.size()==5) this->time_Fuse5 += std::chrono::duration<double>(timer_stop - timer_start).count();
-      break;
-    case OpType::diagonal_matrix:
+    } break;
+    case OpType::diagonal_matrix: {
+      Profiling::Timer timer(BaseState::profile_, Profiling::Kind::diagonal,
+                             op.qubits.size(), statevector_bytes(2)); //SW
       apply_diagonal_matrix(op.qubits, op.params);
-      //SW
-      timer_stop = myclock_t::now(); // stop timer
-      this->time_Diag += std::chrono::duration<double>(timer_stop - timer_start).count();
-      break;
+    } break;
     case OpType::multiplexer:
       apply_multiplexer(op.regs[0], op.regs[1],
                         op.mats); // control qubits ([0]) & target qubits([1])
@@ -582,15 +649,23 @@ void State<statevec_t>::apply_op(const Operations::Op &op,
       initialize_from_vector(op.params);
       break;
     case OpType::save_expval:
-    case OpType::save_expval_var:
-      //SW: start T_exp
-      timer_start = myclock_t::now(); // start timer
+    case OpType::save_expval_var: {
+      Profiling::Timer timer(BaseState::profile_, Profiling::Kind::expval,
+                             op.qubits.size(),
+                             op.expval_params.size() * statevector_bytes(1)); //SW
       BaseState::apply_save_expval(op, result);
-      //SW: start T_exp
-      timer_stop = myclock_t::now(); // stop timer
-      this->time_taken += std::chrono::duration<double>(timer_stop - timer_start).count();
-      // std::cout << this->time_taken << std::endl;
-      break;
+    } break;
+    case OpType::save_hamiltonian_expval: {
+      Profiling::Timer timer(BaseState::profile_,
+                             Profiling::Kind::hamiltonian_expval,
+                             op.qubits.size(), statevector_bytes(1));
+      BaseState::apply_save_hamiltonian_expval(op, result);
+    } break; //SW
+    case OpType::save_energy_gradient:
+      // Handled by apply_ops, which knows the ops to reverse
+      throw std::invalid_argument(
+          "QubitVector::State: save_energy_gradient is only supported for a "
+          "single statevector simulated without chunks or shot branching.");
     case OpType::save_densmat:
       apply_save_density_matrix(op, result);
       break;
@@ -642,6 +717,124 @@ double State<statevec_t>::expval_pauli(const reg_t &qubits,
   return BaseState::qreg_.expval_pauli(qubits, pauli);
 }
 
+template <class statevec_t>
+std::vector<double>
+State<statevec_t>::expval_paulis(const reg_t &qubits,
+                                 const std::vector<std::string> &paulis) {
+  return BaseState::qreg_.expval_paulis(qubits, paulis);
+} //SW
+
+template <class statevec_t>
+std::vector<double>
+State<statevec_t>::expval_pauli_masks(const reg_t &qubits,
+                                      const reg_t &x_masks,
+                                      const reg_t &z_masks) {
+  // Masks are relative to qubits; skip the relabeling for the identity map
+  bool identity = true;
+  for (uint_t j = 0; j < qubits.size(); ++j)
+    identity &= (qubits[j] == j);
+  if (identity)
+    return BaseState::qreg_.expval_pauli_masks(x_masks, z_masks);
+
+  auto relabel = [&qubits](uint_t mask) {
+    uint_t ret = 0;
+    for (uint_t j = 0; mask; ++j, mask >>= 1)
+      if (mask & 1)
+        ret |= (1ULL << qubits[j]);
+    return ret;
+  };
+  reg_t x_abs(x_masks.size()), z_abs(z_masks.size());
+  for (uint_t i = 0; i < x_masks.size(); ++i) {
+    x_abs[i] = relabel(x_masks[i]);
+    z_abs[i] = relabel(z_masks[i]);
+  }
+  return BaseState::qreg_.expval_pauli_masks(x_abs, z_abs);
+} //SW
+
+template <class statevec_t>
+std::vector<double> State<statevec_t>::energy_gradient(
+    QuantumState::Base::OpItr first, QuantumState::Base::OpItr last,
+    const Operations::Op &op, double &energy, bool final_op) {
+  auto &phi = BaseState::qreg_;
+
+  // Pauli masks of the Hamiltonian terms on the statevector qubits
+  const uint_t num_terms = op.params.size();
+  reg_t x_masks(num_terms), z_masks(num_terms);
+  std::vector<double> coeffs(num_terms);
+  for (uint_t i = 0; i < num_terms; ++i) {
+    for (uint_t j = 0; j < op.qubits.size(); ++j) {
+      x_masks[i] |= ((op.int_params[2 * i] >> j) & 1ULL) << op.qubits[j];
+      z_masks[i] |= ((op.int_params[2 * i + 1] >> j) & 1ULL) << op.qubits[j];
+    }
+    coeffs[i] = std::real(op.params[i]);
+  }
+
+  // |lambda> = H |psi> is kept in a second state so that the ops undone on
+  // |phi> are undone on it with the same gate kernels
+  State<statevec_t> adjoint;
+  adjoint.set_parallelization(BaseState::threads_);
+  adjoint.omp_qubit_threshold_ = omp_qubit_threshold_;
+  adjoint.initialize_omp();
+  auto &lambda = adjoint.qreg();
+  lambda.set_num_qubits(phi.num_qubits());
+  lambda.initialize_from_pauli_sum(phi, x_masks, z_masks, coeffs);
+  energy = std::real(lambda.pauli_inner_product(phi, {0, 0, 0, 0}));
+
+  // Only the ops from the first rotation on are reversed
+  std::vector<PauliRotation> rotations;
+  auto begin = first;
+  while (begin != last && num_pauli_rotations(*begin) == 0)
+    ++begin;
+  uint_t num_rotations = 0;
+  for (auto it = begin; it != last; ++it)
+    num_rotations += num_pauli_rotations(*it);
+  std::vector<double> grad(num_rotations, 0.);
+  if (num_rotations == 0)
+    return grad;
+
+  // |phi> is swept back from |psi>, which is restored at the end
+  if (!final_op)
+    phi.checkpoint();
+
+  ExperimentResult dummy_result;
+  RngEngine dummy_rng;
+  uint_t index = num_rotations;
+  for (auto it = last; it != begin;) {
+    --it;
+    if (it->type == OpType::barrier || it->type == OpType::nop ||
+        it->type == OpType::qerror_loc || Operations::SAVE_TYPES.count(it->type))
+      continue;
+
+    if (num_pauli_rotations(*it) == 0) {
+      const auto inv = adjoint_op(*it);
+      apply_op(inv, dummy_result, dummy_rng);
+      adjoint.apply_op(inv, dummy_result, dummy_rng);
+      continue;
+    }
+
+    rotations.clear();
+    pauli_rotations(*it, rotations);
+    for (auto rot = rotations.rbegin(); rot != rotations.rend(); ++rot) {
+      const uint_t y_mask = rot->y_mask;
+      grad[--index] = std::imag(
+          phi.pauli_inner_product(lambda, {rot->x_mask | y_mask,
+                                           rot->z_mask | y_mask,
+                                           Utils::popcount(y_mask), 0}));
+      // The first rotation is not undone, nothing is left to differentiate
+      if (index == 0)
+        break;
+      const auto phase = std::exp(complex_t(0., -rot->theta));
+      phi.apply_MOSQ_CR(it->qubits, phase, rot->x_mask, y_mask, rot->z_mask);
+      lambda.apply_MOSQ_CR(it->qubits, phase, rot->x_mask, y_mask,
+                           rot->z_mask);
+    }
+  }
+
+  if (!final_op)
+    phi.revert(false);
+  return grad;
+} //SW
+
 template <class statevec_t>
 void State<statevec_t>::apply_save_statevector(const Operations::Op &op,
                                                ExperimentResult &result,
@@ -774,15 +967,189 @@ cmatrix_t State<statevec_t>::vec2density(const reg_t &qubits, const T &vec) {
   return densmat;
 }
 
+//=========================================================================
+// Implementation: Persistent parallel region
+//=========================================================================
+
+//SW
+template <class statevec_t>
+void State<statevec_t>::apply_ops(QuantumState::Base::OpItr first,
+                                  QuantumState::Base::OpItr last,
+                                  ExperimentResult &result, RngEngine &rng,
+                                  bool final_ops) {
+  // The slices are only used for a single statevector parallelized over its
+  // amplitudes, and not with ops that need the whole sequence
+  auto &qreg = BaseState::qreg_;
+  const uint_t num_qubits = qreg.num_qubits();
+  const uint_t threads = qreg.get_omp_threads();
+  bool persistent = persistent_parallel_ && threads > 1 &&
+                    num_qubits > qreg.get_omp_threshold() &&
+                    BaseState::num_global_qubits_ == num_qubits &&
+                    !qreg.support_global_indexing();
+  for (auto it = first; persistent && it != last; ++it)
+    persistent = it->type != OpType::mark && it->type != OpType::jump &&
+                 it->type != OpType::save_energy_gradient;
+  if (!persistent) {
+    BaseState::apply_ops(first, last, result, rng, final_ops);
+    return;
+  }
+
+  // One slice per thread, the highest qubits selecting the slice
+  uint_t num_slice_qubits = 0;
+  while ((2ull << num_slice_qubits) <= threads &&
+         num_slice_qubits + 1 < num_qubits)
+    ++num_slice_qubits;
+  const uint_t slice_bits = num_qubits - num_slice_qubits;
+
+  auto it = first;
+  while (it != last) {
+    auto run_last = it;
+    while (run_last != last && is_slice_local(*run_last, slice_bits))
+      ++run_last;
+    if (run_last - it < 2) {
+      // Ops coupling the slices are applied with a region of their own
+      apply_op(*it, result, rng, final_ops && (it + 1 == last));
+      ++it;
+    } else {
+      apply_slice_run(it, run_last, slice_bits, result, rng);
+      it = run_last;
+    }
+  }
+}
+
+template <class statevec_t>
+bool State<statevec_t>::is_slice_local(const Operations::Op &op,
+                                       const uint_t slice_bits) const {
+  if (op.conditional || op.expr)
+    return false;
+  const uint_t outer_mask = ~((1ull << slice_bits) - 1);
+  switch (op.type) {
+  case OpType::barrier:
+  case OpType::nop:
+    return true;
+  case OpType::diagonal_matrix:
+    // Chunk::block_diagonal_matrix selects the diagonal of a slice
+    return true;
+  case OpType::matrix:
+    return std::all_of(op.qubits.begin(), op.qubits.end(),
+                       [slice_bits](uint_t q) { return q < slice_bits; });
+  case OpType::gate:
+    break;
+  default:
+    return false;
+  }
+
+  if (op.name == "MOSQ")
+    return true;
+  if (op.name == "MOSQ_CR")
+    return ((op.int_params[0] | op.int_params[1]) & outer_mask) == 0;
+  if (op.name == "MOSQ_BLOCK")
+    return std::all_of(op.int_params.begin(), op.int_params.end(),
+                       [outer_mask](uint_t mask) {
+                         return (mask & outer_mask) == 0;
+                       });
+
+  // Controls above a slice are resolved by apply_gate as for chunks, except
+  // for gates that Chunk::correct_gate_op_in_chunk does not rename correctly
+  uint_t num_targets = op.qubits.size();
+  if ((op.name[0] == 'c' || op.name.find("mc") == 0) && op.name != "cu" &&
+      op.name != "mcu" && op.name != "ccz" && op.name != "mcx_gray")
+    num_targets = (op.name.find("swap") != std::string::npos) ? 2 : 1;
+  return std::all_of(op.qubits.end() - std::min(num_targets, op.qubits.size()),
+                     op.qubits.end(),
+                     [slice_bits](uint_t q) { return q < slice_bits; });
+}
+
+template <class statevec_t>
+void State<statevec_t>::apply_slice_run(QuantumState::Base::OpItr first,
+                                        QuantumState::Base::OpItr last,
+                                        const uint_t slice_bits,
+                                        ExperimentResult &result,
+                                        RngEngine &rng) {
+  auto &qreg = BaseState::qreg_;
+  const uint_t num_slices = 1ull << (qreg.num_qubits() - slice_bits);
+  ++num_persistent_runs_;
+  Tracing::Span span("parallel", "persistent_run");
+  Profiling::Timer timer(BaseState::profile_, Profiling::Kind::persistent_run,
+                         qreg.num_qubits(),
+                         statevector_bytes(2 * (last - first)));
+
+  std::vector<std::exception_ptr> exs(num_slices);
+#pragma omp parallel for num_threads(num_slices) schedule(static)
+  for (int_t i = 0; i < (int_t)num_slices; i++) {
+    try {
+      // Ops with qubits above the slice are corrected as for chunks
+      State<statevec_t> slice;
+      slice.set_num_global_qubits(qreg.num_qubits());
+      slice.qreg().set_chunk_view(qreg, slice_bits, i);
+      for (auto it = first; it != last; ++it)
+        slice.apply_op(*it, result, rng);
+    } catch (...) {
+      exs[i] = std::current_exception();
+    }
+  }
+  for (const auto &ex : exs)
+    if (ex)
+      std::rethrow_exception(ex);
+}
+
 //=========================================================================
 // Implementation: Matrix multiplication
 //=========================================================================
 
+//SW
+template <class statevec_t>
+std::string State<statevec_t>::trace_args(const Operations::Op &op) {
+  std::ostringstream args;
+  args << "\"qubits\":[";
+  for (uint_t i = 0; i < op.qubits.size(); ++i)
+    args << (i > 0 ? "," : "") << op.qubits[i];
+  args << "]";
+  if (op.name == "MOSQ_CR" && op.int_params.size() == 3)
+    args << ",\"mask_weight\":"
+         << Utils::popcount(op.int_params[0] | op.int_params[1] |
+                            op.int_params[2]);
+  else if (op.name == "MOSQ_BLOCK")
+    args << ",\"num_rotations\":" << op.int_params.size() / 3;
+  // Threads of the kernels, which run serially below the OpenMP threshold
+  auto &qreg = BaseState::qreg_;
+  const bool parallel = qreg.num_qubits() > qreg.get_omp_threshold() &&
+                        qreg.get_omp_threads() > 1;
+  args << ",\"threads\":" << (parallel ? qreg.get_omp_threads() : 1);
+  return args.str();
+}
+
+template <class statevec_t>
+Profiling::Kind State<statevec_t>::profile_kind(const Gates gate) {
+  switch (gate) {
+  case Gates::mcx:
+    return Profiling::Kind::cx;
+  case Gates::mcrz:
+    return Profiling::Kind::rz;
+  case Gates::h:
+    return Profiling::Kind::h;
+  case Gates::s:
+    return Profiling::Kind::s;
+  case Gates::sdg:
+    return Profiling::Kind::sdg;
+  case Gates::hs:
+    return Profiling::Kind::hs;
+  case Gates::sdgh:
+    return Profiling::Kind::sdgh;
+  case Gates::mosq:
+    return Profiling::Kind::mosq;
+  case Gates::mosq_cr:
+    return Profiling::Kind::mosq_cr;
+  case Gates::mosq_block:
+    return Profiling::Kind::mosq_block;
+  default:
+    return Profiling::Kind::gate;
+  }
+}
+
 template <class statevec_t>
 void State<statevec_t>::apply_gate(const Operations::Op &op) {
   // printf("gate name: %s\n", op.name.c_str());
-  auto timer_start = myclock_t::now();
-  auto timer_stop = myclock_t::now();
   // CPU qubit vector does not handle chunk ID inside kernel, so modify op here
   if (BaseState::num_global_qubits_ > BaseState::qreg_.num_qubits() &&
       !BaseState::qreg_.support_global_indexing()) {
@@ -811,12 +1178,12 @@ void State<statevec_t>::apply_gate(const Operations::Op &op) {
   if (it == gateset_.end())
     throw std::invalid_argument(
         "QubitVectorState::invalid gate instruction \'" + op.name + "\'.");
+  Profiling::Timer timer(BaseState::profile_, profile_kind(it->second),
+                         op.qubits.size(), statevector_bytes(2)); //SW
   switch (it->second) {
   case Gates::mcx:
     // Includes X, CX, CCX, etc
     BaseState::qreg_.apply_mcx(op.qubits);
-    timer_stop = myclock_t::now(); // stop timer
-    this->time_CX += std::chrono::duration<double>(timer_stop - timer_start).count();
     break;
   case Gates::mcy:
     // Includes Y, CY, CCY, etc
@@ -847,8 +1214,6 @@ void State<statevec_t>::apply_gate(const Operations::Op &op) {
     // std::cout << "(phase): " << op.params[0] << std::endl;
     BaseState::qreg_.apply_rotation(op.qubits, QV::Rotation::z,
                                     std::real(op.params[0]));
-    timer_stop = myclock_t::now(); // stop timer
-    this->time_RZ += std::chrono::duration<double>(timer_stop - timer_start).count();
     break;
   case Gates::rxx:
     BaseState::qreg_.apply_rotation(op.qubits, QV::Rotation::xx,
@@ -872,28 +1237,18 @@ void State<statevec_t>::apply_gate(const Operations::Op &op) {
     break;
   case Gates::h:
     apply_gate_mcu(op.qubits, M_PI / 2., 0., M_PI, 0.);
-    timer_stop = myclock_t::now(); // stop timer
-    this->time_H += std::chrono::duration<double>(timer_stop - timer_start).count();
     break;
   case Gates::sdgh: //SW
     apply_gate_mcu(op.qubits, M_PI / 2., 0., M_PI / 2., 0.);
-    timer_stop = myclock_t::now(); // stop timer
-    this->time_SDGH += std::chrono::duration<double>(timer_stop - timer_start).count();
     break;
   case Gates::hs: //SW
     apply_gate_mcu(op.qubits, M_PI / 2., M_PI / 2., M_PI, 0.);
-    timer_stop = myclock_t::now(); // stop timer
-    this->time_HS += std::chrono::duration<double>(timer_stop - timer_start).count();
     break;
   case Gates::s:
     apply_gate_phase(op.qubits[0], complex_t(0., 1.));
-    timer_stop = myclock_t::now(); // stop timer
-    this->time_S += std::chrono::duration<double>(timer_stop - timer_start).count();
     break;
   case Gates::sdg:
     apply_gate_phase(op.qubits[0], complex_t(0., -1.));
-    timer_stop = myclock_t::now(); // stop timer
-    this->time_SDG += std::chrono::duration<double>(timer_stop - timer_start).count();
     break;
   case Gates::t: {
     const double isqrt2{1. / std::sqrt(2)};
@@ -946,8 +1301,6 @@ void State<statevec_t>::apply_gate(const Operations::Op &op) {
     // std::cout << "(operating qubit num): " << op.qubits.size() << std::endl;
     // std::cout << "(phase): " << op.params[0] << std::endl;
     BaseState::qreg_.apply_MOSQ(op.qubits, std::exp(complex_t(0, 1) * op.params[0]));
-    timer_stop = myclock_t::now(); // stop timer
-    this->time_MOSQ += std::chrono::duration<double>(timer_stop - timer_start).count();
     break;
   case Gates::mosq_cr: //SW
     // num_par_SW = op.params.size();
@@ -957,9 +1310,13 @@ void State<statevec_t>::apply_gate(const Operations::Op &op) {
     // }
     // std::cout << "(operating qubit num): " << op.qubits.size() << std::endl;
     // std::cout << "(phase): " << op.params[0] << std::endl;
-    BaseState::qreg_.apply_MOSQ_CR(op.qubits, std::exp(complex_t(0, 1) * op.params[0]), op.params[1], op.params[2], op.params[3]);
-    timer_stop = myclock_t::now(); // stop timer
-    this->time_MOSQ_CR += std::chrono::duration<double>(timer_stop - timer_start).count();
+    BaseState::qreg_.apply_MOSQ_CR(op.qubits, std::exp(complex_t(0, 1) * op.params[0]),
+                                   op.int_params[0], op.int_params[1],
+                                   op.int_params[2]);
+    break;
+  case Gates::mosq_block: //SW
+    // A block of MOSQ_CR rotations applied in one pass
+    BaseState::qreg_.apply_MOSQ_BLOCK(op.params, op.int_params);
     break;
   default:
     // We shouldn't reach here unless there is a bug in gateset
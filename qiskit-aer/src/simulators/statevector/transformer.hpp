@@ -49,6 +49,24 @@ public:
                                      int threads, const reg_t &qubits,
                                      const cvector_t<double> &diag) const;
 
+  // Apply a diagonal Pauli Z-string rotation (MOSQ): every amplitude is
+  // multiplied by phases[parity] where parity is its parity over z_mask.
+  // The two phases are given in the data precision, as these rotations are
+  // also applied to small cache resident blocks where a conversion per call
+  // would dominate.
+  virtual void apply_MOSQ(Container &data, size_t data_size, int threads,
+                          const uint_t z_mask,
+                          const std::complex<data_t> *phases) const; //SW
+
+  // Apply a Pauli rotation (MOSQ_CR) to all amplitude pairs connected by
+  // xy_mask. The coefficients are the 9 pair matrix entries
+  // {diag, upper[4], lower[4]} indexed by the phase selector of each pair
+  // (see QV::apply_lambda_MOSQ_CR).
+  virtual void apply_MOSQ_CR(Container &data, size_t data_size, int threads,
+                             const uint_t xy_mask, const uint_t y_mask,
+                             const uint_t z_mask,
+                             const std::complex<data_t> *coeffs) const; //SW
+
 protected:
   // Apply a N-qubit matrix to the state vector.
   // The matrix is input as vector of the column-major vectorized N-qubit
@@ -140,6 +158,33 @@ void Transformer<Container, data_t>::apply_matrix(
   }
 }
 
+template <typename Container, typename data_t>
+void Transformer<Container, data_t>::apply_MOSQ(
+    Container &data, size_t data_size, int threads, const uint_t z_mask,
+    const std::complex<data_t> *phases) const {
+  auto func = [&](const uint_t k, const uint_t parity) -> void {
+    data[k] *= phases[parity];
+  };
+  apply_lambda_MOSQ(0, data_size, threads, func, z_mask);
+} //SW
+
+template <typename Container, typename data_t>
+void Transformer<Container, data_t>::apply_MOSQ_CR(
+    Container &data, size_t data_size, int threads, const uint_t xy_mask,
+    const uint_t y_mask, const uint_t z_mask,
+    const std::complex<data_t> *coeffs) const {
+  const std::complex<data_t> diag = coeffs[0];
+  const std::complex<data_t> *upper = &coeffs[1];
+  const std::complex<data_t> *lower = &coeffs[5];
+
+  auto func = [&](const areg_t<2> &inds, const uint_t sel) -> void {
+    const auto cache = data[inds[0]];
+    data[inds[0]] = diag * cache + upper[sel] * data[inds[1]];
+    data[inds[1]] = lower[sel] * cache + diag * data[inds[1]];
+  };
+  apply_lambda_MOSQ_CR(0, data_size, threads, func, xy_mask, y_mask, z_mask);
+} //SW
+
 template <typename Container, typename data_t>
 template <size_t N>
 void Transformer<Container, data_t>::apply_matrix_n(
@@ -41,6 +41,15 @@ public:
   void apply_diagonal_matrix(Container &data, size_t data_size, int threads,
                              const reg_t &qubits,
                              const cvector_t<double> &diag) const override;
+
+  void apply_MOSQ(Container &data, size_t data_size, int threads,
+                  const uint_t z_mask,
+                  const std::complex<data_t> *phases) const override; //SW
+
+  void apply_MOSQ_CR(Container &data, size_t data_size, int threads,
+                     const uint_t xy_mask, const uint_t y_mask,
+                     const uint_t z_mask,
+                     const std::complex<data_t> *coeffs) const override; //SW
 };
 
 /*******************************************************************************
@@ -57,7 +66,6 @@ template <typename Container, typename data_t>
 void TransformerAVX2<Container, data_t>::apply_matrix(
     Container &data, size_t data_size, int threads, const reg_t &qubits,
     const cvector_t<double> &mat) const {
-      printf("we are using AVX2\n");
 
   if (qubits.size() == 1 &&
       ((mat[1] == 0.0 && mat[2] == 0.0) || (mat[0] == 0.0 && mat[3] == 0.0))) {
@@ -89,6 +97,37 @@ void TransformerAVX2<Container, data_t>::apply_diagonal_matrix(
   Base::apply_diagonal_matrix(data, data_size, threads, qubits, diag);
 }
 
+template <typename Container, typename data_t>
+void TransformerAVX2<Container, data_t>::apply_MOSQ(
+    Container &data, size_t data_size, int threads, const uint_t z_mask,
+    const std::complex<data_t> *phases) const {
+
+  if (apply_MOSQ_avx<data_t>(reinterpret_cast<data_t *>(data), data_size,
+                             z_mask, reinterpret_cast<const data_t *>(phases),
+                             threads) == Avx::Applied) {
+    return;
+  }
+
+  Base::apply_MOSQ(data, data_size, threads, z_mask, phases);
+} //SW
+
+template <typename Container, typename data_t>
+void TransformerAVX2<Container, data_t>::apply_MOSQ_CR(
+    Container &data, size_t data_size, int threads, const uint_t xy_mask,
+    const uint_t y_mask, const uint_t z_mask,
+    const std::complex<data_t> *coeffs) const {
+
+  if (apply_MOSQ_CR_avx<data_t>(reinterpret_cast<data_t *>(data), data_size,
+                                xy_mask, y_mask, z_mask,
+                                reinterpret_cast<const data_t *>(coeffs),
+                                threads) == Avx::Applied) {
+    return;
+  }
+
+  Base::apply_MOSQ_CR(data, data_size, threads, xy_mask, y_mask, z_mask,
+                      coeffs);
+} //SW
+
 #endif // AVX2 Code
 
 //------------------------------------------------------------------------------
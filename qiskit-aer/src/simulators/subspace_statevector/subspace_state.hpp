@@ -0,0 +1,437 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _subspace_statevector_state_hpp
+#define _subspace_statevector_state_hpp
+
+#include <algorithm>
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include "framework/config.hpp"
+#include "framework/json.hpp"
+#include "framework/linalg/linalg.hpp"
+#include "framework/utils.hpp"
+#include "simulators/state.hpp"
+#include "subspace_vector.hpp"
+
+namespace AER {
+namespace SubspaceStatevector {
+
+//SW
+// Statevector simulation of particle-number conserving circuits, such as
+// UCCSD ansatze of Jordan-Wigner mapped molecules. The circuit prepares a
+// basis state with X (or other diagonal and anti-diagonal single-qubit)
+// gates, which fixes the sector of the register weights, and then applies
+// MOSQ_CR / MOSQ rotations. Runs of consecutive MOSQ_CR rotations that share
+// their pair qubits (X | Y) are applied together, so the Pauli strings of a
+// fermionic excitation conserve the sector although each one alone does not.
+
+using OpType = Operations::OpType;
+
+// OpSet of supported instructions
+const Operations::OpSet StateOpSet(
+    // Op types
+    {OpType::gate, OpType::barrier, OpType::qerror_loc, OpType::bfunc,
+     OpType::save_expval, OpType::save_expval_var,
+     OpType::save_hamiltonian_expval, OpType::save_statevec,
+     OpType::save_state, OpType::jump, OpType::mark},
+    // Gates
+    {"id", "delay", "x", "y", "z", "s", "sdg", "t", "tdg", "rz", "p", "u1",
+     "u3", "u", "U", "rx", "ry", "r", "MOSQ", "MOSQ_CR"});
+
+//=========================================================================
+// SubspaceStatevector State subclass
+//=========================================================================
+
+template <class statevec_t = QV::SubspaceVector<double>>
+class State : public QuantumState::State<statevec_t> {
+public:
+  using BaseState = QuantumState::State<statevec_t>;
+  using Rotation = typename statevec_t::Rotation;
+  using OpItr = typename BaseState::OpItr;
+
+  State() : BaseState(StateOpSet) {}
+  virtual ~State() = default;
+
+  //-----------------------------------------------------------------------
+  // Base class overrides
+  //-----------------------------------------------------------------------
+
+  // Return the string name of the State class
+  virtual std::string name() const override { return "subspace_statevector"; }
+
+  // Apply an operation
+  // If the op is not in allowed_ops an exeption will be raised.
+  virtual void apply_op(const Operations::Op &op, ExperimentResult &result,
+                        RngEngine &rng, bool final_op = false) override;
+
+  // Apply a sequence of operations and flush the queued rotations
+  virtual void apply_ops(OpItr first, OpItr last,
+                         ExperimentResult &result, RngEngine &rng,
+                         bool final_ops = false) override;
+
+  // Initializes the state to |0...0>. The sector is fixed on the first
+  // rotation or save instruction.
+  virtual void initialize_qreg(uint_t num_qubits) override;
+
+  // Returns the required memory for the largest sector of the registers
+  virtual size_t
+  required_memory_mb(uint_t num_qubits,
+                     const std::vector<Operations::Op> &ops) const override;
+
+  // Config: {"subspace_spin_sectors": true, "statevector_parallel_threshold":
+  // 14}
+  virtual void set_config(const Config &config) override;
+
+  // Return the expectation value of a N-qubit Pauli operator
+  virtual double expval_pauli(const reg_t &qubits,
+                              const std::string &pauli) override;
+
+  virtual std::vector<double>
+  expval_paulis(const reg_t &qubits,
+                const std::vector<std::string> &paulis) override;
+
+  virtual std::vector<double> expval_pauli_masks(const reg_t &qubits,
+                                                 const reg_t &x_masks,
+                                                 const reg_t &z_masks) override;
+
+protected:
+  //-----------------------------------------------------------------------
+  // Apply instructions
+  //-----------------------------------------------------------------------
+
+  void apply_gate(const Operations::Op &op);
+
+  // Apply a diagonal or anti-diagonal single-qubit gate
+  void apply_single_qubit(uint_t qubit, const cvector_t &mat);
+
+  // Queue a MOSQ_CR rotation, flushing the queue if its pair qubits differ
+  void queue_rotation(const Operations::Op &op);
+
+  // Apply the queued rotations
+  void flush_rotations();
+
+  // Fix the sector to the current basis state
+  void initialize_sector();
+
+  void apply_save_statevector(const Operations::Op &op,
+                              ExperimentResult &result);
+
+  // Register sizes for the sector of num_qubits qubits
+  reg_t register_sizes(uint_t num_qubits) const;
+
+  //-----------------------------------------------------------------------
+  // State before the sector is fixed
+  //-----------------------------------------------------------------------
+
+  uint_t basis_index_ = 0;
+  complex_t basis_amp_ = 1.;
+
+  std::vector<Rotation> pending_;
+
+  //-----------------------------------------------------------------------
+  // Config Settings
+  //-----------------------------------------------------------------------
+
+  bool spin_sectors_ = true;
+  int omp_qubit_threshold_ = 14;
+
+  // Norm of an amplitude mapped out of the sector that is tolerated
+  double leak_threshold_ = 1e-8;
+};
+
+//============================================================================
+// Implementation: Base class method overrides
+//============================================================================
+
+template <class statevec_t>
+void State<statevec_t>::apply_op(const Operations::Op &op,
+                                 ExperimentResult &result, RngEngine &rng,
+                                 bool final_op) {
+  if (op.type == OpType::gate && op.name == "MOSQ_CR" && !op.conditional) {
+    queue_rotation(op);
+    return;
+  }
+  flush_rotations();
+
+  if (BaseState::creg().check_conditional(op)) {
+    switch (op.type) {
+    case OpType::barrier:
+    case OpType::qerror_loc:
+      break;
+    case OpType::gate:
+      if (op.name == "MOSQ_CR")
+        queue_rotation(op);
+      else
+        apply_gate(op);
+      break;
+    case OpType::bfunc:
+      BaseState::creg().apply_bfunc(op);
+      break;
+    case OpType::save_expval:
+    case OpType::save_expval_var:
+      initialize_sector();
+      BaseState::apply_save_expval(op, result);
+      break;
+    case OpType::save_hamiltonian_expval:
+      initialize_sector();
+      BaseState::apply_save_hamiltonian_expval(op, result);
+      break;
+    case OpType::save_state:
+    case OpType::save_statevec:
+      apply_save_statevector(op, result);
+      break;
+    default:
+      throw std::invalid_argument(
+          "SubspaceStatevector::State::invalid instruction \'" + op.name +
+          "\'.");
+    }
+  }
+}
+
+template <class statevec_t>
+void State<statevec_t>::apply_ops(OpItr first, OpItr last,
+                                  ExperimentResult &result, RngEngine &rng,
+                                  bool final_ops) {
+  BaseState::apply_ops(first, last, result, rng, final_ops);
+  flush_rotations();
+}
+
+template <class statevec_t>
+void State<statevec_t>::initialize_qreg(uint_t num_qubits) {
+  BaseState::qreg_.set_omp_threshold(omp_qubit_threshold_);
+  if (BaseState::threads_ > 0)
+    BaseState::qreg_.set_omp_threads(BaseState::threads_);
+  BaseState::qreg_.set_num_qubits(num_qubits);
+  BaseState::qreg_.set_registers(register_sizes(num_qubits));
+  basis_index_ = 0;
+  basis_amp_ = 1.;
+  pending_.clear();
+}
+
+template <class statevec_t>
+size_t State<statevec_t>::required_memory_mb(
+    uint_t num_qubits, const std::vector<Operations::Op> &ops) const {
+  (void)ops; // avoid unused variable compiler warning
+  // Amplitudes and their basis states
+  const double bytes =
+      statevec_t::max_sector_size(num_qubits, register_sizes(num_qubits)) *
+      (2 * sizeof(double) + sizeof(uint_t));
+  return (size_t)(bytes / (1ULL << 20)) + 1;
+}
+
+template <class statevec_t>
+void State<statevec_t>::set_config(const Config &config) {
+  BaseState::set_config(config);
+  spin_sectors_ = config.subspace_spin_sectors;
+  omp_qubit_threshold_ = config.statevector_parallel_threshold;
+}
+
+template <class statevec_t>
+reg_t State<statevec_t>::register_sizes(uint_t num_qubits) const {
+  if (spin_sectors_ && num_qubits >= 2 && num_qubits % 2 == 0)
+    return reg_t({num_qubits / 2, num_qubits / 2});
+  return reg_t();
+}
+
+//============================================================================
+// Implementation: Gates
+//============================================================================
+
+template <class statevec_t>
+void State<statevec_t>::apply_gate(const Operations::Op &op) {
+  if (op.name == "id" || op.name == "delay")
+    return;
+  if (op.name == "MOSQ") {
+    initialize_sector();
+    uint_t z_mask = 0;
+    for (const auto q : op.qubits)
+      z_mask ^= (1ULL << q);
+    BaseState::qreg_.apply_parity_phase(
+        z_mask, std::exp(complex_t(0., 1.) * op.params[0]));
+    return;
+  }
+
+  // Single qubit gates as column-major 2x2 matrices
+  cvector_t mat;
+  if (op.name == "x")
+    mat = Linalg::VMatrix::X;
+  else if (op.name == "y")
+    mat = Linalg::VMatrix::Y;
+  else if (op.name == "z")
+    mat = Linalg::VMatrix::Z;
+  else if (op.name == "s")
+    mat = Linalg::VMatrix::S;
+  else if (op.name == "sdg")
+    mat = Linalg::VMatrix::SDG;
+  else if (op.name == "t")
+    mat = Linalg::VMatrix::T;
+  else if (op.name == "tdg")
+    mat = Linalg::VMatrix::TDG;
+  else if (op.name == "rz")
+    mat = Linalg::VMatrix::rz(std::real(op.params[0]));
+  else if (op.name == "p" || op.name == "u1")
+    mat = Linalg::VMatrix::phase(std::real(op.params[0]));
+  else if (op.name == "rx")
+    mat = Linalg::VMatrix::rx(std::real(op.params[0]));
+  else if (op.name == "ry")
+    mat = Linalg::VMatrix::ry(std::real(op.params[0]));
+  else if (op.name == "r")
+    mat = Linalg::VMatrix::r(std::real(op.params[0]),
+                             std::real(op.params[1]));
+  else if (op.name == "u3" || op.name == "u" || op.name == "U")
+    mat = Linalg::VMatrix::u3(std::real(op.params[0]),
+                              std::real(op.params[1]),
+                              std::real(op.params[2]));
+  else
+    throw std::invalid_argument(
+        "SubspaceStatevector::State::invalid gate instruction \'" + op.name +
+        "\'.");
+  apply_single_qubit(op.qubits[0], mat);
+}
+
+template <class statevec_t>
+void State<statevec_t>::apply_single_qubit(uint_t qubit,
+                                           const cvector_t &mat) {
+  const double eps = 1e-12;
+  const bool diagonal = std::abs(mat[1]) < eps && std::abs(mat[2]) < eps;
+  const bool anti_diagonal = std::abs(mat[0]) < eps && std::abs(mat[3]) < eps;
+
+  if (diagonal) {
+    if (BaseState::qreg_.initialized())
+      BaseState::qreg_.apply_diagonal(qubit, mat[0], mat[3]);
+    else
+      basis_amp_ *= ((basis_index_ >> qubit) & 1) ? mat[3] : mat[0];
+    return;
+  }
+  if (anti_diagonal && !BaseState::qreg_.initialized()) {
+    // Column-major: mat[1] = <1|U|0>, mat[2] = <0|U|1>
+    basis_amp_ *= ((basis_index_ >> qubit) & 1) ? mat[2] : mat[1];
+    basis_index_ ^= (1ULL << qubit);
+    return;
+  }
+  throw std::invalid_argument(
+      "SubspaceStatevector::State: single-qubit gates that do not conserve "
+      "the particle number are only supported before the first rotation.");
+}
+
+template <class statevec_t>
+void State<statevec_t>::queue_rotation(const Operations::Op &op) {
+  const uint_t pair = op.int_params[0] | op.int_params[1];
+  if (!pending_.empty() && (pending_[0].x | pending_[0].y) != pair)
+    flush_rotations();
+  pending_.push_back(Rotation{std::real(op.params[0]), op.int_params[0],
+                              op.int_params[1], op.int_params[2]});
+}
+
+template <class statevec_t>
+void State<statevec_t>::flush_rotations() {
+  if (pending_.empty())
+    return;
+  initialize_sector();
+  const double leak = BaseState::qreg_.apply_rotations(pending_);
+  pending_.clear();
+  if (leak > leak_threshold_) {
+    throw std::runtime_error(
+        "SubspaceStatevector::State: the MOSQ_CR rotations do not conserve "
+        "the particle-number sector (leaked norm " +
+        std::to_string(leak) + ").");
+  }
+}
+
+template <class statevec_t>
+void State<statevec_t>::initialize_sector() {
+  if (!BaseState::qreg_.initialized())
+    BaseState::qreg_.initialize_sector(basis_index_, basis_amp_);
+}
+
+//============================================================================
+// Implementation: Save data
+//============================================================================
+
+template <class statevec_t>
+void State<statevec_t>::apply_save_statevector(const Operations::Op &op,
+                                               ExperimentResult &result) {
+  if (op.qubits.size() != BaseState::qreg_.num_qubits()) {
+    throw std::invalid_argument(op.name +
+                                " was not applied to all qubits."
+                                " Only the full statevector can be saved.");
+  }
+  initialize_sector();
+  std::string key =
+      (op.string_params[0] == "_method_") ? "statevector" : op.string_params[0];
+  result.save_data_pershot(BaseState::creg(), key,
+                           BaseState::qreg_.copy_to_vector(),
+                           OpType::save_statevec, op.save_type);
+}
+
+template <class statevec_t>
+double State<statevec_t>::expval_pauli(const reg_t &qubits,
+                                       const std::string &pauli) {
+  uint_t x_mask = 0, z_mask = 0;
+  // Pauli labels are little-endian in the qubits
+  for (uint_t j = 0; j < pauli.size(); ++j) {
+    const char c = pauli[pauli.size() - 1 - j];
+    if (c == 'X' || c == 'Y')
+      x_mask |= (1ULL << j);
+    if (c == 'Z' || c == 'Y')
+      z_mask |= (1ULL << j);
+  }
+  return expval_pauli_masks(qubits, reg_t({x_mask}), reg_t({z_mask}))[0];
+}
+
+template <class statevec_t>
+std::vector<double>
+State<statevec_t>::expval_paulis(const reg_t &qubits,
+                                 const std::vector<std::string> &paulis) {
+  reg_t x_masks(paulis.size()), z_masks(paulis.size());
+  for (uint_t i = 0; i < paulis.size(); ++i) {
+    const auto &pauli = paulis[i];
+    for (uint_t j = 0; j < pauli.size(); ++j) {
+      const char c = pauli[pauli.size() - 1 - j];
+      if (c == 'X' || c == 'Y')
+        x_masks[i] |= (1ULL << j);
+      if (c == 'Z' || c == 'Y')
+        z_masks[i] |= (1ULL << j);
+    }
+  }
+  return expval_pauli_masks(qubits, x_masks, z_masks);
+}
+
+template <class statevec_t>
+std::vector<double> State<statevec_t>::expval_pauli_masks(const reg_t &qubits,
+                                                          const reg_t &x_masks,
+                                                          const reg_t &z_masks) {
+  initialize_sector();
+  auto relabel = [&qubits](uint_t mask) {
+    uint_t ret = 0;
+    for (uint_t j = 0; mask; ++j, mask >>= 1)
+      if (mask & 1)
+        ret |= (1ULL << qubits[j]);
+    return ret;
+  };
+  reg_t x_abs(x_masks.size()), z_abs(z_masks.size());
+  for (uint_t i = 0; i < x_masks.size(); ++i) {
+    x_abs[i] = relabel(x_masks[i]);
+    z_abs[i] = relabel(z_masks[i]);
+  }
+  return BaseState::qreg_.expval_pauli_masks(x_abs, z_abs);
+}
+
+//------------------------------------------------------------------------------
+} // end namespace SubspaceStatevector
+} // end namespace AER
+//------------------------------------------------------------------------------
+#endif
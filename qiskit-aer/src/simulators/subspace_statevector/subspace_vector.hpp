@@ -0,0 +1,469 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _qv_subspace_vector_hpp_
+#define _qv_subspace_vector_hpp_
+
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "framework/linalg/vector.hpp"
+#include "framework/types.hpp"
+#include "framework/utils.hpp"
+
+namespace AER {
+namespace QV {
+
+//SW
+//============================================================================
+// SubspaceVector class
+//============================================================================
+
+// Statevector restricted to a particle-number sector. The qubits are split
+// into registers of consecutive qubits (e.g. the alpha and beta spin orbitals
+// of a Jordan-Wigner mapped molecule) and only the basis states with a fixed
+// Hamming weight in every register are stored, which is C(m_0, k_0) *
+// C(m_1, k_1) * ... amplitudes instead of 2^n.
+//
+// An amplitude is indexed by the combinatorial rank of its basis state: the
+// colex rank of the occupied positions in each register (which is the order
+// of the register bits as integers), mixed-radix over the registers with the
+// first register varying fastest. Ranks of register bits are tabulated, so
+// ranking a basis state costs one lookup per register.
+
+template <typename data_t = double>
+class SubspaceVector {
+public:
+  // A MOSQ_CR rotation e^{i theta/2} exp(-i theta/2 P) with the X, Y and Z
+  // qubits of the Pauli P given by disjoint masks
+  struct Rotation {
+    double theta;
+    uint_t x;
+    uint_t y;
+    uint_t z;
+  };
+
+  SubspaceVector() = default;
+  SubspaceVector(const SubspaceVector &obj) = delete;
+  SubspaceVector &operator=(const SubspaceVector &obj) = delete;
+
+  //-----------------------------------------------------------------------
+  // Sector
+  //-----------------------------------------------------------------------
+
+  // Set the number of qubits. The sector is unset until initialize_sector.
+  void set_num_qubits(uint_t num_qubits);
+  uint_t num_qubits() const { return num_qubits_; }
+
+  // Split the qubits into registers of the given sizes, starting at qubit 0.
+  // An empty list is a single register of all qubits.
+  void set_registers(const reg_t &sizes);
+
+  // Fix the sector to the register weights of basis state index and
+  // initialize the state to amp |index>
+  void initialize_sector(uint_t index, std::complex<double> amp = 1.);
+
+  // True once the sector has been fixed
+  bool initialized() const { return !data_.empty(); }
+
+  // Number of stored amplitudes
+  uint_t size() const { return data_.size(); }
+
+  // Hamming weight of each register in the sector
+  const reg_t &weights() const { return weights_; }
+
+  // Rank of a basis state, or size() if it is not in the sector
+  uint_t rank(uint_t index) const;
+
+  // Basis state of a rank
+  uint_t basis_state(uint_t r) const { return basis_[r]; }
+
+  // Largest number of amplitudes over the sectors of the given registers
+  static double max_sector_size(uint_t num_qubits, const reg_t &sizes);
+
+  //-----------------------------------------------------------------------
+  // Operations
+  //-----------------------------------------------------------------------
+
+  // Multiply the amplitudes with qubit 0 by phase0 and with qubit 1 by phase1
+  void apply_diagonal(uint_t qubit, std::complex<double> phase0,
+                      std::complex<double> phase1);
+
+  // Multiply the amplitudes with odd parity on z_mask by phase (MOSQ)
+  void apply_parity_phase(uint_t z_mask, std::complex<double> phase);
+
+  // Apply a run of rotations sharing the pair mask x | y. Each amplitude
+  // pair (i, i ^ (x | y)) is updated by all rotations of the run at once;
+  // the part of an amplitude mapped out of the sector is dropped and its
+  // norm returned, which is zero when the run conserves the register
+  // weights (as the Pauli strings of a fermionic excitation do together).
+  double apply_rotations(const std::vector<Rotation> &rots);
+
+  //-----------------------------------------------------------------------
+  // Measurement
+  //-----------------------------------------------------------------------
+
+  double norm() const;
+
+  // Expectation values of Paulis given by their X and Z masks, where a bit
+  // set in both masks is a Y. Paulis are evaluated together per X mask.
+  std::vector<double> expval_pauli_masks(const reg_t &x_masks,
+                                         const reg_t &z_masks) const;
+
+  // Return the full 2^n statevector
+  AER::Vector<std::complex<data_t>> copy_to_vector() const;
+
+  //-----------------------------------------------------------------------
+  // OpenMP configuration settings
+  //-----------------------------------------------------------------------
+
+  void set_omp_threads(int n) {
+    if (n > 0)
+      omp_threads_ = n;
+  }
+  void set_omp_threshold(int n) {
+    if (n > 0)
+      omp_threshold_ = n;
+  }
+
+protected:
+  uint_t num_qubits_ = 0;
+  std::vector<std::complex<data_t>> data_;
+
+  // Registers: first qubit, number of qubits, weight in the sector and
+  // mixed-radix stride of the rank
+  reg_t offsets_;
+  reg_t sizes_;
+  reg_t weights_;
+  reg_t strides_;
+
+  // Rank of the register bits within the register, or npos_
+  std::vector<std::vector<uint32_t>> rank_tables_;
+  static constexpr uint32_t npos_ = std::numeric_limits<uint32_t>::max();
+
+  // Basis state of each rank
+  reg_t basis_;
+
+  uint_t omp_threads_ = 1;
+  uint_t omp_threshold_ = 14;
+
+  // Registers of more qubits would need too large rank tables
+  static constexpr uint_t max_register_qubits_ = 24;
+
+  // Threads for a pass over the amplitudes, compared as the number of
+  // qubits of a statevector of the same size
+  uint_t omp_threads_managed() const {
+    uint_t bits = 0;
+    while ((1ULL << bits) < data_.size())
+      ++bits;
+    return (bits > omp_threshold_ && omp_threads_ > 1) ? omp_threads_ : 1;
+  }
+
+  static double binomial(uint_t n, uint_t k);
+};
+
+//============================================================================
+// Implementation: Sector
+//============================================================================
+
+template <typename data_t>
+void SubspaceVector<data_t>::set_num_qubits(uint_t num_qubits) {
+  if (num_qubits > 64) {
+    throw std::invalid_argument(
+        "SubspaceVector: more than 64 qubits are not supported.");
+  }
+  num_qubits_ = num_qubits;
+  data_.clear();
+  basis_.clear();
+  rank_tables_.clear();
+  set_registers(reg_t());
+}
+
+template <typename data_t>
+void SubspaceVector<data_t>::set_registers(const reg_t &sizes) {
+  reg_t regs = sizes.empty() ? reg_t({num_qubits_}) : sizes;
+  offsets_.clear();
+  sizes_.clear();
+  uint_t offset = 0;
+  for (const auto size : regs) {
+    if (size > max_register_qubits_) {
+      throw std::invalid_argument(
+          "SubspaceVector: registers of more than " +
+          std::to_string(max_register_qubits_) +
+          " qubits are not supported.");
+    }
+    offsets_.push_back(offset);
+    sizes_.push_back(size);
+    offset += size;
+  }
+  if (offset != num_qubits_) {
+    throw std::invalid_argument(
+        "SubspaceVector: register sizes do not add up to the qubit number.");
+  }
+}
+
+template <typename data_t>
+void SubspaceVector<data_t>::initialize_sector(uint_t index,
+                                               std::complex<double> amp) {
+  const uint_t num_regs = sizes_.size();
+  weights_.resize(num_regs);
+  strides_.resize(num_regs);
+  rank_tables_.resize(num_regs);
+
+  uint_t dim = 1;
+  std::vector<reg_t> patterns(num_regs);
+  for (uint_t g = 0; g < num_regs; ++g) {
+    const uint_t mask = (1ULL << sizes_[g]) - 1;
+    weights_[g] = Utils::popcount((index >> offsets_[g]) & mask);
+    strides_[g] = dim;
+
+    // Colex order of the occupied positions is the integer order of the bits
+    auto &table = rank_tables_[g];
+    table.assign(mask + 1, uint32_t(npos_));
+    for (uint_t bits = 0; bits <= mask; ++bits) {
+      if (Utils::popcount(bits) == weights_[g]) {
+        table[bits] = patterns[g].size();
+        patterns[g].push_back(bits);
+      }
+    }
+    dim *= patterns[g].size();
+  }
+
+  basis_.resize(dim);
+  for (uint_t r = 0; r < dim; ++r) {
+    uint_t state = 0;
+    for (uint_t g = 0; g < num_regs; ++g) {
+      const auto &pattern = patterns[g];
+      state |= pattern[(r / strides_[g]) % pattern.size()] << offsets_[g];
+    }
+    basis_[r] = state;
+  }
+
+  data_.assign(dim, 0.);
+  data_[rank(index)] = amp;
+}
+
+template <typename data_t>
+uint_t SubspaceVector<data_t>::rank(uint_t index) const {
+  uint_t r = 0;
+  for (uint_t g = 0; g < sizes_.size(); ++g) {
+    const uint_t mask = (1ULL << sizes_[g]) - 1;
+    const uint32_t local = rank_tables_[g][(index >> offsets_[g]) & mask];
+    if (local == npos_)
+      return data_.size();
+    r += local * strides_[g];
+  }
+  return r;
+}
+
+template <typename data_t>
+double SubspaceVector<data_t>::binomial(uint_t n, uint_t k) {
+  double ret = 1.;
+  for (uint_t i = 1; i <= k; ++i)
+    ret = ret * (n - k + i) / i;
+  return ret;
+}
+
+template <typename data_t>
+double SubspaceVector<data_t>::max_sector_size(uint_t num_qubits,
+                                               const reg_t &sizes) {
+  reg_t regs = sizes.empty() ? reg_t({num_qubits}) : sizes;
+  double ret = 1.;
+  for (const auto size : regs)
+    ret *= binomial(size, size / 2);
+  return ret;
+}
+
+//============================================================================
+// Implementation: Operations
+//============================================================================
+
+template <typename data_t>
+void SubspaceVector<data_t>::apply_diagonal(uint_t qubit,
+                                            std::complex<double> phase0,
+                                            std::complex<double> phase1) {
+  const uint_t bit = 1ULL << qubit;
+  const std::complex<data_t> p0(phase0), p1(phase1);
+  const int_t dim = data_.size();
+#pragma omp parallel for if (omp_threads_managed() > 1)                        \
+    num_threads(omp_threads_managed())
+  for (int_t r = 0; r < dim; ++r)
+    data_[r] *= (basis_[r] & bit) ? p1 : p0;
+}
+
+template <typename data_t>
+void SubspaceVector<data_t>::apply_parity_phase(uint_t z_mask,
+                                                std::complex<double> phase) {
+  const std::complex<data_t> p(phase);
+  const int_t dim = data_.size();
+#pragma omp parallel for if (omp_threads_managed() > 1)                        \
+    num_threads(omp_threads_managed())
+  for (int_t r = 0; r < dim; ++r)
+    if (Utils::popcount(basis_[r] & z_mask) & 1)
+      data_[r] *= p;
+}
+
+template <typename data_t>
+double
+SubspaceVector<data_t>::apply_rotations(const std::vector<Rotation> &rots) {
+  if (rots.empty())
+    return 0.;
+  const uint_t pair = rots[0].x | rots[0].y;
+  const uint_t num_rots = rots.size();
+
+  // On a pair (i, j = i ^ pair) the Pauli acts as P|i> = s(i) i^ny |j> with
+  // s(i) = (-1)^|i & (y | z)|, and s(j) = (-1)^ny s(i), so a rotation is
+  //   u' = a u + (-1)^ny s(i) b v,  v' = s(i) b u + a v
+  // with a = e^{i theta/2} cos(theta/2), b = -i e^{i theta/2} sin(theta/2) i^ny
+  std::vector<std::complex<double>> a(num_rots), b(num_rots);
+  reg_t yz(num_rots);
+  std::vector<bool> odd_y(num_rots);
+  const std::complex<double> i_pow[4] = {1., {0., 1.}, -1., {0., -1.}};
+  for (uint_t k = 0; k < num_rots; ++k) {
+    const auto &rot = rots[k];
+    const auto g = std::exp(std::complex<double>(0., rot.theta / 2));
+    const uint_t num_y = Utils::popcount(rot.y);
+    a[k] = g * std::cos(rot.theta / 2);
+    b[k] = std::complex<double>(0., -1.) * g * std::sin(rot.theta / 2) *
+           i_pow[num_y & 3];
+    yz[k] = rot.y | rot.z;
+    odd_y[k] = num_y & 1;
+  }
+
+  const int_t dim = data_.size();
+  double leak = 0.;
+
+  if (pair == 0) {
+    // Diagonal rotations: P|i> = s(i)|i>
+#pragma omp parallel for if (omp_threads_managed() > 1)                        \
+    num_threads(omp_threads_managed())
+    for (int_t r = 0; r < dim; ++r) {
+      const uint_t i = basis_[r];
+      std::complex<double> u = data_[r];
+      for (uint_t k = 0; k < num_rots; ++k)
+        u *= (Utils::popcount(i & yz[k]) & 1) ? a[k] - b[k] : a[k] + b[k];
+      data_[r] = u;
+    }
+    return leak;
+  }
+
+#pragma omp parallel for if (omp_threads_managed() > 1)                        \
+    num_threads(omp_threads_managed()) reduction(+ : leak)
+  for (int_t r = 0; r < dim; ++r) {
+    const uint_t i = basis_[r];
+    const uint_t j = i ^ pair;
+    const uint_t rj = rank(j);
+    const bool in_sector = ((int_t)rj < dim);
+    // Pairs in the sector are updated once, from the smaller basis state
+    if (in_sector && j < i)
+      continue;
+
+    std::complex<double> u = data_[r];
+    std::complex<double> v = in_sector ? std::complex<double>(data_[rj]) : 0.;
+    for (uint_t k = 0; k < num_rots; ++k) {
+      const auto s = (Utils::popcount(i & yz[k]) & 1) ? -b[k] : b[k];
+      const auto u_new = a[k] * u + (odd_y[k] ? -s : s) * v;
+      v = s * u + a[k] * v;
+      u = u_new;
+    }
+    data_[r] = u;
+    if (in_sector)
+      data_[rj] = v;
+    else
+      leak += std::norm(v);
+  }
+  return leak;
+}
+
+//============================================================================
+// Implementation: Measurement
+//============================================================================
+
+template <typename data_t>
+double SubspaceVector<data_t>::norm() const {
+  double val = 0.;
+  const int_t dim = data_.size();
+#pragma omp parallel for if (omp_threads_managed() > 1)                        \
+    num_threads(omp_threads_managed()) reduction(+ : val)
+  for (int_t r = 0; r < dim; ++r)
+    val += std::norm(data_[r]);
+  return val;
+}
+
+template <typename data_t>
+std::vector<double>
+SubspaceVector<data_t>::expval_pauli_masks(const reg_t &x_masks,
+                                           const reg_t &z_masks) const {
+  std::vector<double> vals(x_masks.size(), 0.);
+  std::map<uint_t, std::vector<uint_t>> groups;
+  for (uint_t t = 0; t < x_masks.size(); ++t)
+    groups[x_masks[t]].push_back(t);
+
+  // <P> = sum_i Re(i^ny (-1)^|i & z| conj(data[i ^ x]) data[i]), where only
+  // pairs with both basis states in the sector contribute
+  const std::complex<double> i_pow[4] = {1., {0., 1.}, -1., {0., -1.}};
+  const int_t dim = data_.size();
+  for (const auto &group : groups) {
+    const uint_t x_mask = group.first;
+    const auto &terms = group.second;
+    const uint_t num_terms = terms.size();
+    std::vector<std::complex<double>> phases(num_terms);
+    for (uint_t t = 0; t < num_terms; ++t)
+      phases[t] = i_pow[Utils::popcount(x_mask & z_masks[terms[t]]) & 3];
+
+#pragma omp parallel if (omp_threads_managed() > 1)                            \
+    num_threads(omp_threads_managed())
+    {
+      std::vector<double> acc(num_terms, 0.);
+#pragma omp for
+      for (int_t r = 0; r < dim; ++r) {
+        const uint_t i = basis_[r];
+        const uint_t rj = x_mask ? rank(i ^ x_mask) : r;
+        if ((int_t)rj >= dim)
+          continue;
+        const std::complex<double> c =
+            std::conj(std::complex<double>(data_[rj])) *
+            std::complex<double>(data_[r]);
+        for (uint_t t = 0; t < num_terms; ++t) {
+          const double val = std::real(phases[t] * c);
+          acc[t] += (Utils::popcount(i & z_masks[terms[t]]) & 1) ? -val : val;
+        }
+      }
+#pragma omp critical
+      for (uint_t t = 0; t < num_terms; ++t)
+        vals[terms[t]] += acc[t];
+    }
+  }
+  return vals;
+}
+
+template <typename data_t>
+AER::Vector<std::complex<data_t>>
+SubspaceVector<data_t>::copy_to_vector() const {
+  AER::Vector<std::complex<data_t>> ret(1ULL << num_qubits_);
+  for (uint_t r = 0; r < data_.size(); ++r)
+    ret[basis_[r]] = data_[r];
+  return ret;
+}
+
+//------------------------------------------------------------------------------
+} // end namespace QV
+} // end namespace AER
+//------------------------------------------------------------------------------
+#endif // end module
@@ -19,6 +19,7 @@
 
 #include "framework/avx2_detect.hpp"
 #include "framework/config.hpp"
+#include "framework/trace.hpp"
 #include "simulators/superoperator/superoperator_state.hpp"
 #include "simulators/unitary/unitary_state.hpp"
 #include "transpile/circuitopt.hpp"
@@ -49,6 +50,12 @@ public:
       arg_qubits[i] = i;
     }
 
+    // Pauli rotations are fused as unitary matrices, converted before the
+    // qubits are remapped as their masks refer to circuit qubits //SW
+    for (auto &op : fusioned_ops)
+      if (is_mosq(op))
+        op = mosq_matrix(op);
+
     // Remap qubits
     for (auto &op : fusioned_ops)
       for (size_t i = 0; i < op.qubits.size(); i++)
@@ -131,6 +138,22 @@ public:
                                    const bool allow_superop,
                                    const bool allow_kraus);
 
+  //SW
+  // MOSQ and MOSQ_CR Pauli rotations are applied by their own statevector
+  // kernels and are converted to unitary matrices only when they are fused
+  static bool is_mosq(const op_t &op) {
+    return op.type == optype_t::gate &&
+           (op.name == "MOSQ" || op.name == "MOSQ_CR");
+  }
+
+  // A Pauli rotation can be fused if its masks are within its qubits. Its
+  // number of qubits is not limited, so that runs of operations are not
+  // split at rotations; fusers check the number of fused qubits.
+  static bool can_apply_mosq(const op_t &op);
+
+  // Unitary matrix op of a Pauli rotation, one matrix per bound parameter
+  static op_t mosq_matrix(const op_t &op);
+
   static bool exist_non_unitary(const std::vector<op_t> &fusioned_ops) {
     for (auto &op : fusioned_ops)
       if (noise_opset_.contains(op.type))
@@ -150,6 +173,68 @@ const Operations::OpSet FusionMethod::noise_opset_({Operations::OpType::kraus,
                                                     Operations::OpType::reset},
                                                    {});
 
+bool FusionMethod::can_apply_mosq(const op_t &op) {
+  if (op.name == "MOSQ")
+    return true;
+  if (op.int_params.size() != 3)
+    return false;
+  uint_t qubits_mask = 0;
+  for (const auto q : op.qubits)
+    qubits_mask |= (1ULL << q);
+  const uint_t masks = op.int_params[0] | op.int_params[1] | op.int_params[2];
+  return (masks & ~qubits_mask) == 0;
+}
+
+op_t FusionMethod::mosq_matrix(const op_t &op) {
+  // Per qubit Pauli: 0 = I, 1 = X, 2 = Y, 3 = Z
+  const uint_t num_qubits = op.qubits.size();
+  std::vector<int> paulis(num_qubits, 3);
+  if (op.name == "MOSQ_CR") {
+    for (uint_t i = 0; i < num_qubits; ++i) {
+      const uint_t bit = 1ULL << op.qubits[i];
+      paulis[i] = (op.int_params[0] & bit)   ? 1
+                  : (op.int_params[1] & bit) ? 2
+                  : (op.int_params[2] & bit) ? 3
+                                             : 0;
+    }
+  }
+
+  // P|b> = amps[b] |b ^ flip>
+  const uint_t dim = 1ULL << num_qubits;
+  uint_t flip = 0;
+  for (uint_t i = 0; i < num_qubits; ++i)
+    if (paulis[i] == 1 || paulis[i] == 2)
+      flip |= (1ULL << i);
+  std::vector<complex_t> amps(dim, 1.);
+  for (uint_t b = 0; b < dim; ++b) {
+    for (uint_t i = 0; i < num_qubits; ++i) {
+      const bool one = (b >> i) & 1;
+      if (paulis[i] == 2)
+        amps[b] *= one ? complex_t(0., -1.) : complex_t(0., 1.);
+      else if (paulis[i] == 3 && one)
+        amps[b] = -amps[b];
+    }
+  }
+
+  // MOSQ_CR(theta) = (1 + e^{i theta}) / 2 + (1 - e^{i theta}) / 2 P
+  op_t mat_op;
+  for (const auto &theta : op.params) {
+    const complex_t phase = std::exp(complex_t(0., 1.) * theta);
+    cmatrix_t mat(dim, dim);
+    for (uint_t b = 0; b < dim; ++b) {
+      mat(b, b) += 0.5 * (1. + phase);
+      mat(b ^ flip, b) += 0.5 * (1. - phase) * amps[b];
+    }
+    if (mat_op.mats.empty())
+      mat_op = Operations::make_unitary(op.qubits, std::move(mat),
+                                        std::string("fusion"));
+    else
+      mat_op.mats.push_back(std::move(mat));
+  }
+  mat_op.has_bind_params = op.has_bind_params;
+  return mat_op;
+} //SW
+
 class UnitaryFusion : public FusionMethod {
 public:
   virtual std::string name() override { return "unitary"; };
@@ -182,6 +267,8 @@ public:
     case optype_t::diagonal_matrix:
       return op.qubits.size() <= max_fused_qubits;
     case optype_t::gate: {
+      if (is_mosq(op))
+        return can_apply_mosq(op); //SW
       if (op.qubits.size() > max_fused_qubits)
         return false;
       return QubitUnitary::StateOpSet.contains_gates(op.name);
@@ -230,6 +317,8 @@ public:
       return op.qubits.size() <= max_fused_qubits;
     }
     case optype_t::gate: {
+      if (is_mosq(op))
+        return can_apply_mosq(op); //SW
       if (op.qubits.size() > max_fused_qubits)
         return false;
       return QubitSuperoperator::StateOpSet.contains_gates(op.name);
@@ -280,6 +369,8 @@ public:
       return op.qubits.size() <= max_fused_qubits;
     }
     case optype_t::gate: {
+      if (is_mosq(op))
+        return can_apply_mosq(op); //SW
       if (op.qubits.size() > max_fused_qubits)
         return false;
       return QubitSuperoperator::StateOpSet.contains_gates(op.name);
@@ -361,6 +452,9 @@ public:
                                     const uint_t max_fused_qubits,
                                     const FusionMethod &method) const override;
 
+  // Estimated cost of a fused non-diagonal operation on num_qubits qubits
+  double fused_cost(const uint_t num_qubits) const; //SW
+
 private:
   bool is_diagonal(const oplist_t &ops, const uint_t from,
                    const uint_t until) const;
@@ -557,6 +651,11 @@ bool DiagonalFusion::is_diagonal_op(const op_t &op) const {
         op.name == "cu1" || op.name == "mcu1" || op.name == "rz" ||
         op.name == "rzz")
       return true;
+    // Z string Pauli rotations //SW
+    if (op.name == "MOSQ")
+      return true;
+    if (op.name == "MOSQ_CR")
+      return (op.int_params[0] | op.int_params[1]) == 0;
     if (op.name == "u3")
       return op.params[0] == std::complex<double>(0.) &&
              op.params[1] == std::complex<double>(0.);
@@ -575,8 +674,6 @@ bool DiagonalFusion::is_diagonal_op(const op_t &op) const {
 int DiagonalFusion::get_next_diagonal_end(
     const oplist_t &ops, const int from, const int end,
     std::set<uint_t> &fusing_qubits) const {
-  //SW
-  return -1;
 
   if (is_diagonal_op(ops[from])) {
     for (const auto qubit : ops[from].qubits)
@@ -727,6 +824,244 @@ bool DiagonalFusion::aggregate_operations(oplist_t &ops, const int fusion_start,
   return true;
 }
 
+//SW
+// Aggregation rules for MOSQ and MOSQ_CR Pauli rotations.
+//
+// 1. A rotation absorbs the later rotations with the same Pauli string that
+//    it commutes past, summing their angles, and is dropped if the angles
+//    sum to zero.
+// 2. The single-qubit gates next to a rotation on at most max_fused_qubits
+//    qubits are folded with it into a dense matrix if the cost model says
+//    that one dense pass is cheaper than the rotation pass and the gate
+//    passes applied separately.
+class MOSQFusion : public Fuser {
+public:
+  MOSQFusion() = default;
+
+  virtual std::string name() const override { return "mosq"; };
+
+  virtual void set_config(const Config &config) override;
+
+  virtual void set_metadata(ExperimentResult &result) const override;
+
+  virtual bool aggregate_operations(oplist_t &ops, const int fusion_start,
+                                    const int fusion_end,
+                                    const uint_t max_fused_qubits,
+                                    const FusionMethod &method) const override;
+
+private:
+  // Whether op has parameters tagged by a session, which are bound later and
+  // can neither be summed nor folded into a matrix
+  static bool has_tagged_params(const op_t &op);
+
+  // Symplectic X and Z bits of a rotation whose angles can be summed
+  bool rotation_pauli(const op_t &op, uint_t &x, uint_t &z) const;
+
+  // Whether op commutes with the Pauli string (x, z)
+  bool commutes(const op_t &op, const uint_t x, const uint_t z) const;
+
+  bool merge_rotations(oplist_t &ops, const int fusion_start,
+                       const int fusion_end, const FusionMethod &method) const;
+
+  bool fold_single_qubit_gates(oplist_t &ops, const int fusion_start,
+                               const int fusion_end,
+                               const uint_t max_fused_qubits,
+                               const FusionMethod &method) const;
+
+  // Collect the single-qubit gates on qubits next to ops[idx] going in
+  // direction step (-1 or 1)
+  void collect_single_qubit_gates(const oplist_t &ops, const int idx,
+                                  const int step, const int fusion_start,
+                                  const int fusion_end,
+                                  const FusionMethod &method,
+                                  std::vector<uint_t> &idxs) const;
+
+  bool active = true;
+  // Cost of a rotation pass and of an unfused gate pass, in the unit of the
+  // cost based fusion
+  double mosq_cost = 1.0;
+  double cost_factor = 1.8;
+  // Number of operations searched for a rotation with the same Pauli string
+  int max_distance = 256;
+  CostBasedFusion cost_model_;
+};
+
+void MOSQFusion::set_config(const Config &config) {
+  if (config._fusion_enable_mosq.has_value())
+    active = config._fusion_enable_mosq.value();
+  if (config._fusion_mosq_cost.has_value())
+    mosq_cost = config._fusion_mosq_cost.value();
+  if (config.fusion_cost_factor.has_value())
+    cost_factor = config.fusion_cost_factor.value();
+  cost_model_.set_config(config);
+}
+
+void MOSQFusion::set_metadata(ExperimentResult &result) const {
+  result.metadata.add(mosq_cost, "fusion", "mosq_cost");
+}
+
+bool MOSQFusion::has_tagged_params(const op_t &op) {
+  for (const auto &param : op.params)
+    if (std::isnan(std::real(param)))
+      return true;
+  return false;
+}
+
+bool MOSQFusion::rotation_pauli(const op_t &op, uint_t &x, uint_t &z) const {
+  if (!FusionMethod::is_mosq(op) || op.conditional || has_tagged_params(op))
+    return false;
+  if (op.name == "MOSQ") {
+    x = 0;
+    z = 0;
+    for (const auto q : op.qubits)
+      z ^= (1ULL << q);
+  } else {
+    x = op.int_params[0] | op.int_params[1];
+    z = op.int_params[2] | op.int_params[1];
+  }
+  return true;
+}
+
+bool MOSQFusion::commutes(const op_t &op, const uint_t x, const uint_t z) const {
+  uint_t op_x, op_z;
+  if (rotation_pauli(op, op_x, op_z))
+    return (Utils::popcount((x & op_z) ^ (z & op_x)) & 1) == 0;
+
+  uint_t qubits_mask = 0;
+  for (const auto q : op.qubits)
+    qubits_mask |= (1ULL << q);
+  if ((qubits_mask & (x | z)) == 0)
+    return true;
+
+  // Diagonal gates commute with Z strings
+  if (x != 0)
+    return false;
+  if (op.type == optype_t::diagonal_matrix)
+    return true;
+  if (op.type != optype_t::gate)
+    return false;
+  static const stringset_t diagonal_gates(
+      {"p", "cp", "u1", "cu1", "mcu1", "rz", "rzz", "z", "cz", "s", "sdg", "t",
+       "tdg", "MOSQ"});
+  if (diagonal_gates.find(op.name) != diagonal_gates.end())
+    return true;
+  return op.name == "MOSQ_CR" && (op.int_params[0] | op.int_params[1]) == 0;
+}
+
+bool MOSQFusion::merge_rotations(oplist_t &ops, const int fusion_start,
+                                 const int fusion_end,
+                                 const FusionMethod &method) const {
+  bool merged = false;
+  for (int i = fusion_start; i < fusion_end; ++i) {
+    uint_t x, z;
+    if (ops[i].type == optype_t::nop || !rotation_pauli(ops[i], x, z))
+      continue;
+
+    bool absorbed = false;
+    const int end = std::min(fusion_end, i + 1 + max_distance);
+    for (int j = i + 1; j < end; ++j) {
+      if (ops[j].type == optype_t::nop || method.can_ignore(ops[j]))
+        continue;
+      uint_t op_x, op_z;
+      if (rotation_pauli(ops[j], op_x, op_z) && op_x == x && op_z == z) {
+        // Sum the angles, per binding with runtime parameter binding
+        auto &params = ops[i].params;
+        const auto &other = ops[j].params;
+        if (other.size() > params.size())
+          params.resize(other.size(), params[0]);
+        for (uint_t p = 0; p < params.size(); ++p)
+          params[p] += other[other.size() > 1 ? p : 0];
+        ops[i].has_bind_params |= ops[j].has_bind_params;
+        ops[j].type = optype_t::nop;
+        absorbed = true;
+        continue;
+      }
+      if (!commutes(ops[j], x, z))
+        break;
+    }
+    if (!absorbed)
+      continue;
+    merged = true;
+
+    // MOSQ_CR(0) is the identity
+    bool identity = true;
+    for (const auto &param : ops[i].params)
+      identity &= (param == complex_t(0.));
+    if (identity)
+      ops[i].type = optype_t::nop;
+  }
+  return merged;
+}
+
+void MOSQFusion::collect_single_qubit_gates(
+    const oplist_t &ops, const int idx, const int step, const int fusion_start,
+    const int fusion_end, const FusionMethod &method,
+    std::vector<uint_t> &idxs) const {
+  // Qubits of the rotation not blocked by another operation yet
+  std::set<uint_t> open(ops[idx].qubits.begin(), ops[idx].qubits.end());
+  for (int j = idx + step; j >= fusion_start && j < fusion_end && !open.empty();
+       j += step) {
+    const auto &op = ops[j];
+    if (op.type == optype_t::nop || method.can_ignore(op))
+      continue;
+    bool overlap = false;
+    for (const auto q : op.qubits)
+      overlap |= (open.find(q) != open.end());
+    if (!overlap)
+      continue;
+    if (op.qubits.size() == 1 && !FusionMethod::is_mosq(op) &&
+        !has_tagged_params(op) && method.can_apply(op, 1)) {
+      idxs.push_back(j);
+      continue;
+    }
+    for (const auto q : op.qubits)
+      open.erase(q);
+  }
+}
+
+bool MOSQFusion::fold_single_qubit_gates(oplist_t &ops,
+                                         const int fusion_start,
+                                         const int fusion_end,
+                                         const uint_t max_fused_qubits,
+                                         const FusionMethod &method) const {
+  bool folded = false;
+  for (int i = fusion_start; i < fusion_end; ++i) {
+    if (ops[i].type == optype_t::nop || !FusionMethod::is_mosq(ops[i]) ||
+        ops[i].qubits.size() > max_fused_qubits || has_tagged_params(ops[i]))
+      continue;
+
+    std::vector<uint_t> idxs = {(uint_t)i};
+    collect_single_qubit_gates(ops, i, -1, fusion_start, fusion_end, method,
+                               idxs);
+    collect_single_qubit_gates(ops, i, 1, fusion_start, fusion_end, method,
+                               idxs);
+    if (idxs.size() == 1)
+      continue;
+
+    const double separate = mosq_cost + (idxs.size() - 1) * cost_factor;
+    if (cost_model_.fused_cost(ops[i].qubits.size()) >= separate)
+      continue;
+
+    std::sort(idxs.begin(), idxs.end());
+    allocate_new_operation(ops, i, idxs, method, false);
+    folded = true;
+  }
+  return folded;
+}
+
+bool MOSQFusion::aggregate_operations(oplist_t &ops, const int fusion_start,
+                                      const int fusion_end,
+                                      const uint_t max_fused_qubits,
+                                      const FusionMethod &method) const {
+  if (!active)
+    return false;
+
+  const bool merged = merge_rotations(ops, fusion_start, fusion_end, method);
+  const bool folded = fold_single_qubit_gates(ops, fusion_start, fusion_end,
+                                              max_fused_qubits, method);
+  return merged || folded;
+} //SW
+
 class Fusion : public CircuitOptimization {
 public:
   // constructor
@@ -742,6 +1077,10 @@ public:
    *       than to enable fusion optimization [Default: 14]
    * - fusion_cost_factor (double): a cost function to estimate an aggregate
    *       gate [Default: 1.8]
+   * - _fusion_enable_mosq (bool): Enable the aggregation of MOSQ and MOSQ_CR
+   *       Pauli rotations [Default: True]
+   * - _fusion_mosq_cost (double): cost of a Pauli rotation pass relative to
+   *       an aggregate gate [Default: 1.0]
    */
   Fusion();
 
@@ -813,6 +1152,7 @@ private:
 };
 
 Fusion::Fusion() {
+  fusers.push_back(std::make_shared<MOSQFusion>()); //SW
   fusers.push_back(std::make_shared<DiagonalFusion>());
   fusers.push_back(std::make_shared<NQubitFusion<1>>());
   fusers.push_back(std::make_shared<NQubitFusion<2>>());
@@ -832,8 +1172,8 @@ void Fusion::set_config(const Config &config) {
   if (config.fusion_threshold.has_value())
     threshold = config.fusion_threshold.value();
 
-  // for (std::shared_ptr<Fuser> &fuser : fusers)
-  //   fuser->set_config(config);
+  for (std::shared_ptr<Fuser> &fuser : fusers)
+    fuser->set_config(config);
 
   if (config.fusion_allow_kraus.has_value())
     allow_kraus = config.fusion_allow_kraus.value();
@@ -843,11 +1183,6 @@ void Fusion::set_config(const Config &config) {
 
   if (config.fusion_parallelization_threshold.has_value())
     parallel_threshold_ = config.fusion_parallelization_threshold.value();
-
-  //SW
-  active = false;
-  max_qubit = 0;
-  threshold = 0;
 }
 
 void Fusion::optimize_circuit(Circuit &circ, Noise::NoiseModel &noise,
@@ -859,99 +1194,104 @@ void Fusion::optimize_circuit(Circuit &circ, Noise::NoiseModel &noise,
   dump(circ);
 #endif
 
-  //SW
-  //skip fusion
-  result.metadata.add(false, "fusion", "enabled");
-  return;
-
-  // // Start timer
-  // using clock_t = std::chrono::high_resolution_clock;
-  // auto timer_start = clock_t::now();
-
-  // // Check if fusion should be skipped
-  // if (!active || !allowed_opset.contains(optype_t::matrix)) {
-  //   result.metadata.add(false, "fusion", "enabled");
-  //   return;
-  // }
-
-//   result.metadata.add(true, "fusion", "enabled");
-//   result.metadata.add(threshold, "fusion", "threshold");
-//   result.metadata.add(max_qubit, "fusion", "max_fused_qubits");
-
-//   // Check qubit threshold
-//   if (circ.num_qubits <= threshold || circ.ops.size() < 2) {
-//     result.metadata.add(false, "fusion", "applied");
-//     return;
-//   }
-
-//   // Determine fusion method
-//   FusionMethod &method = FusionMethod::find_method(circ, allowed_opset,
-//                                                    allow_superop, allow_kraus);
-//   result.metadata.add(method.name(), "fusion", "method");
-
-//   method.set_num_params(circ.num_bind_params);
-
-//   bool applied = false;
-//   for (const std::shared_ptr<Fuser> &fuser : fusers) {
-//     fuser->set_metadata(result);
-
-//     if (circ.ops.size() < parallel_threshold_ || parallelization_ <= 1) {
-//       optimize_circuit(circ, noise, allowed_opset, 0, circ.ops.size(), fuser,
-//                        method);
-//       result.metadata.add(1, "fusion", "parallelization");
-//     } else {
-//       // determine unit for each OMP thread
-//       int_t unit = circ.ops.size() / parallelization_;
-//       if (circ.ops.size() % parallelization_)
-//         ++unit;
-
-//       if (parallelization_ > 1) {
-// #pragma omp parallel for num_threads(parallelization_)
-//         for (int_t i = 0; i < (int_t)parallelization_; i++) {
-//           int_t start = unit * i;
-//           int_t end = std::min(start + unit, (int_t)circ.ops.size());
-//           optimize_circuit(circ, noise, allowed_opset, start, end, fuser,
-//                            method);
-//         }
-//       } else {
-//         for (uint_t i = 0; i < parallelization_; i++) {
-//           int_t start = unit * i;
-//           int_t end = std::min(start + unit, (int_t)circ.ops.size());
-//           optimize_circuit(circ, noise, allowed_opset, start, end, fuser,
-//                            method);
-//         }
-//       }
-//       result.metadata.add(parallelization_, "fusion", "parallelization");
-//     }
-
-//     size_t idx = 0;
-//     for (size_t i = 0; i < circ.ops.size(); ++i) {
-//       if (circ.ops[i].type != optype_t::nop) {
-//         if (i != idx)
-//           circ.ops[idx] = circ.ops[i];
-//         ++idx;
-//       }
-//     }
-
-//     if (idx != circ.ops.size()) {
-//       applied = true;
-//       circ.ops.erase(circ.ops.begin() + idx, circ.ops.end());
-//       circ.set_params();
-//     }
-
-// #ifdef DEBUG
-//     std::cout << fuser->name() << std::endl;
-//     dump(circ);
-// #endif
-//   }
-//   result.metadata.add(applied, "fusion", "applied");
-//   if (applied && verbose)
-//     result.metadata.add(circ.ops, "fusion", "output_ops");
-
-//   auto timer_stop = clock_t::now();
-//   result.metadata.add(
-//       std::chrono::duration<double>(timer_stop - timer_start).count(), "fusion",
-//       "time_taken");
+  // Start timer
+  using clock_t = std::chrono::high_resolution_clock;
+  auto timer_start = clock_t::now();
+
+  // Check if fusion should be skipped
+  if (!active || !allowed_opset.contains(optype_t::matrix)) {
+    result.metadata.add(false, "fusion", "enabled");
+    return;
+  }
+
+  Tracing::Span span("transpile", "fusion"); //SW
+  result.metadata.add(true, "fusion", "enabled");
+  result.metadata.add(threshold, "fusion", "threshold");
+  result.metadata.add(max_qubit, "fusion", "max_fused_qubits");
+
+  // Check qubit threshold
+  if (circ.num_qubits <= threshold || circ.ops.size() < 2) {
+    result.metadata.add(false, "fusion", "applied");
+    return;
+  }
+
+  // A gradient has one entry per Pauli rotation in applied order, which
+  // merging or fusing the rotations would lose
+  if (std::any_of(circ.ops.cbegin(), circ.ops.cend(), [](const op_t &op) {
+        return op.type == optype_t::save_energy_gradient;
+      })) {
+    result.metadata.add(false, "fusion", "applied");
+    return;
+  } //SW
+
+  // Determine fusion method
+  FusionMethod &method = FusionMethod::find_method(circ, allowed_opset,
+                                                   allow_superop, allow_kraus);
+  result.metadata.add(method.name(), "fusion", "method");
+
+  method.set_num_params(circ.num_bind_params);
+
+  bool applied = false;
+  for (const std::shared_ptr<Fuser> &fuser : fusers) {
+    fuser->set_metadata(result);
+
+    if (circ.ops.size() < parallel_threshold_ || parallelization_ <= 1) {
+      optimize_circuit(circ, noise, allowed_opset, 0, circ.ops.size(), fuser,
+                       method);
+      result.metadata.add(1, "fusion", "parallelization");
+    } else {
+      // determine unit for each OMP thread
+      int_t unit = circ.ops.size() / parallelization_;
+      if (circ.ops.size() % parallelization_)
+        ++unit;
+
+      if (parallelization_ > 1) {
+#pragma omp parallel for num_threads(parallelization_)
+        for (int_t i = 0; i < (int_t)parallelization_; i++) {
+          int_t start = unit * i;
+          int_t end = std::min(start + unit, (int_t)circ.ops.size());
+          optimize_circuit(circ, noise, allowed_opset, start, end, fuser,
+                           method);
+        }
+      } else {
+        for (uint_t i = 0; i < parallelization_; i++) {
+          int_t start = unit * i;
+          int_t end = std::min(start + unit, (int_t)circ.ops.size());
+          optimize_circuit(circ, noise, allowed_opset, start, end, fuser,
+                           method);
+        }
+      }
+      result.metadata.add(parallelization_, "fusion", "parallelization");
+    }
+
+    size_t idx = 0;
+    for (size_t i = 0; i < circ.ops.size(); ++i) {
+      if (circ.ops[i].type != optype_t::nop) {
+        if (i != idx)
+          circ.ops[idx] = circ.ops[i];
+        ++idx;
+      }
+    }
+
+    if (idx != circ.ops.size()) {
+      applied = true;
+      circ.ops.erase(circ.ops.begin() + idx, circ.ops.end());
+      circ.set_params();
+    }
+
+#ifdef DEBUG
+    std::cout << fuser->name() << std::endl;
+    dump(circ);
+#endif
+  }
+  result.metadata.add(applied, "fusion", "applied");
+  if (applied && verbose)
+    result.metadata.add(circ.ops, "fusion", "output_ops");
+
+  auto timer_stop = clock_t::now();
+  result.metadata.add(
+      std::chrono::duration<double>(timer_stop - timer_start).count(), "fusion",
+      "time_taken");
 }
 
 void Fusion::optimize_circuit(Circuit &circ, const Noise::NoiseModel &noise,
@@ -1106,6 +1446,11 @@ bool CostBasedFusion::is_diagonal(const std::vector<op_t> &ops,
     }
     if (ops[i].name == "u1" || ops[i].name == "cu1" || ops[i].name == "cp")
       continue;
+    // Z string Pauli rotations //SW
+    if (ops[i].name == "MOSQ" ||
+        (ops[i].name == "MOSQ_CR" &&
+         (ops[i].int_params[0] | ops[i].int_params[1]) == 0))
+      continue;
     return false;
   }
   return true;
@@ -1121,12 +1466,16 @@ double CostBasedFusion::estimate_cost(const std::vector<op_t> &ops,
   for (uint_t i = from; i <= until; ++i)
     add_fusion_qubits(fusion_qubits, ops[i]);
 
-  auto configured_cost = costs_[fusion_qubits.size() - 1];
+  return fused_cost(fusion_qubits.size());
+}
+
+double CostBasedFusion::fused_cost(const uint_t num_qubits) const {
+  auto configured_cost = costs_[num_qubits - 1];
   if (configured_cost > 0)
     return configured_cost;
 
   if (is_avx2_supported()) {
-    switch (fusion_qubits.size()) {
+    switch (num_qubits) {
     case 1:
       // [[ falling through :) ]]
     case 2:
@@ -1136,12 +1485,10 @@ double CostBasedFusion::estimate_cost(const std::vector<op_t> &ops,
     case 4:
       return 3;
     default:
-      return pow(cost_factor,
-                 (double)std::max(fusion_qubits.size() - 2, size_t(1)));
+      return pow(cost_factor, (double)std::max(num_qubits - 2, uint_t(1)));
     }
   }
-  return pow(cost_factor,
-             (double)std::max(fusion_qubits.size() - 1, size_t(1)));
+  return pow(cost_factor, (double)std::max(num_qubits - 1, uint_t(1)));
 }
 
 void CostBasedFusion::add_fusion_qubits(reg_t &fusion_qubits,
@@ -0,0 +1,205 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_transpile_mosq_block_hpp_
+#define _aer_transpile_mosq_block_hpp_
+
+#include <chrono>
+
+#include "framework/config.hpp"
+#include "framework/trace.hpp"
+#include "transpile/circuitopt.hpp"
+
+namespace AER {
+namespace Transpile {
+
+//SW
+// Merge runs of consecutive MOSQ_CR / MOSQ Pauli rotations into MOSQ_BLOCK
+// operations. The rotations of a block only couple amplitudes that differ in
+// the union of their X/Y bits (the pair qubits), so the statevector kernel
+// applies a whole block in one pass over cache resident groups of amplitudes.
+//
+// A MOSQ_BLOCK operation stores one angle per rotation in params and the
+// Pauli masks [X_idx, Y_idx, Z_idx] of each rotation in int_params, as for
+// MOSQ_CR, and acts on the union of the qubits of its rotations.
+class MOSQBlocking : public CircuitOptimization {
+public:
+  /*
+   * MOSQ blocking uses following configuration options
+   * - mosq_block_enable (bool): Enable MOSQ blocking [Default: False]
+   * - mosq_block_max_qubit (int): Maximum number of pair qubits of a
+   *       MOSQ_BLOCK operation [Default: 10]
+   */
+  void set_config(const Config &config) override;
+
+  void optimize_circuit(Circuit &circ, Noise::NoiseModel &noise,
+                        const opset_t &allowed_opset,
+                        ExperimentResult &result) const override;
+
+  uint_t max_qubit = 10;
+  // Minimum number of rotations to form a block
+  uint_t min_ops = 2;
+
+  bool active = true;
+
+private:
+  bool can_block(const op_t &op) const;
+
+  // Union of the X and Y bits of a rotation
+  uint_t pair_mask(const op_t &op) const;
+
+  // Pauli masks [X_idx, Y_idx, Z_idx] of a rotation
+  void add_masks(const op_t &op, reg_t &masks) const;
+
+  op_t generate_operation(const oplist_t &ops, const uint_t from,
+                          const uint_t until, const uint_t num_params) const;
+};
+
+void MOSQBlocking::set_config(const Config &config) {
+  CircuitOptimization::set_config(config);
+
+  active = config.mosq_block_enable;
+
+  if (config.mosq_block_max_qubit.has_value())
+    max_qubit = config.mosq_block_max_qubit.value();
+}
+
+bool MOSQBlocking::can_block(const op_t &op) const {
+  if (op.type != optype_t::gate || op.conditional)
+    return false;
+  return op.name == "MOSQ_CR" || op.name == "MOSQ";
+}
+
+uint_t MOSQBlocking::pair_mask(const op_t &op) const {
+  if (op.name == "MOSQ")
+    return 0;
+  return op.int_params[0] | op.int_params[1];
+}
+
+void MOSQBlocking::add_masks(const op_t &op, reg_t &masks) const {
+  if (op.name == "MOSQ") {
+    // Diagonal rotation on the parity of the qubits
+    uint_t z_mask = 0;
+    for (const auto q : op.qubits)
+      z_mask ^= (1ULL << q);
+    masks.insert(masks.end(), {0, 0, z_mask});
+    return;
+  }
+  masks.insert(masks.end(), op.int_params.begin(), op.int_params.end());
+}
+
+op_t MOSQBlocking::generate_operation(const oplist_t &ops, const uint_t from,
+                                      const uint_t until,
+                                      const uint_t num_params) const {
+  op_t op;
+  op.type = optype_t::gate;
+  op.name = "MOSQ_BLOCK";
+
+  std::set<uint_t> qubits;
+  bool bind_params = false;
+  for (uint_t i = from; i < until; ++i) {
+    qubits.insert(ops[i].qubits.begin(), ops[i].qubits.end());
+    bind_params |= ops[i].has_bind_params;
+  }
+  op.qubits.assign(qubits.begin(), qubits.end());
+
+  // With runtime parameter binding the angles of every binding are stored
+  // one after the other, as for the fused rotations. The masks are shared.
+  const uint_t num_bindings = bind_params ? num_params : 1;
+  op.params.reserve((until - from) * num_bindings);
+  for (uint_t p = 0; p < num_bindings; ++p)
+    for (uint_t i = from; i < until; ++i)
+      op.params.push_back(ops[i].params[ops[i].has_bind_params ? p : 0]);
+  op.has_bind_params = bind_params;
+
+  op.int_params.reserve(3 * (until - from));
+  for (uint_t i = from; i < until; ++i)
+    add_masks(ops[i], op.int_params);
+  return op;
+}
+
+void MOSQBlocking::optimize_circuit(Circuit &circ, Noise::NoiseModel &noise,
+                                    const opset_t &allowed_opset,
+                                    ExperimentResult &result) const {
+  if (!active || !allowed_opset.contains_gates("MOSQ_BLOCK")) {
+    result.metadata.add(false, "mosq_block", "enabled");
+    return;
+  }
+
+  // Start timer
+  using clock_t = std::chrono::high_resolution_clock;
+  auto timer_start = clock_t::now();
+
+  Tracing::Span span("transpile", "mosq_block"); //SW
+  result.metadata.add(true, "mosq_block", "enabled");
+  result.metadata.add(max_qubit, "mosq_block", "max_qubit");
+
+  auto &ops = circ.ops;
+  uint_t num_blocks = 0;
+  uint_t num_blocked_ops = 0;
+
+  uint_t from = 0;
+  while (from < ops.size()) {
+    if (!can_block(ops[from])) {
+      ++from;
+      continue;
+    }
+    // Extend the run while the pair qubits fit in a block
+    uint_t mask = pair_mask(ops[from]);
+    uint_t until = from + 1;
+    for (; until < ops.size() && can_block(ops[until]); ++until) {
+      const uint_t next = mask | pair_mask(ops[until]);
+      if (Utils::popcount(next) > max_qubit)
+        break;
+      mask = next;
+    }
+
+    if (until - from >= min_ops) {
+      ops[from] = generate_operation(ops, from, until, circ.num_bind_params);
+      for (uint_t i = from + 1; i < until; ++i)
+        ops[i].type = optype_t::nop;
+      ++num_blocks;
+      num_blocked_ops += until - from;
+    }
+    from = until;
+  }
+
+  if (num_blocks > 0) {
+    size_t idx = 0;
+    for (size_t i = 0; i < ops.size(); ++i) {
+      if (ops[i].type != optype_t::nop) {
+        if (i != idx)
+          ops[idx] = std::move(ops[i]);
+        ++idx;
+      }
+    }
+    ops.erase(ops.begin() + idx, ops.end());
+    circ.set_params();
+  }
+
+  result.metadata.add(num_blocks > 0, "mosq_block", "applied");
+  result.metadata.add(num_blocks, "mosq_block", "num_blocks");
+  result.metadata.add(num_blocked_ops, "mosq_block", "num_blocked_ops");
+
+  auto timer_stop = clock_t::now();
+  result.metadata.add(
+      std::chrono::duration<double>(timer_stop - timer_start).count(),
+      "mosq_block", "time_taken");
+}
+
+//-------------------------------------------------------------------------
+} // end namespace Transpile
+} // end namespace AER
+//-------------------------------------------------------------------------
+#endif
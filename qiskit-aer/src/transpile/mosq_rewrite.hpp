@@ -0,0 +1,313 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_transpile_mosq_rewrite_hpp_
+#define _aer_transpile_mosq_rewrite_hpp_
+
+#include <chrono>
+#include <cmath>
+#include <set>
+
+#include "framework/config.hpp"
+#include "framework/trace.hpp"
+#include "transpile/circuitopt.hpp"
+
+namespace AER {
+namespace Transpile {
+
+//SW
+// Rewrite Pauli rotations exp(-i theta/2 P) into MOSQ_CR operations.
+//
+// A decomposed PauliEvolutionGate is an RZ between a Clifford circuit U
+// (basis changes and a CX ladder) and its inverse, U^dagger RZ(theta) U =
+// exp(-i theta/2 U^dagger Z U). For each RZ the pass grows a window of
+// mirrored Clifford gates around it while they change the conjugated Pauli
+// and replaces the window by one MOSQ_CR. Single rx, ry, rz, rxx, ryy, rzz
+// and rzx gates are rewritten as well.
+//
+// MOSQ_CR(theta) = e^{i theta/2} exp(-i theta/2 P), so the rewritten circuit
+// differs by a global phase per rotation. The pass is therefore disabled by
+// default and meant for expectation values and sampling.
+class MOSQRewriting : public CircuitOptimization {
+public:
+  /*
+   * MOSQ rewriting uses following configuration options
+   * - mosq_rewrite_enable (bool): Enable MOSQ rewriting [Default: False]
+   */
+  void set_config(const Config &config) override;
+
+  void optimize_circuit(Circuit &circ, Noise::NoiseModel &noise,
+                        const opset_t &allowed_opset,
+                        ExperimentResult &result) const override;
+
+  bool active = false;
+
+private:
+  // A Pauli i^phase X^x Z^z, bit j referring to qubit j
+  struct Pauli {
+    uint_t x = 0;
+    uint_t z = 0;
+    uint_t phase = 0;
+    bool operator==(const Pauli &other) const {
+      return x == other.x && z == other.z && phase == other.phase;
+    }
+  };
+
+  bool is_gate(const op_t &op) const {
+    return op.type == optype_t::gate && !op.conditional && !op.expr;
+  }
+
+  // Whether right undoes left
+  bool is_inverse(const op_t &left, const op_t &right) const;
+
+  // Conjugate P by a Clifford gate, P <- U^dagger P U. Returns false if the
+  // gate is not a supported Clifford gate.
+  bool conjugate(const op_t &op, Pauli &pauli) const;
+
+  // Pauli of a rotation gate, or false if op is not one
+  bool rotation_pauli(const op_t &op, Pauli &pauli) const;
+
+  // MOSQ_CR of exp(-i theta/2 P) with theta the parameters of rotation, or
+  // false if the Pauli has a negative sign that can not be applied to the
+  // parameters
+  bool generate_operation(const op_t &rotation, const Pauli &pauli,
+                          op_t &op) const;
+};
+
+void MOSQRewriting::set_config(const Config &config) {
+  CircuitOptimization::set_config(config);
+
+  active = config.mosq_rewrite_enable;
+}
+
+bool MOSQRewriting::is_inverse(const op_t &left, const op_t &right) const {
+  if (!is_gate(left) || !is_gate(right) || left.qubits != right.qubits)
+    return false;
+  const auto &l = left.name;
+  const auto &r = right.name;
+  if (l == "s")
+    return r == "sdg";
+  if (l == "sdg")
+    return r == "s";
+  if (l == "sx")
+    return r == "sxdg";
+  if (l == "sxdg")
+    return r == "sx";
+  // Self-inverse gates
+  return l == r && (l == "h" || l == "x" || l == "y" || l == "z" ||
+                    l == "cx" || l == "cz");
+}
+
+bool MOSQRewriting::conjugate(const op_t &op, Pauli &pauli) const {
+  const auto &name = op.name;
+  const uint_t q = 1ULL << op.qubits[0];
+  const bool x = pauli.x & q;
+  const bool z = pauli.z & q;
+  if (name == "cx" || name == "cz") {
+    const uint_t t = 1ULL << op.qubits[1];
+    if (name == "cx") {
+      // X_c -> X_c X_t, Z_t -> Z_c Z_t
+      if (x)
+        pauli.x ^= t;
+      if (pauli.z & t)
+        pauli.z ^= q;
+    } else {
+      // X_c -> X_c Z_t, X_t -> Z_c X_t
+      if (pauli.x & t)
+        pauli.z ^= q;
+      if (x) {
+        pauli.z ^= t;
+        // Z_t now precedes X_t
+        if (pauli.x & t)
+          pauli.phase += 2;
+      }
+    }
+  } else if (name == "h") {
+    // X <-> Z, X Z -> Z X = -X Z
+    if (x != z) {
+      pauli.x ^= q;
+      pauli.z ^= q;
+    } else if (x) {
+      pauli.phase += 2;
+    }
+  } else if (name == "s" || name == "sdg") {
+    // X -> -Y = -i X Z for S, X -> Y = i X Z for Sdg
+    if (x) {
+      pauli.z ^= q;
+      pauli.phase += (name == "s") ? 3 : 1;
+    }
+  } else if (name == "sx" || name == "sxdg") {
+    // Z -> Y = i X Z for SX, Z -> -Y = -i X Z for SXdg
+    if (z) {
+      pauli.x ^= q;
+      pauli.phase += (name == "sx") ? 1 : 3;
+    }
+  } else if (name == "x") {
+    if (z)
+      pauli.phase += 2;
+  } else if (name == "y") {
+    if (x != z)
+      pauli.phase += 2;
+  } else if (name == "z") {
+    if (x)
+      pauli.phase += 2;
+  } else {
+    return false;
+  }
+  pauli.phase &= 3;
+  return true;
+}
+
+bool MOSQRewriting::rotation_pauli(const op_t &op, Pauli &pauli) const {
+  if (!is_gate(op) || op.params.empty())
+    return false;
+  const auto &name = op.name;
+  const uint_t q0 = 1ULL << op.qubits[0];
+  const uint_t q1 = (op.qubits.size() > 1) ? (1ULL << op.qubits[1]) : 0;
+  pauli = Pauli();
+  if (name == "rx" || name == "rxx")
+    pauli.x = q0 | q1;
+  else if (name == "rz" || name == "rzz")
+    pauli.z = q0 | q1;
+  else if (name == "ry" || name == "ryy") {
+    // Y = i X Z
+    pauli.x = pauli.z = q0 | q1;
+    pauli.phase = (name == "ry") ? 1 : 2;
+  } else if (name == "rzx") {
+    pauli.z = q0;
+    pauli.x = q1;
+  } else
+    return false;
+  return true;
+}
+
+bool MOSQRewriting::generate_operation(const op_t &rotation,
+                                       const Pauli &pauli, op_t &op) const {
+  // X^x Z^z = (-i)^|x & z| P with P the Pauli with Y where both bits are set
+  const uint_t y_mask = pauli.x & pauli.z;
+  const uint_t sign = (pauli.phase + 4 - (Utils::popcount(y_mask) & 3)) & 3;
+  const bool negate = (sign == 2);
+  if (negate) {
+    // Tagged parameters of a session are bound later and can not be negated
+    for (const auto &param : rotation.params)
+      if (std::isnan(std::real(param)))
+        return false;
+  }
+
+  op = rotation;
+  op.name = "MOSQ_CR";
+  op.string_params = {op.name};
+  op.qubits.clear();
+  for (uint_t q = 0; q < 64; ++q)
+    if (((pauli.x | pauli.z) >> q) & 1ULL)
+      op.qubits.push_back(q);
+  op.int_params = {pauli.x & ~y_mask, y_mask, pauli.z & ~y_mask};
+  if (negate)
+    for (auto &param : op.params)
+      param = -param;
+  return true;
+}
+
+void MOSQRewriting::optimize_circuit(Circuit &circ, Noise::NoiseModel &noise,
+                                     const opset_t &allowed_opset,
+                                     ExperimentResult &result) const {
+  if (!active || !allowed_opset.contains_gates("MOSQ_CR") ||
+      circ.num_qubits > 64) {
+    result.metadata.add(false, "mosq_rewrite", "enabled");
+    return;
+  }
+
+  // Start timer
+  using clock_t = std::chrono::high_resolution_clock;
+  auto timer_start = clock_t::now();
+
+  Tracing::Span span("transpile", "mosq_rewrite"); //SW
+  result.metadata.add(true, "mosq_rewrite", "enabled");
+
+  auto &ops = circ.ops;
+  uint_t num_rotations = 0;
+  uint_t num_removed_ops = 0;
+
+  for (uint_t i = 0; i < ops.size(); ++i) {
+    Pauli pauli;
+    if (!rotation_pauli(ops[i], pauli))
+      continue;
+
+    // Grow the window [i - width, i + width] of mirrored Clifford gates.
+    // A gate that leaves the Pauli unchanged and acts outside of its support
+    // ends the window, so that the ladders of neighbouring rotations are not
+    // taken in.
+    uint_t width = 0;
+    if (ops[i].name == "rz") {
+      while (width < i && i + width + 1 < ops.size()) {
+        const auto &left = ops[i - width - 1];
+        const auto &right = ops[i + width + 1];
+        if (!is_inverse(left, right))
+          break;
+        Pauli next = pauli;
+        if (!conjugate(left, next))
+          break;
+        if (next == pauli) {
+          const uint_t support = pauli.x | pauli.z;
+          bool inside = true;
+          for (const auto q : left.qubits)
+            inside &= ((support >> q) & 1ULL) != 0;
+          if (!inside)
+            break;
+        }
+        pauli = next;
+        ++width;
+      }
+    }
+
+    op_t op;
+    if (!generate_operation(ops[i], pauli, op))
+      continue;
+    ops[i - width] = std::move(op);
+    for (uint_t j = i - width + 1; j <= i + width; ++j)
+      ops[j].type = optype_t::nop;
+    ++num_rotations;
+    num_removed_ops += 2 * width;
+    i += width;
+  }
+
+  if (num_removed_ops > 0) {
+    size_t idx = 0;
+    for (size_t i = 0; i < ops.size(); ++i) {
+      if (ops[i].type != optype_t::nop) {
+        if (i != idx)
+          ops[idx] = std::move(ops[i]);
+        ++idx;
+      }
+    }
+    ops.erase(ops.begin() + idx, ops.end());
+  }
+  if (num_rotations > 0)
+    circ.set_params();
+
+  result.metadata.add(num_rotations > 0, "mosq_rewrite", "applied");
+  result.metadata.add(num_rotations, "mosq_rewrite", "num_rotations");
+  result.metadata.add(num_removed_ops, "mosq_rewrite", "num_removed_ops");
+
+  auto timer_stop = clock_t::now();
+  result.metadata.add(
+      std::chrono::duration<double>(timer_stop - timer_start).count(),
+      "mosq_rewrite", "time_taken");
+}
+
+//-------------------------------------------------------------------------
+} // end namespace Transpile
+} // end namespace AER
+//-------------------------------------------------------------------------
+#endif
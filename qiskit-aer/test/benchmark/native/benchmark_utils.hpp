@@ -0,0 +1,100 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+// Helpers shared by the native statevector kernel benchmarks
+
+#ifndef _aer_benchmark_utils_hpp_
+#define _aer_benchmark_utils_hpp_
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "simulators/statevector/qubitvector.hpp"
+
+namespace AER {
+namespace Benchmark {
+
+using myclock_t = std::chrono::high_resolution_clock;
+
+struct PauliMasks {
+  std::string label;
+  uint_t x_mask;
+  uint_t y_mask;
+  uint_t z_mask;
+};
+
+// A normalized state with non-trivial phases
+template <typename data_t>
+void initialize_state(QV::QubitVector<data_t> &qv) {
+  const uint_t size = qv.size();
+  const double norm = 1. / std::sqrt((double)size);
+  for (uint_t i = 0; i < size; ++i)
+    qv[i] = std::complex<data_t>(
+        norm * std::exp(complex_t(0., 0.1 * (double)(i % 97))));
+}
+
+// Masks of a Pauli label, the last character referring to qubit 0
+inline PauliMasks pauli_masks(const std::string &label) {
+  PauliMasks masks{label, 0, 0, 0};
+  const uint_t n = label.size();
+  for (uint_t i = 0; i < n; ++i) {
+    const uint_t bit = 1ULL << (n - 1 - i);
+    switch (label[i]) {
+    case 'X':
+      masks.x_mask |= bit;
+      break;
+    case 'Y':
+      masks.y_mask |= bit;
+      break;
+    case 'Z':
+      masks.z_mask |= bit;
+      break;
+    default:
+      break;
+    }
+  }
+  return masks;
+}
+
+// Label of a Pauli string on num_qubits qubits with the operators ops on
+// qubits (in increasing order) and a Z chain in between, as in the
+// Jordan-Wigner mapping of an excitation
+inline std::string jordan_wigner_label(const uint_t num_qubits,
+                                       const std::vector<uint_t> &qubits,
+                                       const std::string &ops) {
+  std::string label(num_qubits, 'I');
+  for (uint_t i = 0; i < qubits.size(); ++i)
+    label[num_qubits - 1 - qubits[i]] = ops[i];
+  for (uint_t q = qubits.front() + 1; q < qubits.back(); ++q)
+    if (label[num_qubits - 1 - q] == 'I')
+      label[num_qubits - 1 - q] = 'Z';
+  return label;
+}
+
+// Mean seconds of a call of func over repeats calls
+template <typename Func>
+double time_calls(const uint_t repeats, Func func) {
+  const auto timer_start = myclock_t::now();
+  for (uint_t r = 0; r < repeats; ++r)
+    func();
+  const auto timer_stop = myclock_t::now();
+  return std::chrono::duration<double>(timer_stop - timer_start).count() /
+         repeats;
+}
+
+} // namespace Benchmark
+} // namespace AER
+
+#endif
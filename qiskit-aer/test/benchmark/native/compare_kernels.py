@@ -0,0 +1,74 @@
+# This code is part of Qiskit.
+#
+# (C) Copyright IBM 2018, 2021.
+#
+# This code is licensed under the Apache License, Version 2.0. You may
+# obtain a copy of this license in the LICENSE.txt file in the root directory
+# of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+#
+# Any modifications or derivative works of this code must retain this
+# copyright notice, and modified files need to carry a notice indicating
+# that they have been altered from the originals.
+
+"""Compare two runs of statevector_kernel_suite.
+
+Usage: python compare_kernels.py BASELINE.json CONTENDER.json [--threshold 0.1]
+
+Prints the time of each kernel, case, number of qubits and threads in both
+runs and the speedup of the contender. Exits with status 1 if a record is
+slower by more than the threshold fraction.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_records(filename):
+    """Return the results of a run keyed by kernel, case, qubits and threads"""
+    with open(filename, encoding="utf-8") as file:
+        run = json.load(file)
+    records = {}
+    for record in run["results"]:
+        key = (record["kernel"], record["case"], record["num_qubits"], record["threads"])
+        records[key] = record
+    return run.get("label") or filename, records
+
+
+def main():
+    """Compare the runs of the command line"""
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=0.1)
+    args = parser.parse_args()
+
+    baseline_label, baseline = load_records(args.baseline)
+    contender_label, contender = load_records(args.contender)
+    print(f"# baseline: {baseline_label}, contender: {contender_label}")
+    print(
+        f"{'kernel':<9}{'case':<19}{'qubits':>7}{'threads':>8}"
+        f"{'base[us]':>13}{'new[us]':>13}{'GB/s':>9}{'speedup':>9}"
+    )
+    regressions = 0
+    for key in sorted(baseline.keys() & contender.keys()):
+        old = baseline[key]["time"]
+        new = contender[key]["time"]
+        speedup = old / new
+        flag = ""
+        if speedup < 1.0 / (1.0 + args.threshold):
+            flag = "  slower"
+            regressions += 1
+        print(
+            f"{key[0]:<9}{key[1]:<19}{key[2]:>7}{key[3]:>8}"
+            f"{old * 1e6:>13.1f}{new * 1e6:>13.1f}"
+            f"{contender[key]['bandwidth']:>9.2f}{speedup:>9.2f}{flag}"
+        )
+    missing = len(baseline.keys() ^ contender.keys())
+    if missing:
+        print(f"# {missing} records are only in one of the runs")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
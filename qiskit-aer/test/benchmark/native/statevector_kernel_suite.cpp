@@ -0,0 +1,336 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+// Sweep of the statevector kernels over qubit and thread counts.
+//
+// Usage: statevector_kernel_suite [--qubits MIN:MAX[:STEP]] [--threads T,...]
+//                                 [--min-time SECONDS] [--label LABEL]
+//                                 [--output FILE]
+//
+// For each number of qubits (default 10:30:4) and OpenMP threads (default 1
+// and the powers of two up to the maximum) the suite times
+//   MOSQ        QubitVector::apply_MOSQ of Z strings of a few weights
+//   MOSQ_CR     QubitVector::apply_MOSQ_CR of Jordan-Wigner strings with two
+//               or four X/Y sites and their highest X/Y qubit low or high
+//   mcu         QubitVector::apply_mcu of the H+S and SDG+H gates
+//   matrix      QubitVector::apply_matrix of fused 2 to 5 qubit unitaries on
+//               the lowest or the highest qubits
+//   diagonal    QubitVector::apply_diagonal_matrix of 2 to 5 qubit phases
+//   expval      QubitVector::expval_pauli of a Z string and a Jordan-Wigner
+//               string
+// Each kernel is called until it has run for min-time seconds (default 0.1).
+// The bandwidth assumes every amplitude is read and written once per call, or
+// only read for expval.
+//
+// The results are written as JSON, one record per kernel, case, number of
+// qubits and threads, to compare runs of different commits with
+// compare_kernels.py. Numbers of qubits whose statevector does not fit in half
+// of the physical memory are skipped.
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "benchmark_utils.hpp"
+#include "framework/json.hpp"
+#include "framework/linalg/matrix_utils/vmatrix_defs.hpp"
+
+using namespace AER;
+using namespace AER::Benchmark;
+
+namespace {
+
+struct Options {
+  uint_t min_qubits = 10;
+  uint_t max_qubits = 30;
+  uint_t qubit_step = 4;
+  std::vector<uint_t> threads;
+  double min_time = 0.1;
+  std::string label;
+  std::string output;
+};
+
+// A kernel call on a statevector of a given number of qubits
+struct Case {
+  std::string kernel;
+  std::string name;
+  json_t params;
+  // Passes over the statevector per call, 1 for reads only
+  double passes;
+  std::function<void(QV::QubitVector<double> &)> call;
+};
+
+uint_t max_threads() {
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+// Half of the physical memory in bytes, or 0 if unknown
+double memory_limit() {
+#if defined(_SC_PHYS_PAGES) && defined(_SC_PAGE_SIZE)
+  return 0.5 * (double)sysconf(_SC_PHYS_PAGES) * (double)sysconf(_SC_PAGE_SIZE);
+#else
+  return 0.;
+#endif
+}
+
+std::vector<uint_t> parse_list(const std::string &arg, const char separator) {
+  std::vector<uint_t> values;
+  size_t start = 0;
+  while (start <= arg.size()) {
+    const size_t end = std::min(arg.find(separator, start), arg.size());
+    values.push_back(std::stoull(arg.substr(start, end - start)));
+    start = end + 1;
+  }
+  return values;
+}
+
+Options parse_options(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc)
+      throw std::invalid_argument("missing value of " + arg);
+    const std::string value = argv[++i];
+    if (arg == "--qubits") {
+      const auto range = parse_list(value, ':');
+      if (range.size() < 2 || range.size() > 3)
+        throw std::invalid_argument("--qubits expects MIN:MAX[:STEP]");
+      options.min_qubits = range[0];
+      options.max_qubits = range[1];
+      options.qubit_step = (range.size() == 3) ? std::max<uint_t>(range[2], 1)
+                                               : 1;
+    } else if (arg == "--threads") {
+      options.threads = parse_list(value, ',');
+    } else if (arg == "--min-time") {
+      options.min_time = std::stod(value);
+    } else if (arg == "--label") {
+      options.label = value;
+    } else if (arg == "--output") {
+      options.output = value;
+    } else {
+      throw std::invalid_argument("unknown option " + arg);
+    }
+  }
+  if (options.min_qubits < 6 || options.max_qubits > 40)
+    throw std::invalid_argument("the number of qubits must be in [6, 40]");
+  if (options.threads.empty()) {
+    for (uint_t t = 1; t < max_threads(); t *= 2)
+      options.threads.push_back(t);
+    options.threads.push_back(max_threads());
+  }
+  return options;
+}
+
+// Unitary discrete Fourier transform of num_qubits qubits, column-major
+cvector_t fourier_matrix(const uint_t num_qubits) {
+  const uint_t dim = 1ULL << num_qubits;
+  const double norm = 1. / std::sqrt((double)dim);
+  cvector_t mat(dim * dim);
+  for (uint_t i = 0; i < dim; ++i)
+    for (uint_t j = 0; j < dim; ++j)
+      mat[i + dim * j] =
+          norm * std::exp(complex_t(0., 2. * M_PI * (double)(i * j) / dim));
+  return mat;
+}
+
+reg_t qubit_range(const uint_t first, const uint_t count) {
+  reg_t qubits(count);
+  for (uint_t i = 0; i < count; ++i)
+    qubits[i] = first + i;
+  return qubits;
+}
+
+std::vector<Case> benchmark_cases(const uint_t num_qubits) {
+  std::vector<Case> cases;
+  const uint_t top = num_qubits - 1;
+  const auto phase = std::exp(complex_t(0., 0.3));
+
+  for (const uint_t weight : reg_t({2, 4, num_qubits})) {
+    const reg_t qubits = qubit_range(0, weight);
+    cases.push_back({"MOSQ", "weight" + std::to_string(weight),
+                     {{"mask_weight", weight}}, 2.,
+                     [qubits, phase](QV::QubitVector<double> &qv) {
+                       qv.apply_MOSQ(qubits, phase);
+                     }});
+  }
+
+  const std::vector<std::pair<std::vector<uint_t>, std::string>> strings = {
+      {{0, 1}, "XY"},
+      {{0, top}, "YX"},
+      {{0, 1, 2, 3}, "XXXY"},
+      {{0, 1, top - 1, top}, "XXXY"}};
+  for (const auto &string : strings) {
+    const auto masks = pauli_masks(
+        jordan_wigner_label(num_qubits, string.first, string.second));
+    const uint_t weight =
+        Utils::popcount(masks.x_mask | masks.y_mask | masks.z_mask);
+    const uint_t highest = string.first.back();
+    cases.push_back(
+        {"MOSQ_CR",
+         "sites" + std::to_string(string.first.size()) + "_highest" +
+             std::to_string(highest),
+         {{"sites", string.first.size()},
+          {"mask_weight", weight},
+          {"highest_qubit", highest}},
+         2.,
+         [masks, phase](QV::QubitVector<double> &qv) {
+           qv.apply_MOSQ_CR({}, phase, masks.x_mask, masks.y_mask,
+                            masks.z_mask);
+         }});
+  }
+
+  // H+S and SDG+H as applied by the statevector State
+  const auto hs = Linalg::VMatrix::u4(M_PI / 2., M_PI / 2., M_PI, 0.);
+  const auto sdgh = Linalg::VMatrix::u4(M_PI / 2., 0., M_PI / 2., 0.);
+  for (const uint_t qubit : reg_t({0, top})) {
+    cases.push_back({"mcu", "H+S_q" + std::to_string(qubit),
+                     {{"gate", "H+S"}, {"qubit", qubit}}, 2.,
+                     [hs, qubit](QV::QubitVector<double> &qv) {
+                       qv.apply_mcu({qubit}, hs);
+                     }});
+    cases.push_back({"mcu", "SDG+H_q" + std::to_string(qubit),
+                     {{"gate", "SDG+H"}, {"qubit", qubit}}, 2.,
+                     [sdgh, qubit](QV::QubitVector<double> &qv) {
+                       qv.apply_mcu({qubit}, sdgh);
+                     }});
+  }
+
+  for (uint_t size = 2; size <= 5; ++size) {
+    const auto mat = fourier_matrix(size);
+    for (const uint_t first : reg_t({0, num_qubits - size})) {
+      const reg_t qubits = qubit_range(first, size);
+      cases.push_back({"matrix",
+                       std::to_string(size) + "q_from" + std::to_string(first),
+                       {{"num_qubits", size}, {"first_qubit", first}},
+                       2.,
+                       [qubits, mat](QV::QubitVector<double> &qv) {
+                         qv.apply_matrix(qubits, mat);
+                       }});
+    }
+    cvector_t diag(1ULL << size);
+    for (uint_t i = 0; i < diag.size(); ++i)
+      diag[i] = std::exp(complex_t(0., 0.1 * (double)i));
+    const reg_t qubits = qubit_range(0, size);
+    cases.push_back({"diagonal", std::to_string(size) + "q",
+                     {{"num_qubits", size}},
+                     2.,
+                     [qubits, diag](QV::QubitVector<double> &qv) {
+                       qv.apply_diagonal_matrix(qubits, diag);
+                     }});
+  }
+
+  const reg_t all_qubits = qubit_range(0, num_qubits);
+  std::string z_string(num_qubits, 'I');
+  z_string[top] = z_string[top - 1] = 'Z';
+  const std::string jw_string =
+      jordan_wigner_label(num_qubits, {0, 1, top - 1, top}, "XXXY");
+  const std::vector<std::pair<std::string, std::string>> paulis = {
+      {"ZZ", z_string}, {"XXXY", jw_string}};
+  for (const auto &named : paulis) {
+    const std::string pauli = named.second;
+    cases.push_back({"expval", named.first,
+                     {{"pauli", pauli}},
+                     1.,
+                     [all_qubits, pauli](QV::QubitVector<double> &qv) {
+                       volatile double val = qv.expval_pauli(all_qubits, pauli);
+                       (void)val;
+                     }});
+  }
+  return cases;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  try {
+    options = parse_options(argc, argv);
+  } catch (std::exception &e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+
+  json_t results = json_t::array();
+  const double limit = memory_limit();
+  for (uint_t num_qubits = options.min_qubits;
+       num_qubits <= options.max_qubits; num_qubits += options.qubit_step) {
+    const double state_bytes = sizeof(complex_t) * std::pow(2., num_qubits);
+    if (limit > 0. && state_bytes > limit) {
+      std::fprintf(stderr, "# skipping %llu qubits, %.1f GB statevector\n",
+                   (unsigned long long)num_qubits, state_bytes * 1e-9);
+      continue;
+    }
+    QV::QubitVector<double> qv(num_qubits);
+    qv.set_omp_threshold(1);
+    initialize_state(qv);
+    const auto cases = benchmark_cases(num_qubits);
+
+    for (const uint_t threads : options.threads) {
+      qv.set_omp_threads(threads);
+      for (const auto &c : cases) {
+        // The first call warms up and estimates the repeats
+        const double estimate = time_calls(1, [&]() { c.call(qv); });
+        const uint_t repeats = std::max<uint_t>(
+            1, std::min<uint_t>(10000, options.min_time / estimate));
+        const double time = time_calls(repeats, [&]() { c.call(qv); });
+        const double bandwidth = c.passes * state_bytes / time * 1e-9;
+
+        json_t record;
+        record["kernel"] = c.kernel;
+        record["case"] = c.name;
+        record["params"] = c.params;
+        record["num_qubits"] = num_qubits;
+        record["threads"] = threads;
+        record["repeats"] = repeats;
+        record["time"] = time;
+        record["bandwidth"] = bandwidth;
+        results.push_back(record);
+        std::fprintf(stderr, "%-8s %-18s %3llu qubits %3llu threads %12.1f us "
+                             "%8.2f GB/s\n",
+                     c.kernel.c_str(), c.name.c_str(),
+                     (unsigned long long)num_qubits,
+                     (unsigned long long)threads, time * 1e6, bandwidth);
+      }
+    }
+  }
+
+  json_t js;
+  js["benchmark"] = "statevector_kernel_suite";
+  js["label"] = options.label;
+  js["max_threads"] = max_threads();
+  js["min_time"] = options.min_time;
+  js["results"] = results;
+  if (options.output.empty()) {
+    std::cout << js.dump(2) << std::endl;
+  } else {
+    std::ofstream file(options.output);
+    file << js.dump(2) << std::endl;
+  }
+  return 0;
+}
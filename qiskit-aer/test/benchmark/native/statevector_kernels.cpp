@@ -0,0 +1,340 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+// Microbenchmark for the statevector MOSQ and MOSQ_CR Pauli rotation kernels.
+//
+// Usage: statevector_kernels [num_qubits] [repeats] [threads]
+//
+// For a set of Pauli masks the benchmark times QubitVector::apply_MOSQ_CR
+// (and QubitVector::apply_MOSQ for the Z part of each string),
+// reports the achieved memory bandwidth (every amplitude is read and written
+// once per rotation) and checks the result against the previous per-pair
+// heap-allocating implementation, which is also timed for comparison. The
+// single precision kernel is checked against the same reference. Finally all
+// strings are applied as one QubitVector::apply_MOSQ_BLOCK and compared with
+// applying them one at a time, and the expectation values of a Hamiltonian-like
+// term list are computed grouped by X mask (QubitVector::expval_paulis) and
+// one term at a time.
+//
+// statevector_kernel_suite sweeps all kernels over qubit and thread counts.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <set>
+#include <string>
+
+#include "benchmark_utils.hpp"
+
+using namespace AER;
+using namespace AER::Benchmark;
+
+namespace {
+
+// Previous MOSQ_CR implementation: one heap allocated index pair, a 64 bit
+// scan for the highest X/Y bit and a 64 step Y/Z bit count per amplitude pair
+void legacy_MOSQ_CR(std::complex<double> *data, const uint_t data_size,
+                    const std::complex<double> phase, const uint_t X_idx,
+                    const uint_t Y_idx, const uint_t Z_idx) {
+  const double scale = 0.5;
+  const complex_t I(0., 1.);
+  complex_t mats[4][4];
+  for (uint_t m = 0; m < 4; ++m) {
+    mats[m][0] = mats[m][3] = scale * (complex_t(1.0) + phase);
+  }
+  mats[0][1] = mats[0][2] = scale * (complex_t(1.0) - phase);
+  mats[1][1] = scale * I * (complex_t(1.0) - phase);
+  mats[1][2] = -scale * I * (complex_t(1.0) - phase);
+  mats[2][1] = mats[2][2] = -scale * (complex_t(1.0) - phase);
+  mats[3][1] = -scale * I * (complex_t(1.0) - phase);
+  mats[3][2] = scale * I * (complex_t(1.0) - phase);
+
+  uint_t num_Y = 0;
+  for (uint_t temp = Y_idx; temp; temp >>= 1)
+    num_Y += (temp & 1);
+
+  const int_t END = data_size >> 1;
+  for (int_t k = 0; k < END; k++) {
+    const uint_t XY_idx = X_idx ^ Y_idx;
+    int highest_one_pos = -1;
+    for (int i = sizeof(XY_idx) * 8 - 1; i >= 0; --i) {
+      if ((XY_idx >> i) & 1) {
+        highest_one_pos = i;
+        break;
+      }
+    }
+    uint_t idx0 = k;
+    if (highest_one_pos > -1) {
+      const uint_t lowbits = idx0 & QV::MASKS[highest_one_pos];
+      idx0 >>= highest_one_pos;
+      idx0 <<= highest_one_pos + 1;
+      idx0 |= lowbits;
+    }
+    QV::indexes_t inds(new uint_t[2]);
+    inds[0] = idx0;
+    inds[1] = idx0 ^ XY_idx;
+
+    uint_t Y_count = 0, Z_count = 0;
+    uint_t Y_masked_value = Y_idx & idx0;
+    uint_t Z_masked_value = Z_idx & idx0;
+    for (size_t i = 0; i < sizeof(idx0) * 8; ++i) {
+      Y_count += (Y_masked_value & 1);
+      Y_masked_value >>= 1;
+      Z_count += (Z_masked_value & 1);
+      Z_masked_value >>= 1;
+    }
+    const auto &mat = mats[(num_Y - 2 * Y_count + 2 * Z_count) % 4];
+    const auto cache = data[inds[0]];
+    data[inds[0]] = mat[0] * data[inds[0]] + mat[2] * data[inds[1]];
+    data[inds[1]] = mat[1] * cache + mat[3] * data[inds[1]];
+  }
+}
+
+// Previous MOSQ implementation: a loop over the qubits for the parity of each
+// amplitude and a branch on the result
+void legacy_MOSQ(std::complex<double> *data, const uint_t data_size,
+                 const std::complex<double> phase, const reg_t &qubits) {
+  for (int_t k = 0; k < int_t(data_size); k++) {
+    bool parity = false;
+    for (uint_t index : qubits)
+      parity ^= ((k >> index) & 1);
+    if (parity)
+      data[k] *= phase;
+  }
+}
+
+// UCCSD-like Pauli strings: Z chains between two or four X/Y sites
+std::vector<PauliMasks> benchmark_masks(const uint_t num_qubits) {
+  std::vector<PauliMasks> ret;
+  const auto string_with = [num_qubits](const std::vector<uint_t> &qubits,
+                                        const std::string &ops) {
+    return jordan_wigner_label(num_qubits, qubits, ops);
+  };
+  const uint_t top = num_qubits - 1;
+  ret.push_back(pauli_masks(string_with({0, 1}, "XY")));
+  ret.push_back(pauli_masks(string_with({0, top}, "YX")));
+  ret.push_back(pauli_masks(string_with({1, top / 2, top / 2 + 1, top},
+                                        "XXXY")));
+  ret.push_back(pauli_masks(string_with({0, 2, top - 2, top}, "YYYX")));
+  return ret;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const uint_t num_qubits = (argc > 1) ? std::stoull(argv[1]) : 20;
+  const uint_t repeats = (argc > 2) ? std::stoull(argv[2]) : 10;
+  const uint_t threads = (argc > 3) ? std::stoull(argv[3]) : 1;
+  if (num_qubits < 4) {
+    std::fprintf(stderr, "num_qubits must be at least 4\n");
+    return 1;
+  }
+
+  QV::QubitVector<double> qv(num_qubits);
+  qv.set_omp_threads(threads);
+  qv.set_omp_threshold(1);
+  QV::QubitVector<double> ref(num_qubits);
+  QV::QubitVector<float> qv_f32(num_qubits);
+  qv_f32.set_omp_threads(threads);
+  qv_f32.set_omp_threshold(1);
+
+  const double theta = 0.3;
+  const auto phase = std::exp(complex_t(0., theta));
+  const double bytes = 2. * sizeof(complex_t) * (double)qv.size();
+
+  std::printf("# num_qubits=%llu repeats=%llu threads=%llu\n",
+              (unsigned long long)num_qubits, (unsigned long long)repeats,
+              (unsigned long long)threads);
+  std::printf("%-*s %12s %10s %12s %10s %10s %10s\n", (int)num_qubits,
+              "pauli", "time[us]", "GB/s", "legacy[us]", "speedup", "max_err",
+              "f32_err");
+
+  for (const auto &masks : benchmark_masks(num_qubits)) {
+    const uint_t X = masks.x_mask, Y = masks.y_mask, Z = masks.z_mask;
+
+    initialize_state(qv);
+    auto timer_start = myclock_t::now();
+    for (uint_t r = 0; r < repeats; ++r)
+      qv.apply_MOSQ_CR({}, phase, X, Y, Z);
+    auto timer_stop = myclock_t::now();
+    const double time =
+        std::chrono::duration<double>(timer_stop - timer_start).count() /
+        repeats;
+
+    initialize_state(ref);
+    timer_start = myclock_t::now();
+    for (uint_t r = 0; r < repeats; ++r)
+      legacy_MOSQ_CR(ref.data(), ref.size(), phase, masks.x_mask, masks.y_mask,
+                     masks.z_mask);
+    timer_stop = myclock_t::now();
+    const double legacy_time =
+        std::chrono::duration<double>(timer_stop - timer_start).count() /
+        repeats;
+
+    initialize_state(qv_f32);
+    for (uint_t r = 0; r < repeats; ++r)
+      qv_f32.apply_MOSQ_CR({}, phase, X, Y, Z);
+
+    double max_err = 0., f32_err = 0.;
+    for (uint_t i = 0; i < qv.size(); ++i) {
+      max_err = std::max(max_err, std::abs(qv[i] - ref[i]));
+      f32_err = std::max(f32_err, std::abs(complex_t(qv_f32[i]) - ref[i]));
+    }
+
+    std::printf("%s %12.1f %10.2f %12.1f %10.2f %10.2e %10.2e\n",
+                masks.label.c_str(), time * 1e6, bytes / time * 1e-9,
+                legacy_time * 1e6, legacy_time / time, max_err, f32_err);
+  }
+
+  std::printf("\n%-*s %12s %10s %12s %10s %10s\n", (int)num_qubits, "MOSQ",
+              "time[us]", "GB/s", "legacy[us]", "speedup", "max_err");
+  for (const auto &masks : benchmark_masks(num_qubits)) {
+    reg_t qubits;
+    for (uint_t q = 0; q < num_qubits; ++q)
+      if ((masks.x_mask | masks.y_mask | masks.z_mask) & (1ULL << q))
+        qubits.push_back(q);
+    std::string label(num_qubits, 'I');
+    for (const auto q : qubits)
+      label[num_qubits - 1 - q] = 'Z';
+
+    initialize_state(qv);
+    auto timer_start = myclock_t::now();
+    for (uint_t r = 0; r < repeats; ++r)
+      qv.apply_MOSQ(qubits, phase);
+    auto timer_stop = myclock_t::now();
+    const double time =
+        std::chrono::duration<double>(timer_stop - timer_start).count() /
+        repeats;
+
+    initialize_state(ref);
+    timer_start = myclock_t::now();
+    for (uint_t r = 0; r < repeats; ++r)
+      legacy_MOSQ(ref.data(), ref.size(), phase, qubits);
+    timer_stop = myclock_t::now();
+    const double legacy_time =
+        std::chrono::duration<double>(timer_stop - timer_start).count() /
+        repeats;
+
+    double max_err = 0.;
+    for (uint_t i = 0; i < qv.size(); ++i)
+      max_err = std::max(max_err, std::abs(qv[i] - ref[i]));
+
+    std::printf("%s %12.1f %10.2f %12.1f %10.2f %10.2e\n", label.c_str(),
+                time * 1e6, bytes / time * 1e-9, legacy_time * 1e6,
+                legacy_time / time, max_err);
+  }
+
+  // All strings as one block against one rotation at a time
+  cvector_t thetas;
+  reg_t block_masks;
+  for (const auto &masks : benchmark_masks(num_qubits)) {
+    thetas.push_back(theta);
+    block_masks.insert(block_masks.end(),
+                       {masks.x_mask, masks.y_mask, masks.z_mask});
+  }
+  initialize_state(qv);
+  auto timer_start = myclock_t::now();
+  for (uint_t r = 0; r < repeats; ++r)
+    qv.apply_MOSQ_BLOCK(thetas, block_masks);
+  auto timer_stop = myclock_t::now();
+  const double time =
+      std::chrono::duration<double>(timer_stop - timer_start).count() /
+      repeats;
+
+  initialize_state(ref);
+  timer_start = myclock_t::now();
+  for (uint_t r = 0; r < repeats; ++r)
+    for (uint_t i = 0; i < block_masks.size(); i += 3)
+      ref.apply_MOSQ_CR({}, phase, block_masks[i], block_masks[i + 1],
+                        block_masks[i + 2]);
+  timer_stop = myclock_t::now();
+  const double single_time =
+      std::chrono::duration<double>(timer_stop - timer_start).count() /
+      repeats;
+
+  double max_err = 0.;
+  for (uint_t i = 0; i < qv.size(); ++i)
+    max_err = std::max(max_err, std::abs(qv[i] - ref[i]));
+
+  std::printf("\n%-*s %12s %10s %12s %10s %10s\n", (int)num_qubits,
+              "MOSQ_BLOCK", "time[us]", "GB/s", "MOSQ_CR[us]", "speedup",
+              "max_err");
+  std::printf("%-*s %12.1f %10.2f %12.1f %10.2f %10.2e\n", (int)num_qubits,
+              (std::to_string(thetas.size()) + " rotations").c_str(),
+              time * 1e6, bytes / time * 1e-9, single_time * 1e6,
+              single_time / time, max_err);
+
+  // Every X/Y assignment of the benchmark strings (one X mask, several Z
+  // masks each) and the Z and ZZ terms of a Jordan-Wigner Hamiltonian
+  std::vector<std::string> paulis;
+  std::set<uint_t> x_masks;
+  for (const auto &masks : benchmark_masks(num_qubits)) {
+    reg_t sites;
+    for (uint_t q = 0; q < num_qubits; ++q)
+      if ((masks.x_mask | masks.y_mask) >> q & 1)
+        sites.push_back(q);
+    for (uint_t v = 0; v < (1ULL << sites.size()); ++v) {
+      std::string label = masks.label;
+      for (uint_t j = 0; j < sites.size(); ++j)
+        label[num_qubits - 1 - sites[j]] = (v >> j & 1) ? 'Y' : 'X';
+      paulis.push_back(label);
+    }
+    x_masks.insert(masks.x_mask | masks.y_mask);
+  }
+  for (uint_t q = 0; q < num_qubits; ++q) {
+    for (uint_t p = q; p < num_qubits; ++p) {
+      std::string label(num_qubits, 'I');
+      label[num_qubits - 1 - q] = label[num_qubits - 1 - p] = 'Z';
+      paulis.push_back(label);
+    }
+  }
+  x_masks.insert(0);
+  reg_t qubits(num_qubits);
+  std::iota(qubits.begin(), qubits.end(), 0);
+
+  std::vector<double> vals;
+  timer_start = myclock_t::now();
+  for (uint_t r = 0; r < repeats; ++r)
+    vals = qv.expval_paulis(qubits, paulis);
+  timer_stop = myclock_t::now();
+  const double group_time =
+      std::chrono::duration<double>(timer_stop - timer_start).count() /
+      repeats;
+
+  std::vector<double> ref_vals(paulis.size());
+  timer_start = myclock_t::now();
+  for (uint_t r = 0; r < repeats; ++r)
+    for (uint_t i = 0; i < paulis.size(); ++i)
+      ref_vals[i] = qv.expval_pauli(qubits, paulis[i]);
+  timer_stop = myclock_t::now();
+  const double term_time =
+      std::chrono::duration<double>(timer_stop - timer_start).count() /
+      repeats;
+
+  double expval_err = 0.;
+  for (uint_t i = 0; i < paulis.size(); ++i)
+    expval_err = std::max(expval_err, std::abs(vals[i] - ref_vals[i]));
+
+  std::printf("\n%-*s %12s %10s %12s %10s %10s\n", (int)num_qubits, "expval",
+              "time[us]", "GB/s", "per-term[us]", "speedup", "max_err");
+  std::printf("%-*s %12.1f %10.2f %12.1f %10.2f %10.2e\n", (int)num_qubits,
+              (std::to_string(paulis.size()) + " terms/" +
+               std::to_string(x_masks.size()) + " X")
+                  .c_str(),
+              group_time * 1e6,
+              0.5 * bytes * (double)x_masks.size() / group_time * 1e-9,
+              term_time * 1e6, term_time / group_time, expval_err);
+  return 0;
+}
@@ -0,0 +1,104 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019, 2020.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#include <framework/config.hpp>
+#include <framework/rng.hpp>
+#include <noise/noise_model.hpp>
+#include <simulators/statevector/statevector_state.hpp>
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace AER;
+
+namespace {
+using state_t = Statevector::State<QV::QubitVector<double>>;
+
+const uint_t num_qubits = 6;
+
+Operations::Op make_gate(const std::string &name, const reg_t &qubits,
+                         const std::vector<complex_t> &params = {}) {
+  Operations::Op op;
+  op.type = Operations::OpType::gate;
+  op.name = name;
+  op.qubits = qubits;
+  op.params = params;
+  return op;
+}
+
+// Slice-local ops with controls and Z qubits on the highest qubits, which
+// select the slices, and ops coupling the slices
+std::vector<Operations::Op> make_ops() {
+  std::vector<Operations::Op> ops;
+  for (uint_t q = 0; q < num_qubits; ++q) {
+    ops.push_back(make_gate("h", {q}));
+    ops.push_back(make_gate("rz", {q}, {0.1 * q + 0.2}));
+  }
+  ops.push_back(make_gate("cx", {5, 0}));
+  ops.push_back(make_gate("ccx", {5, 4, 1}));
+  ops.push_back(make_gate("cp", {4, 2}, {0.7}));
+  ops.push_back(make_gate("cswap", {5, 0, 1}));
+  ops.push_back(Operations::make_MOSQ_CR({0, 1, 5}, 0.3, 1, 2, 32, -1));
+  ops.push_back(Operations::make_MOSQ_CR({4, 5}, 0.5, 0, 0, 48, -1));
+  ops.push_back(Operations::make_MOSQ_CR({0, 5}, 0.6, 32, 0, 1, -1));
+  ops.push_back(make_gate("cx", {0, 5}));
+  for (uint_t q = 0; q < num_qubits; ++q)
+    ops.push_back(make_gate("ry", {q}, {0.3 + 0.05 * q}));
+  ops.push_back(make_gate("cx", {1, 2}));
+  return ops;
+}
+
+// Apply the ops to a statevector parallelized over its amplitudes
+void run(state_t &state, const std::vector<Operations::Op> &ops,
+         const int threads, const bool persistent, ExperimentResult &result) {
+  Config config;
+  config.statevector_parallel_threshold = 2;
+  config.statevector_persistent_parallel = persistent;
+  state.set_config(config);
+  state.set_parallelization(threads);
+  state.set_num_global_qubits(num_qubits);
+  state.initialize_qreg(num_qubits);
+  RngEngine rng;
+  rng.set_seed(1);
+  state.apply_ops(ops.cbegin(), ops.cend(), result, rng);
+  state.add_metadata(result);
+}
+} // namespace
+
+#ifdef _OPENMP
+TEST_CASE("Persistent parallel runs", "[statevector]") {
+  const auto ops = make_ops();
+  for (const int threads : {2, 3, 4, 8}) {
+    // The slices need several threads, even on a single-core machine
+    omp_set_num_threads(threads);
+
+    state_t state, target;
+    ExperimentResult result, target_result;
+    run(state, ops, threads, true, result);
+    run(target, ops, threads, false, target_result);
+
+    auto js = result.metadata.to_json();
+    REQUIRE(js["persistent_parallel"]["runs"] > 0);
+    REQUIRE(target_result.metadata.to_json().count("persistent_parallel") ==
+            0);
+    for (uint_t i = 0; i < (1ull << num_qubits); ++i)
+      REQUIRE(std::abs(state.qreg()[i] - target.qreg()[i]) < 1e-12);
+  }
+}
+#endif
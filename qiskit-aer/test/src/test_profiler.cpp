@@ -0,0 +1,130 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019, 2020.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+// The profiler is compiled out without AER_PROFILING
+#ifndef AER_PROFILING
+#define AER_PROFILING
+#endif
+
+#include <framework/profiler.hpp>
+#include <framework/rng.hpp>
+#include <framework/trace.hpp>
+#include <noise/noise_model.hpp>
+#include <simulators/statevector/real_statevector_state.hpp>
+#include <simulators/statevector/statevector_state.hpp>
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace AER;
+
+namespace {
+Operations::Op make_gate(const std::string &name, const reg_t &qubits,
+                         const std::vector<complex_t> &params = {}) {
+  Operations::Op op;
+  op.type = Operations::OpType::gate;
+  op.name = name;
+  op.qubits = qubits;
+  op.params = params;
+  return op;
+}
+
+// Apply h, cx and ry gates to a 3-qubit state and return its profile
+template <class state_t>
+json_t profile_of_state() {
+  state_t state;
+  state.initialize_qreg(3);
+  ExperimentResult result;
+  RngEngine rng;
+  rng.set_seed(1);
+  state.apply_op(make_gate("h", {0}), result, rng);
+  state.apply_op(make_gate("cx", {0, 1}), result, rng);
+  state.apply_op(make_gate("cx", {1, 2}), result, rng);
+  state.apply_op(make_gate("ry", {2}, {0.3}), result, rng);
+  state.add_metadata(result);
+  return result.metadata.to_json()["profile"];
+}
+} // namespace
+
+TEST_CASE("Profiler", "[profiler]") {
+  SECTION("Timer adds one call of its kind") {
+    Profiling::Profile profile;
+    {
+      Profiling::Timer timer(profile, Profiling::Kind::mosq_cr, 4, 1024);
+    }
+    {
+      Profiling::Timer timer(profile, Profiling::Kind::mosq_cr, 2, 1024);
+    }
+    const auto &counters = profile.counters(Profiling::Kind::mosq_cr);
+    REQUIRE(counters.calls == 2);
+    REQUIRE(counters.bytes == 2048);
+    REQUIRE(counters.qubits == 6);
+    REQUIRE(counters.max_qubits == 4);
+    REQUIRE(profile.counters(Profiling::Kind::cx).calls == 0);
+
+    ExperimentResult result;
+    profile.add_metadata(result);
+    auto js = result.metadata.to_json()["profile"];
+    REQUIRE(js.size() == 1);
+    REQUIRE(js["MOSQ_CR"]["calls"] == 2);
+    REQUIRE(js["MOSQ_CR"]["mean_qubits"] == 3.);
+    REQUIRE(js["MOSQ_CR"]["time"] >= 0.);
+
+    profile.clear();
+    REQUIRE(profile.counters(Profiling::Kind::mosq_cr).calls == 0);
+  }
+
+  SECTION("Statevector state profiles its gates") {
+    auto js =
+        profile_of_state<Statevector::State<QV::QubitVector<double>>>();
+    REQUIRE(js["h"]["calls"] == 1);
+    REQUIRE(js["cx"]["calls"] == 2);
+    REQUIRE(js["gate"]["calls"] == 1);
+    REQUIRE(js["cx"]["bytes"] == 2 * 2 * 8 * sizeof(std::complex<double>));
+  }
+
+  SECTION("Real statevector state profiles its gates") {
+    auto js = profile_of_state<
+        Statevector::RealState<QV::RealQubitVector<double>>>();
+    REQUIRE(js["h"]["calls"] == 1);
+    REQUIRE(js["cx"]["calls"] == 2);
+    REQUIRE(js["gate"]["calls"] == 1);
+    REQUIRE(js["cx"]["bytes"] == 2 * 2 * 8 * sizeof(double));
+  }
+}
+
+TEST_CASE("Trace", "[profiler]") {
+  SECTION("Span names are escaped") {
+    REQUIRE(Tracing::Trace::escape("cx") == "cx");
+    REQUIRE(Tracing::Trace::escape("a\"b\\c\n") == "a\\\"b\\\\c\\u000a");
+
+    const std::string filename = "test_profiler_trace.json";
+    {
+      Tracing::Recording recording(filename);
+      Tracing::Span span("op", "label \"q0\"");
+    }
+    std::ifstream file(filename);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    file.close();
+    std::remove(filename.c_str());
+    REQUIRE(contents.str().find(R"("name":"label \"q0\"")") !=
+            std::string::npos);
+  }
+}
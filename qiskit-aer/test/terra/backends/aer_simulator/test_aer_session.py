@@ -0,0 +1,114 @@
+# This code is part of Qiskit.
+#
+# (C) Copyright IBM 2018, 2021.
+#
+# This code is licensed under the Apache License, Version 2.0. You may
+# obtain a copy of this license in the LICENSE.txt file in the root directory
+# of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+#
+# Any modifications or derivative works of this code must retain this
+# copyright notice, and modified files need to carry a notice indicating
+# that they have been altered from the originals.
+"""
+Integration Tests for persistent simulation sessions
+"""
+
+import numpy as np
+from test.terra.backends.simulator_test_case import SimulatorTestCase
+import qiskit.quantum_info as qi
+from qiskit.circuit import Gate, Parameter, QuantumCircuit
+from qiskit_aer import AerSession
+from qiskit_aer.noise import NoiseModel, depolarizing_error
+
+
+class TestAerSession(SimulatorTestCase):
+    """Test AerSession evaluations against AerSimulator runs."""
+
+    OPER = qi.SparsePauliOp.from_list([("IZZI", 0.3), ("XXYY", -0.2), ("XZXI", 0.1)])
+
+    def _circuit(self, real):
+        """Return a parameterized 4-qubit circuit"""
+        theta = Parameter("theta")
+        phi = Parameter("phi")
+        circ = QuantumCircuit(4)
+        circ.h(0)
+        circ.x(1)
+        circ.ry(theta, 2)
+        circ.cx(0, 3)
+        circ.ry(2 * phi - 0.5, 1)
+        circ.append(Gate("MOSQ_CR", 4, [theta + phi, 9, 2, 4]), [0, 1, 2, 3])
+        if not real:
+            circ.rz(phi * phi, 3)
+            circ.rx(theta, 0)
+        return circ
+
+    def _target(self, circ, values):
+        """Return the energy of a bound circuit"""
+        circ = circ.assign_parameters(dict(zip(circ.parameters, values)))
+        circ.save_hamiltonian_expectation_value(self.OPER, range(4), label="energy")
+        result = self.backend(method="statevector").run(circ, shots=1).result()
+        self.assertTrue(result.success)
+        return result.data(0)["energy"]
+
+    def _test_session(self, real, **options):
+        circ = self._circuit(real)
+        session = AerSession(circ, self.OPER, backend=self.backend(method="statevector", **options))
+        self.assertEqual(session.real_amplitudes, real)
+        for values in [[0.1, 0.2], [0.1, -0.7], [1.3, -0.7], [0.1, 0.2]]:
+            self.assertAlmostEqual(session.evaluate(np.array(values)), self._target(circ, values))
+
+    def test_complex_session(self):
+        """Test evaluations of a complex circuit"""
+        self._test_session(False)
+
+    def test_real_session(self):
+        """Test evaluations of a real circuit"""
+        self._test_session(True, statevector_real_amplitudes=True)
+
+    def test_session_prefix_cache(self):
+        """Test evaluations resumed from the prefix cache"""
+        self._test_session(False, prefix_cache_max_memory_mb=1)
+
+    def test_session_observables(self):
+        """Test a session with several observables"""
+        circ = self._circuit(False)
+        opers = [self.OPER, qi.SparsePauliOp("ZIII")]
+        session = AerSession(circ, opers, backend=self.backend(method="statevector"))
+        values = [0.4, -0.3]
+        expvals = session.evaluate(values)
+        self.assertEqual(len(expvals), 2)
+        self.assertAlmostEqual(expvals[0], self._target(circ, values))
+
+    def test_session_truncation(self):
+        """Test parameters after an instruction removed by truncation"""
+        circ = QuantumCircuit(4)
+        circ.barrier()
+        circ.compose(self._circuit(False), inplace=True)
+        session = AerSession(
+            circ, self.OPER, backend=self.backend(method="statevector", enable_truncation=True)
+        )
+        for values in [[0.1, 0.2], [1.3, -0.7]]:
+            self.assertAlmostEqual(session.evaluate(np.array(values)), self._target(circ, values))
+
+    def test_session_noise(self):
+        """Test a session rejects a noise model"""
+        noise_model = NoiseModel()
+        noise_model.add_all_qubit_quantum_error(depolarizing_error(0.1, 1), ["h"])
+        backend = self.backend(method="statevector", noise_model=noise_model)
+        with self.assertRaises(Exception):
+            AerSession(self._circuit(False), self.OPER, backend=backend)
+
+    def test_session_gradient(self):
+        """Test the session gradient against finite differences"""
+        circ = self._circuit(False)
+        backend = self.backend(method="statevector")
+        session = AerSession(circ, self.OPER, backend=backend, gradient=True)
+        values = np.array([0.4, -0.3])
+        energy, grad = session.gradient(values)
+        self.assertAlmostEqual(energy, self._target(circ, values))
+        eps = 1e-5
+        targets = [
+            (session.evaluate(values + shift) - session.evaluate(values - shift)) / (2 * eps)
+            for shift in eps * np.eye(2)
+        ]
+        self.assertTrue(np.allclose(grad, targets, atol=1e-6))
@@ -0,0 +1,58 @@
+# This code is part of Qiskit.
+#
+# (C) Copyright IBM 2018, 2021.
+#
+# This code is licensed under the Apache License, Version 2.0. You may
+# obtain a copy of this license in the LICENSE.txt file in the root directory
+# of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+#
+# Any modifications or derivative works of this code must retain this
+# copyright notice, and modified files need to carry a notice indicating
+# that they have been altered from the originals.
+"""
+Integration Tests for the MOSQ_CR rewrite of Pauli rotations
+"""
+
+from numpy import allclose
+from test.terra.backends.simulator_test_case import SimulatorTestCase
+from qiskit.circuit import QuantumCircuit
+from qiskit.circuit.library import PauliEvolutionGate
+from qiskit.quantum_info import SparsePauliOp
+
+
+class TestMOSQRewrite(SimulatorTestCase):
+    """Test the mosq_rewrite_enable option."""
+
+    PAULIS = ["XXYZ", "IYZI", "ZIIZ", "YXIX", "IIXI", "YYII", "ZXIY"]
+
+    def _circuit(self):
+        """Return a decomposed circuit of Pauli evolution gates"""
+        circ = QuantumCircuit(4)
+        circ.u(0.3, 0.7, -0.4, 0)
+        circ.u(1.1, -0.2, 0.5, 2)
+        for i, pauli in enumerate(self.PAULIS):
+            circ.append(PauliEvolutionGate(SparsePauliOp(pauli), 0.1 + 0.2 * i), range(4))
+        circ = circ.decompose(gates_to_decompose=[PauliEvolutionGate])
+        circ.save_hamiltonian_expectation_value(
+            SparsePauliOp(["XYZI", "ZZII", "IXXY"], [0.5, -1.2, 0.7]), range(4), label="energy"
+        )
+        circ.save_probabilities()
+        return circ
+
+    def test_mosq_rewrite(self):
+        """Test rewritten circuits match the decomposed circuit"""
+        value, metadata = self.run_data(
+            self._circuit(), method="statevector", mosq_rewrite_enable=True
+        )
+        target, _ = self.run_data(self._circuit(), method="statevector", mosq_rewrite_enable=False)
+        self.assertTrue(allclose(value["energy"], target["energy"]))
+        self.assertTrue(allclose(value["probabilities"], target["probabilities"]))
+        self.assertTrue(metadata["mosq_rewrite"]["applied"])
+        self.assertEqual(metadata["mosq_rewrite"]["num_rotations"], len(self.PAULIS))
+
+    def test_mosq_rewrite_disabled(self):
+        """Test the rewrite is disabled by default"""
+        backend = self.backend(method="statevector")
+        result = backend.run(self._circuit(), shots=1).result()
+        self.assertTrue(result.success)
+        self.assertFalse(result.results[0].metadata["mosq_rewrite"]["enabled"])
@@ -0,0 +1,81 @@
+# This code is part of Qiskit.
+#
+# (C) Copyright IBM 2018, 2021.
+#
+# This code is licensed under the Apache License, Version 2.0. You may
+# obtain a copy of this license in the LICENSE.txt file in the root directory
+# of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+#
+# Any modifications or derivative works of this code must retain this
+# copyright notice, and modified files need to carry a notice indicating
+# that they have been altered from the originals.
+"""
+Integration Tests for the persistent parallel region of the statevector
+"""
+
+from numpy import allclose
+from test.terra.backends.simulator_test_case import SimulatorTestCase
+from qiskit.circuit import Gate, QuantumCircuit
+from qiskit.circuit.library import MCXGrayCode
+
+
+class TestPersistentParallel(SimulatorTestCase):
+    """Test the statevector_persistent_parallel option."""
+
+    OPTIONS = {
+        "seed_simulator": 9000,
+        "method": "statevector",
+        "statevector_parallel_threshold": 2,
+        "max_parallel_threads": 4,
+        "fusion_enable": False,
+    }
+
+    def _test_persistent(self, circ):
+        """Test the persistent runs give the statevector of per-gate regions"""
+        circ = circ.copy()
+        circ.save_statevector()
+        value, metadata = self.run_data(circ, statevector_persistent_parallel=True)
+        target, target_metadata = self.run_data(circ, statevector_persistent_parallel=False)
+        self.assertTrue(allclose(value["statevector"], target["statevector"]))
+        self.assertNotIn("persistent_parallel", target_metadata)
+        # Aer caps the threads at the OpenMP maximum, and the slices need several.
+        # test_persistent_parallel.cpp sets the threads to cover this case.
+        if metadata["parallel_state_update"] < 2:
+            self.skipTest("the slices need several OpenMP threads")
+        self.assertGreater(metadata["persistent_parallel"]["runs"], 0)
+
+    def test_slice_local_and_crossing_ops(self):
+        """Test runs of slice-local ops give the statevector of per-gate regions"""
+        circ = QuantumCircuit(6)
+        for qubit in range(6):
+            circ.h(qubit)
+            circ.rz(0.1 * qubit + 0.2, qubit)
+        # Controls on the highest qubits, which select the slices
+        circ.cx(5, 0)
+        circ.ccx(5, 4, 1)
+        circ.cp(0.7, 4, 2)
+        circ.cswap(5, 0, 1)
+        # Pauli rotations with Z on the highest qubits, and one crossing them
+        circ.append(Gate("MOSQ_CR", 3, [0.3, 1, 2, 32]), [0, 1, 5])
+        circ.append(Gate("MOSQ_CR", 2, [0.5, 0, 0, 48]), [4, 5])
+        circ.append(Gate("MOSQ_CR", 2, [0.6, 32, 0, 1]), [0, 5])
+        circ.append(Gate("MOSQ", 3, [0.8]), [0, 4, 5])
+        circ.cx(0, 5)
+        for qubit in range(6):
+            circ.ry(0.3 + 0.05 * qubit, qubit)
+        circ.cx(1, 2)
+
+        self._test_persistent(circ)
+
+    def test_gray_code_mcx(self):
+        """Test a gray-code MCX controlled by the qubits selecting the slices"""
+        circ = QuantumCircuit(6)
+        for qubit in range(6):
+            circ.h(qubit)
+            circ.rz(0.1 * qubit + 0.2, qubit)
+        circ.append(MCXGrayCode(2), [5, 4, 0])
+        circ.append(MCXGrayCode(2), [2, 3, 1])
+        for qubit in range(6):
+            circ.ry(0.3 + 0.05 * qubit, qubit)
+
+        self._test_persistent(circ)
@@ -0,0 +1,58 @@
+# This code is part of Qiskit.
+#
+# (C) Copyright IBM 2018, 2021.
+#
+# This code is licensed under the Apache License, Version 2.0. You may
+# obtain a copy of this license in the LICENSE.txt file in the root directory
+# of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+#
+# Any modifications or derivative works of this code must retain this
+# copyright notice, and modified files need to carry a notice indicating
+# that they have been altered from the originals.
+"""
+Integration Tests for the statevector prefix cache
+"""
+
+from numpy import allclose
+from test.terra.backends.simulator_test_case import SimulatorTestCase
+from qiskit.circuit import Gate, QuantumCircuit
+
+
+class TestPrefixCache(SimulatorTestCase):
+    """Test the prefix_cache_max_memory_mb option."""
+
+    def _circuit(self, thetas):
+        """Return a circuit of MOSQ_CR rotations with the given angles"""
+        circ = QuantumCircuit(4)
+        circ.x(0)
+        circ.x(2)
+        for i, theta in enumerate(thetas):
+            p, r = i % 2, 2 + (i + 1) % 2
+            circ.append(Gate("MOSQ_CR", 4, [theta, 1 << p, 1 << r, 0]), range(4))
+            circ.append(Gate("MOSQ_CR", 4, [-theta, 1 << r, 1 << p, 0]), range(4))
+        circ.rz(0.3, 1)
+        circ.save_statevector()
+        return circ
+
+    def _run(self, thetas, memory_mb, real):
+        """Return the statevector and metadata of a run"""
+        data, metadata = self.run_data(
+            self._circuit(thetas),
+            method="statevector",
+            prefix_cache_max_memory_mb=memory_mb,
+            statevector_real_amplitudes=real,
+        )
+        return data["statevector"], metadata
+
+    def test_prefix_cache(self):
+        """Test runs resuming from snapshots match runs without the cache"""
+        for real in [True, False]:
+            runs = [[0.1, 0.2, 0.3, 0.4], [0.1, 0.2, 0.3, 0.5], [0.1, 0.7, 0.3, 0.5]]
+            for i, thetas in enumerate(runs):
+                value, metadata = self._run(thetas, 16, real)
+                target, _ = self._run(thetas, 0, real)
+                self.assertTrue(allclose(value, target))
+                self.assertIn("prefix_cache", metadata)
+                if i > 0:
+                    self.assertTrue(metadata["prefix_cache"]["hit"])
+                    self.assertGreater(metadata["prefix_cache"]["bytes_saved"], 0)
@@ -0,0 +1,58 @@
+# This code is part of Qiskit.
+#
+# (C) Copyright IBM 2018, 2021.
+#
+# This code is licensed under the Apache License, Version 2.0. You may
+# obtain a copy of this license in the LICENSE.txt file in the root directory
+# of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+#
+# Any modifications or derivative works of this code must retain this
+# copyright notice, and modified files need to carry a notice indicating
+# that they have been altered from the originals.
+"""
+Integration Tests for real amplitude statevector simulation
+"""
+
+from numpy import allclose
+from test.terra.backends.simulator_test_case import SimulatorTestCase
+import qiskit.quantum_info as qi
+from qiskit.circuit import Gate, QuantumCircuit
+
+
+class TestRealAmplitudes(SimulatorTestCase):
+    """Test the statevector_real_amplitudes option."""
+
+    def _run(self, circ, real):
+        """Return the result data and metadata of a statevector simulation"""
+        oper = qi.SparsePauliOp.from_list([("IZZI", 0.3), ("XXYY", -0.2), ("XZXI", 0.1)])
+        circ = circ.copy()
+        circ.save_statevector()
+        circ.save_hamiltonian_expectation_value(oper, range(4), label="energy")
+        return self.run_data(circ, method="statevector", statevector_real_amplitudes=real)
+
+    def test_real_circuit(self):
+        """Test a real circuit is simulated with real amplitudes"""
+        circ = QuantumCircuit(4, global_phase=0.3)
+        circ.x(0)
+        circ.h(1)
+        circ.ry(0.4, 2)
+        circ.cx(1, 3)
+        circ.rz(3.141592653589793, 2)
+        # Pauli strings with one Y
+        circ.append(Gate("MOSQ_CR", 2, [0.7, 1, 4, 0]), [0, 2])
+        circ.append(Gate("MOSQ_CR", 4, [-0.2, 9, 2, 4]), [0, 1, 2, 3])
+
+        data, metadata = self._run(circ, True)
+        target, target_metadata = self._run(circ, False)
+        self.assertTrue(metadata.get("real_amplitudes", False))
+        self.assertFalse(target_metadata.get("real_amplitudes", False))
+        self.assertTrue(allclose(data["statevector"], target["statevector"]))
+        self.assertAlmostEqual(data["energy"], target["energy"])
+
+    def test_complex_circuit(self):
+        """Test a complex circuit is not simulated with real amplitudes"""
+        circ = QuantumCircuit(4)
+        circ.h(0)
+        circ.s(0)
+        _, metadata = self._run(circ, True)
+        self.assertFalse(metadata.get("real_amplitudes", False))
@@ -0,0 +1,108 @@
+# This code is part of Qiskit.
+#
+# (C) Copyright IBM 2018, 2021.
+#
+# This code is licensed under the Apache License, Version 2.0. You may
+# obtain a copy of this license in the LICENSE.txt file in the root directory
+# of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+#
+# Any modifications or derivative works of this code must retain this
+# copyright notice, and modified files need to carry a notice indicating
+# that they have been altered from the originals.
+"""
+Integration Tests for SaveEnergyGradient instruction
+"""
+
+import numpy as np
+from test.terra.backends.simulator_test_case import SimulatorTestCase
+import qiskit.quantum_info as qi
+from qiskit.circuit import Gate, QuantumCircuit
+from qiskit.compiler import transpile
+
+
+class TestSaveEnergyGradient(SimulatorTestCase):
+    """Test SaveEnergyGradient instruction against finite differences."""
+
+    OPER = qi.SparsePauliOp.from_list(
+        [("IZZI", 0.3), ("XXYY", -0.2), ("XZXI", 0.1), ("ZIIY", 0.4)]
+    )
+
+    @staticmethod
+    def _circuit(angles):
+        """Return a 4-qubit circuit with a rotation for each angle"""
+        circ = QuantumCircuit(4)
+        circ.h(0)
+        circ.rx(angles[0], 1)
+        circ.cx(0, 2)
+        circ.ry(angles[1], 2)
+        circ.s(1)
+        circ.rzz(angles[2], 1, 3)
+        circ.u(0.3, 0.7, -0.4, 3)
+        circ.append(Gate("MOSQ_CR", 4, [angles[3], 9, 2, 4]), [0, 1, 2, 3])
+        circ.rzx(angles[4], 0, 3)
+        circ.sx(2)
+        circ.rz(angles[5], 0)
+        return circ
+
+    def _energy(self, angles):
+        """Return the energy of the circuit"""
+        circ = self._circuit(angles)
+        circ.save_hamiltonian_expectation_value(self.OPER, range(4), label="energy")
+        backend = self.backend(method="statevector")
+        result = backend.run(transpile(circ, backend, optimization_level=0), shots=1).result()
+        self.assertTrue(result.success)
+        return result.data(0)["energy"]
+
+    def test_save_energy_gradient(self):
+        """Test the adjoint gradient of Pauli rotations"""
+        angles = np.array([0.4, -1.1, 0.7, 1.9, -0.3, 0.8])
+        circ = self._circuit(angles)
+        circ.save_energy_gradient(self.OPER, range(4), label="grad", energy_label="energy")
+        backend = self.backend(method="statevector")
+        result = backend.run(transpile(circ, backend, optimization_level=0), shots=1).result()
+        self.assertTrue(result.success)
+        simdata = result.data(0)
+        self.assertAlmostEqual(simdata["energy"], self._energy(angles))
+
+        eps = 1e-4
+        targets = []
+        for i in range(len(angles)):
+            shift = np.zeros(len(angles))
+            shift[i] = eps
+            diff = self._energy(angles + shift) - self._energy(angles - shift)
+            targets.append(diff / (2 * eps))
+        self.assertTrue(np.allclose(simdata["grad"], targets, atol=1e-6))
+
+    def test_save_energy_gradient_fusion(self):
+        """Test the gradient keeps one entry per rotation above the fusion threshold"""
+        angles = np.array([0.4, -1.1, 0.7, 1.9, -0.3, 0.8])
+        backend = self.backend(method="statevector")
+
+        grads = []
+        for fusion_enable in [False, True]:
+            circ = self._circuit(angles)
+            # Rotations with the same Pauli string that fusion would merge
+            circ.rz(0.2, 0)
+            circ.rz(-0.5, 0)
+            circ.save_energy_gradient(self.OPER, range(4), label="grad")
+            result = backend.run(
+                transpile(circ, backend, optimization_level=0),
+                shots=1,
+                fusion_enable=fusion_enable,
+                fusion_threshold=1,
+            ).result()
+            self.assertTrue(result.success)
+            self.assertFalse(result.results[0].metadata["fusion"].get("applied", False))
+            grads.append(result.data(0)["grad"])
+        self.assertEqual(len(grads[1]), len(angles) + 2)
+        self.assertTrue(np.allclose(grads[1], grads[0], atol=1e-10))
+
+    def test_save_energy_gradient_irreversible(self):
+        """Test the gradient fails for a circuit that can not be reversed"""
+        circ = QuantumCircuit(2)
+        circ.ry(0.3, 0)
+        circ.reset(1)
+        circ.save_energy_gradient(qi.SparsePauliOp("ZZ"), range(2))
+        backend = self.backend(method="statevector")
+        result = backend.run(circ, shots=1).result()
+        self.assertFalse(result.success)
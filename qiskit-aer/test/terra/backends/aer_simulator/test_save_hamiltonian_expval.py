@@ -0,0 +1,90 @@
+# This code is part of Qiskit.
+#
+# (C) Copyright IBM 2018, 2021.
+#
+# This code is licensed under the Apache License, Version 2.0. You may
+# obtain a copy of this license in the LICENSE.txt file in the root directory
+# of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+#
+# Any modifications or derivative works of this code must retain this
+# copyright notice, and modified files need to carry a notice indicating
+# that they have been altered from the originals.
+"""
+Integration Tests for SaveHamiltonianExpval instruction
+"""
+
+import os
+import tempfile
+from ddt import ddt
+from numpy import allclose
+from test.terra.backends.simulator_test_case import SimulatorTestCase, supported_methods
+import qiskit.quantum_info as qi
+from qiskit.circuit.library import QuantumVolume
+from qiskit.compiler import transpile
+from qiskit_aer.quantum_info import QubitHamiltonian
+
+
+@ddt
+class TestSaveHamiltonianExpectationValueTests(SimulatorTestCase):
+    """Test SaveHamiltonianExpectationValue instruction."""
+
+    def _test_save_hamiltonian_expval(self, circuit, oper, qubits, **options):
+        """Test Pauli sum expval and per term values"""
+        backend = self.backend(**options)
+        label = "energy"
+        term_label = "terms"
+
+        circ = circuit.copy()
+        state = qi.Statevector(circ)
+        terms = oper.to_sparse_pauli_op() if isinstance(oper, QubitHamiltonian) else oper
+        target = state.expectation_value(terms, qubits).real
+        term_targets = [
+            state.expectation_value(qi.Pauli(pauli), qubits).real
+            for pauli in terms.paulis.to_labels()
+        ]
+        circ.save_hamiltonian_expectation_value(
+            oper, qubits, label=label, per_term_label=term_label
+        )
+
+        result = backend.run(transpile(circ, backend, optimization_level=0), shots=1).result()
+        self.assertTrue(result.success)
+        simdata = result.data(0)
+        self.assertIn(label, simdata)
+        self.assertAlmostEqual(simdata[label], target)
+        self.assertTrue(allclose(simdata[term_label], term_targets))
+
+    @supported_methods(["automatic", "statevector"], [[0, 1, 2], [2, 0, 1], [1, 2]])
+    def test_save_hamiltonian_expval_qv(self, method, device, qubits):
+        """Test Pauli sum expval for a random circuit"""
+        SEED = 5832
+        circ = transpile(QuantumVolume(3, seed=SEED), basis_gates=["u", "cx"])
+        labels = ["XXII", "ZZYY", "ZZZZ", "YXYX", "ZIZI", "IZIZ"]
+        oper = qi.SparsePauliOp.from_list(
+            [(label[-len(qubits) :], 0.1 * (i + 1)) for i, label in enumerate(labels)]
+        )
+        self._test_save_hamiltonian_expval(circ, oper, qubits, method=method, device=device)
+
+    @supported_methods(["automatic", "statevector"], [[0, 1, 2], [2, 0, 1]])
+    def test_save_hamiltonian_expval_file(self, method, device, qubits):
+        """Test Pauli sum expval loaded from a qubit Hamiltonian file"""
+        SEED = 5832
+        circ = transpile(QuantumVolume(3, seed=SEED), basis_gates=["u", "cx"])
+        oper = qi.SparsePauliOp.from_list(
+            [("XYZ", 0.5), ("IZZ", -0.25), ("YYI", 0.125), ("III", 1.5)]
+        )
+        with tempfile.TemporaryDirectory() as tmpdir:
+            hamiltonian = QubitHamiltonian.save(
+                os.path.join(tmpdir, "hamiltonian.bin"),
+                oper,
+                num_spatial_orbitals=2,
+                num_particles=(1, 1),
+                nuclear_repulsion_energy=0.75,
+            )
+            self.assertEqual(hamiltonian.num_qubits, 3)
+            self.assertEqual(hamiltonian.num_terms, 4)
+            self.assertEqual(hamiltonian.metadata["num_particles"], (1, 1))
+            self.assertEqual(hamiltonian.metadata["nuclear_repulsion_energy"], 0.75)
+            self.assertTrue(hamiltonian.to_sparse_pauli_op().equiv(oper))
+            self._test_save_hamiltonian_expval(
+                circ, hamiltonian, qubits, method=method, device=device
+            )
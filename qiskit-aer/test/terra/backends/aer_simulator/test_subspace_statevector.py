@@ -0,0 +1,68 @@
+# This code is part of Qiskit.
+#
+# (C) Copyright IBM 2018, 2021.
+#
+# This code is licensed under the Apache License, Version 2.0. You may
+# obtain a copy of this license in the LICENSE.txt file in the root directory
+# of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+#
+# Any modifications or derivative works of this code must retain this
+# copyright notice, and modified files need to carry a notice indicating
+# that they have been altered from the originals.
+"""
+Integration Tests for the subspace_statevector method
+"""
+
+from numpy import allclose
+from test.terra.backends.simulator_test_case import SimulatorTestCase
+import qiskit.quantum_info as qi
+from qiskit.circuit import Gate, QuantumCircuit
+
+
+def _excitation(circ, theta, p, r):
+    """Append a single excitation p -> r (p < r) as two MOSQ_CR rotations"""
+    z_mask = sum(1 << q for q in range(p + 1, r))
+    circ.append(Gate("MOSQ_CR", 2, [theta, 1 << p, 1 << r, z_mask]), [p, r])
+    circ.append(Gate("MOSQ_CR", 2, [-theta, 1 << r, 1 << p, z_mask]), [p, r])
+
+
+class TestSubspaceStatevector(SimulatorTestCase):
+    """Test the subspace_statevector method."""
+
+    def _circuit(self):
+        """Two electrons in each spin sector of 8 qubits"""
+        circ = QuantumCircuit(8)
+        for qubit in [0, 1, 4, 5]:
+            circ.x(qubit)
+        _excitation(circ, 0.3, 1, 2)
+        _excitation(circ, -0.7, 0, 3)
+        _excitation(circ, 0.5, 5, 7)
+        _excitation(circ, 0.2, 4, 6)
+        return circ
+
+    def test_subspace_statevector(self):
+        """Test the subspace statevector against the statevector method"""
+        oper = qi.SparsePauliOp.from_list(
+            [("IIIIIIZZ", 0.3), ("ZIIZIIII", -0.2), ("IIXXYYII", 0.1), ("YXXYIIII", 0.4)]
+        )
+        results = []
+        for method in ["statevector", "subspace_statevector"]:
+            circ = self._circuit()
+            circ.save_statevector()
+            circ.save_hamiltonian_expectation_value(oper, range(8), label="energy")
+            backend = self.backend(method=method)
+            result = backend.run(circ, shots=1).result()
+            self.assertTrue(result.success)
+            results.append(result.data(0))
+        self.assertTrue(allclose(results[0]["statevector"], results[1]["statevector"]))
+        self.assertAlmostEqual(results[0]["energy"], results[1]["energy"])
+
+    def test_subspace_statevector_leak(self):
+        """Test rotations leaving the sector raise an error"""
+        circ = QuantumCircuit(4)
+        circ.x(0)
+        circ.append(Gate("MOSQ_CR", 1, [0.5, 1, 0, 0]), [0])
+        circ.save_statevector()
+        backend = self.backend(method="subspace_statevector")
+        result = backend.run(circ, shots=1).result()
+        self.assertFalse(result.success)
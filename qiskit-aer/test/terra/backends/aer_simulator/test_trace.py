@@ -0,0 +1,55 @@
+# This code is part of Qiskit.
+#
+# (C) Copyright IBM 2018, 2021.
+#
+# This code is licensed under the Apache License, Version 2.0. You may
+# obtain a copy of this license in the LICENSE.txt file in the root directory
+# of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+#
+# Any modifications or derivative works of this code must retain this
+# copyright notice, and modified files need to carry a notice indicating
+# that they have been altered from the originals.
+"""
+Integration Tests for the Chrome trace export
+"""
+
+import json
+import os
+import tempfile
+from test.terra.backends.simulator_test_case import SimulatorTestCase
+from qiskit.circuit import QuantumCircuit
+
+
+class TestTrace(SimulatorTestCase):
+    """Test the trace_file option."""
+
+    def _events(self, filename):
+        """Return the events of a trace file"""
+        with open(filename, encoding="utf-8") as file:
+            return json.loads(file.read().rstrip().rstrip(",") + "]")
+
+    def test_trace_file(self):
+        """Test a run writes spans of its ops and passes"""
+        circ = QuantumCircuit(3)
+        circ.h(0)
+        circ.cx(0, 1)
+        circ.rz(0.3, 1)
+        circ.cx(0, 1)
+        circ.save_statevector()
+        with tempfile.TemporaryDirectory() as tmpdir:
+            filename = os.path.join(tmpdir, "trace.json")
+            backend = self.backend(method="statevector", trace_file=filename)
+            result = backend.run(circ, shots=1).result()
+            self.assertTrue(result.success)
+            events = self._events(filename)
+            names = {(event.get("cat"), event["name"]) for event in events}
+            self.assertIn(("op", "cx"), names)
+            self.assertIn(("transpile", "fusion"), names)
+            self.assertIn(("python", "compile"), names)
+            self.assertIn(("python", "format_result"), names)
+            ops = [event for event in events if event.get("cat") == "op"]
+            self.assertEqual(ops[0]["args"]["qubits"], [0])
+
+            # A second run appends to the timeline
+            backend.run(circ, shots=1).result()
+            self.assertEqual(len(self._events(filename)), 2 * len(events) - 1)
@@ -48,6 +48,12 @@ class SimulatorTestCase(QiskitAerTestCase):
                 sim_options["shot_branching_sampling_enable"] = True
         return self.BACKEND(**sim_options)
 
+    def run_data(self, circ, **options):
+        """Return the data and metadata of a successful single-shot run of a circuit"""
+        result = self.backend(**options).run(circ, shots=1).result()
+        self.assertTrue(result.success)
+        return result.data(0), result.results[0].metadata
+
 
 def supported_methods(methods, *other_args, product=True):
     """ddt decorator for iterating over supported methods and args"""
@@ -0,0 +1,150 @@
+# This code is part of Qiskit.
+#
+# (C) Copyright IBM 2024.
+#
+# This code is licensed under the Apache License, Version 2.0. You may
+# obtain a copy of this license in the LICENSE.txt file in the root directory
+# of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+#
+# Any modifications or derivative works of this code must retain this
+# copyright notice, and modified files need to carry a notice indicating
+# that they have been altered from the originals.
+"""
+Tests for the Jordan-Wigner mapping of QubitHamiltonian
+"""
+
+import os
+import tempfile
+import unittest
+
+import numpy as np
+
+from test.terra import common
+from qiskit_aer.quantum_info import QubitHamiltonian
+
+# Fermionic operator of H2 from the MOSQ molecule cache
+H2_TERMS = {
+    "+_0 -_0": -1.2521011771187973,
+    "+_1 -_1": -0.4763246662830587,
+    "+_2 -_2": -1.2521011771187973,
+    "+_3 -_3": -0.4763246662830587,
+    "+_0 +_0 -_0 -_0": 0.3371871363510416,
+    "+_0 +_1 -_1 -_0": 0.3316819374820622,
+    "+_0 +_2 -_2 -_0": 0.3371871363510416,
+    "+_0 +_3 -_3 -_0": 0.3316819374820622,
+    "+_0 +_0 -_1 -_1": 0.09066120278229658,
+    "+_0 +_1 -_0 -_1": 0.09066120278229658,
+    "+_0 +_2 -_3 -_1": 0.09066120278229658,
+    "+_0 +_3 -_2 -_1": 0.09066120278229658,
+    "+_1 +_0 -_1 -_0": 0.09066120278229658,
+    "+_1 +_1 -_0 -_0": 0.09066120278229658,
+    "+_1 +_2 -_3 -_0": 0.09066120278229658,
+    "+_1 +_3 -_2 -_0": 0.09066120278229658,
+    "+_1 +_0 -_0 -_1": 0.3316819374820622,
+    "+_1 +_1 -_1 -_1": 0.3486416866888512,
+    "+_1 +_2 -_2 -_1": 0.3316819374820622,
+    "+_1 +_3 -_3 -_1": 0.3486416866888512,
+    "+_2 +_0 -_0 -_2": 0.3371871363510416,
+    "+_2 +_1 -_1 -_2": 0.3316819374820622,
+    "+_2 +_2 -_2 -_2": 0.3371871363510416,
+    "+_2 +_3 -_3 -_2": 0.3316819374820622,
+    "+_2 +_0 -_1 -_3": 0.09066120278229658,
+    "+_2 +_1 -_0 -_3": 0.09066120278229658,
+    "+_2 +_2 -_3 -_3": 0.09066120278229658,
+    "+_2 +_3 -_2 -_3": 0.09066120278229658,
+    "+_3 +_0 -_1 -_2": 0.09066120278229658,
+    "+_3 +_1 -_0 -_2": 0.09066120278229658,
+    "+_3 +_2 -_3 -_2": 0.09066120278229658,
+    "+_3 +_3 -_2 -_2": 0.09066120278229658,
+    "+_3 +_0 -_0 -_3": 0.3316819374820622,
+    "+_3 +_1 -_1 -_3": 0.3486416866888512,
+    "+_3 +_2 -_2 -_3": 0.3316819374820622,
+    "+_3 +_3 -_3 -_3": 0.3486416866888512,
+}
+
+
+def fermionic_matrix(terms, num_spin_orbitals):
+    """Dense matrix of a fermionic operator in the occupation basis, where
+    bit j of a basis state is the occupation of spin orbital j."""
+    dim = 2**num_spin_orbitals
+    mat = np.zeros((dim, dim), dtype=complex)
+    for label, coeff in terms.items():
+        ops = [(token[0] == "+", int(token[2:])) for token in label.split()]
+        for col in range(dim):
+            state, sign = col, 1
+            for creation, j in reversed(ops):
+                if bool((state >> j) & 1) == creation:
+                    break
+                sign *= (-1) ** bin(state & ((1 << j) - 1)).count("1")
+                state ^= 1 << j
+            else:
+                mat[state, col] += sign * coeff
+    return mat
+
+
+class TestQubitHamiltonian(common.QiskitAerTestCase):
+    """QubitHamiltonian Jordan-Wigner mapping tests"""
+
+    def setUp(self):
+        super().setUp()
+        self._tmpdir = tempfile.TemporaryDirectory()
+        self.filename = os.path.join(self._tmpdir.name, "hamiltonian.bin")
+
+    def tearDown(self):
+        self._tmpdir.cleanup()
+        super().tearDown()
+
+    def test_jordan_wigner_mapping(self):
+        """Test the mapping of FermionicOp labels"""
+        hamiltonian = QubitHamiltonian.from_fermionic_op(
+            self.filename, H2_TERMS, num_spatial_orbitals=2, num_particles=(1, 1)
+        )
+        self.assertEqual(hamiltonian.num_qubits, 4)
+        self.assertEqual(hamiltonian.num_terms, 15)
+        self.assertEqual(hamiltonian.metadata["num_particles"], (1, 1))
+        np.testing.assert_allclose(
+            hamiltonian.to_sparse_pauli_op().to_matrix(),
+            fermionic_matrix(H2_TERMS, 4),
+            atol=1e-12,
+        )
+
+    def test_jordan_wigner_text_file(self):
+        """Test the mapping of a fermionic operator text file"""
+        text = os.path.join(self._tmpdir.name, "H2_fermionic_op.txt")
+        with open(text, "w") as file:
+            file.write("Fermionic Operator\n")
+            file.write(f"number spin orbitals=4, number terms={len(H2_TERMS)}\n")
+            lines = [f"{coeff} * ( {label} )" for label, coeff in H2_TERMS.items()]
+            file.write("  " + "\n+ ".join(lines) + "\n")
+        hamiltonian = QubitHamiltonian.from_fermionic_op(self.filename, text)
+        self.assertEqual(hamiltonian.num_qubits, 4)
+        np.testing.assert_allclose(
+            hamiltonian.to_sparse_pauli_op().to_matrix(),
+            fermionic_matrix(H2_TERMS, 4),
+            atol=1e-12,
+        )
+
+    def test_jordan_wigner_threads(self):
+        """Test the mapping does not depend on the number of threads"""
+        rng = np.random.default_rng(1234)
+        terms = {}
+        for _ in range(2000):
+            p, q, r, s = rng.integers(0, 12, size=4)
+            coeff = rng.normal()
+            terms[f"+_{p} +_{q} -_{r} -_{s}"] = coeff
+            terms[f"+_{s} +_{r} -_{q} -_{p}"] = coeff
+        serial = QubitHamiltonian.from_fermionic_op(self.filename, terms, num_threads=1)
+        serial_op = serial.to_sparse_pauli_op()
+        parallel = QubitHamiltonian.from_fermionic_op(
+            os.path.join(self._tmpdir.name, "parallel.bin"), terms, num_threads=4
+        )
+        self.assertTrue(parallel.to_sparse_pauli_op().equiv(serial_op))
+
+    def test_jordan_wigner_not_hermitian(self):
+        """Test the mapping of a non-Hermitian operator fails"""
+        with self.assertRaises(ValueError):
+            QubitHamiltonian.from_fermionic_op(self.filename, {"+_0 -_1": 1.0})
+
+
+if __name__ == "__main__":
+    unittest.main()
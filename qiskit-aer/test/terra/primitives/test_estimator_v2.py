@@ -14,6 +14,8 @@
 
 from __future__ import annotations
 
+import os
+import tempfile
 import unittest
 from test.terra.common import QiskitAerTestCase
 
@@ -29,6 +31,8 @@ from qiskit.transpiler.preset_passmanagers import generate_preset_pass_manager
 
 from qiskit_aer import AerSimulator
 from qiskit_aer.primitives import EstimatorV2
+from qiskit_aer.primitives.simulation_strategy import SIMULATION_STRATEGIES
+from qiskit_aer.quantum_info import QubitHamiltonian
 
 
 class TestEstimatorV2(QiskitAerTestCase):
@@ -347,6 +351,65 @@ class TestEstimatorV2(QiskitAerTestCase):
         result = job.result()
         np.testing.assert_allclose(result[0].data.evs, [1.5555572817900956], rtol=self._rtol)
 
+    def test_run_batched_params(self):
+        """Test many parameter sets evaluated by one executor call"""
+        qc = QuantumCircuit(2)
+        thetas = [Parameter(f"t{i}") for i in range(4)]
+        qc.h(0)
+        qc.ry(thetas[0], 0)
+        qc.ry(thetas[1], 1)
+        qc.rz(thetas[2], 0)
+        qc.rx(thetas[3], 1)
+        op = SparsePauliOp.from_list([("ZZ", 0.5), ("XI", -0.3), ("IY", 0.2)])
+        params_array = self._rng.random((3, 8, qc.num_parameters))
+        target = StatevectorEstimator().run([(qc, op, params_array)]).result()
+
+        estimator = EstimatorV2(options={"run_options": {"seed_simulator": self._seed}})
+        result = estimator.run([(qc, op, params_array)]).result()
+        self.assertEqual(result[0].data.evs.shape, (3, 8))
+        np.testing.assert_allclose(result[0].data.evs, target[0].data.evs, atol=1e-8)
+
+    def test_run_auto_strategy(self):
+        """Test the simulation strategy selected by the first run is kept"""
+        qc = QuantumCircuit(2)
+        thetas = [Parameter(f"t{i}") for i in range(2)]
+        qc.h(0)
+        qc.cx(0, 1)
+        qc.rzz(thetas[0], 0, 1)
+        qc.rx(thetas[1], 1)
+        op = SparsePauliOp.from_list([("ZZ", 0.5), ("XI", -0.3), ("IY", 0.2)])
+        params_array = self._rng.random((4, qc.num_parameters))
+        target = StatevectorEstimator().run([(qc, op, params_array)]).result()
+
+        estimator = EstimatorV2(options={"run_options": {"simulation_strategy": "auto"}})
+        result = estimator.run([(qc, op, params_array)]).result()
+        np.testing.assert_allclose(result[0].data.evs, target[0].data.evs, atol=1e-8)
+        selector = estimator._strategy_selector
+        self.assertIn(selector.strategy, SIMULATION_STRATEGIES)
+        self.assertEqual(set(selector.timings), set(SIMULATION_STRATEGIES))
+        strategy = selector.strategy
+        result = estimator.run([(qc, op, params_array)]).result()
+        np.testing.assert_allclose(result[0].data.evs, target[0].data.evs, atol=1e-8)
+        self.assertEqual(selector.strategy, strategy)
+
+    def test_run_hamiltonian_file(self):
+        """Test a pub whose observable is a Hamiltonian file"""
+        qc = QuantumCircuit(2)
+        thetas = [Parameter(f"t{i}") for i in range(2)]
+        qc.h(0)
+        qc.ry(thetas[0], 0)
+        qc.rzz(thetas[1], 0, 1)
+        op = SparsePauliOp.from_list([("ZZ", 0.5), ("XI", -0.3), ("IY", 0.2)])
+        params_array = self._rng.random((3, qc.num_parameters))
+        target = StatevectorEstimator().run([(qc, op, params_array)]).result()
+
+        with tempfile.TemporaryDirectory() as tmpdir:
+            hamiltonian = QubitHamiltonian.save(os.path.join(tmpdir, "op.bin"), op)
+            estimator = EstimatorV2(options={"run_options": {"seed_simulator": self._seed}})
+            result = estimator.run([(qc, hamiltonian, params_array)]).result()
+            self.assertEqual(result[0].data.evs.shape, (3,))
+            np.testing.assert_allclose(result[0].data.evs, target[0].data.evs, atol=1e-8)
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -540,6 +540,15 @@ BACKEND_RUN_ARG_TYPES = {
     "fusion_parallelization_threshold": (int, np.integer),
     "target_gpus": (list),
     "runtime_parameter_bind_enable": (bool, np.bool_),
+    "simulation_strategy": (str),
+    "trace_file": (str),
+    "mosq_rewrite_enable": (bool, np.bool_),
+    "mosq_block_enable": (bool, np.bool_),
+    "mosq_block_max_qubit": (int, np.integer),
+    "subspace_spin_sectors": (bool, np.bool_),
+    "statevector_real_amplitudes": (bool, np.bool_),
+    "prefix_cache_max_memory_mb": (int, np.integer),
+    "statevector_persistent_parallel": (bool, np.bool_),
 }
 
 
@@ -825,10 +834,15 @@ def _assemble_op(
         "mcu", "mcu1", "mcu2", "mcu3", "mcx", "mcx_gray", "mcy", "mcz", "p", "r",
         "rx", "rxx", "ry", "ryy", "rz", "rzx", "rzz", "s", "sdg", "swap", "sx", "sxdg",
         "t", "tdg", "u", "x", "y", "z", "u1", "u2", "u3", "cu", "cu1", "cu2", "cu3",
-        "SDG+H", "H+S", "MOSQ", "MOSQ_CR", #SW
+        "SDG+H", "H+S", "MOSQ", #SW
     }:
         aer_circ.gate(name, qubits, params, [], conditional_reg, aer_cond_expr,
                       label if label else name)
+    elif name == "MOSQ_CR": #SW
+        # params are [theta, X_idx, Y_idx, Z_idx]; only theta is a parameter and
+        # the Pauli masks are passed as 64-bit integers
+        aer_circ.mosq_cr(qubits, params[0], int(params[1]), int(params[2]), int(params[3]),
+                         conditional_reg, aer_cond_expr, label if label else name)
     elif name == "measure":
         if is_conditional:
             aer_circ.measure(qubits, clbits, clbits)
@@ -890,6 +904,49 @@ def _assemble_op(
             operation._subtype,
             label if label else name,
         )
+    elif name == "save_hamiltonian_expval" and operation.hamiltonian_file:
+        _check_no_conditional(name, conditional_reg)
+        aer_circ.save_hamiltonian_expval_file(
+            qubits,
+            name,
+            operation.hamiltonian_file,
+            operation._subtype,
+            label if label else name,
+            operation.per_term_label or "",
+        )
+    elif name == "save_energy_gradient" and operation.hamiltonian_file:
+        _check_no_conditional(name, conditional_reg)
+        aer_circ.save_hamiltonian_expval_file(
+            qubits,
+            name,
+            operation.hamiltonian_file,
+            operation._subtype,
+            label if label else name,
+            operation.energy_label or "",
+        )
+    elif name == "save_hamiltonian_expval":
+        _check_no_conditional(name, conditional_reg)
+        aer_circ.save_hamiltonian_expval(
+            qubits,
+            name,
+            [term[0] for term in params],
+            [term[1] for term in params],
+            [term[2] for term in params],
+            operation._subtype,
+            label if label else name,
+            operation.per_term_label or "",
+        )
+    elif name == "save_energy_gradient":
+        _check_no_conditional(name, conditional_reg)
+        aer_circ.save_energy_gradient(
+            qubits,
+            [term[0] for term in params],
+            [term[1] for term in params],
+            [term[2] for term in params],
+            operation._subtype,
+            label if label else name,
+            operation.energy_label or "",
+        )
     elif name == "set_statevector":
         _check_no_conditional(name, conditional_reg)
         aer_circ.set_statevector(qubits, params)
@@ -18,13 +18,16 @@ from collections.abc import Iterable
 from dataclasses import dataclass, field
 
 import numpy as np
+from qiskit.circuit.library import PauliEvolutionGate
 from qiskit.primitives.base import BaseEstimatorV2
 from qiskit.primitives.containers import EstimatorPubLike, PrimitiveResult, PubResult
 from qiskit.primitives.containers.estimator_pub import EstimatorPub
 from qiskit.primitives.primitive_job import PrimitiveJob
-from qiskit.quantum_info import Pauli
+from qiskit.quantum_info import SparsePauliOp
 
-from qiskit_aer import AerSimulator
+from qiskit_aer import AerSession, AerSimulator
+from qiskit_aer.quantum_info import QubitHamiltonian
+from qiskit_aer.primitives.simulation_strategy import StrategySelector
 
 
 @dataclass
@@ -54,7 +57,9 @@ class EstimatorV2(BaseEstimatorV2):
     * ``backend_options``: Options passed to AerSimulator.
       Default: {}.
 
-    * ``run_options``: Options passed to :meth:`AerSimulator.run`.
+    * ``run_options``: Options passed to :meth:`AerSimulator.run`. With
+      ``simulation_strategy="auto"`` the first run times each simulation
+      strategy and later runs use the fastest one.
       Default: {}.
     """
 
@@ -77,6 +82,8 @@ class EstimatorV2(BaseEstimatorV2):
         self._sim_time = 0
         self._exp_time = 0
         self._transpiled_circuit = None
+        self._strategy_selector = StrategySelector()
+        self._gradient_session = None
 
     def from_backend(self, backend, **options):
         """use external backend"""
@@ -92,8 +99,8 @@ class EstimatorV2(BaseEstimatorV2):
     ) -> PrimitiveJob[PrimitiveResult[PubResult]]:
         if precision is None:
             precision = self._options.default_precision
-        coerced_pubs = [EstimatorPub.coerce(pub, precision) for pub in pubs]
-        self._validate_pubs(coerced_pubs)
+        coerced_pubs = [_coerce_pub(pub, precision) for pub in pubs]
+        self._validate_pubs([pub for pub, _ in coerced_pubs])
         job = PrimitiveJob(self._run, coerced_pubs)
         job._submit()
         return job
@@ -106,10 +113,79 @@ class EstimatorV2(BaseEstimatorV2):
                     "But precision should be equal to or larger than 0.",
                 )
 
-    def _run(self, pubs: list[EstimatorPub]) -> PrimitiveResult[PubResult]:
-        return PrimitiveResult([self._run_pub(pub) for pub in pubs])
+    def _run(
+        self, pubs: list[tuple[EstimatorPub, QubitHamiltonian | None]]
+    ) -> PrimitiveResult[PubResult]:
+        return PrimitiveResult([self._run_pub(pub, hamiltonian) for pub, hamiltonian in pubs])
 
-    def _run_pub(self, pub: EstimatorPub) -> PubResult:
+    #SW
+    def session(self, circuit, observable, gradient=False) -> AerSession:
+        """Return a session evaluating the expectation value of an observable.
+
+        The circuit is compiled once and kept in the simulator with its
+        statevector, so calling ``session.evaluate(parameter_values)`` in an
+        optimizer loop only pays for the simulation.
+
+        Args:
+            circuit: parameterized circuit.
+            observable: observable accepted by :class:`~.SparsePauliOp`, or a
+                :class:`~qiskit_aer.quantum_info.QubitHamiltonian` whose file
+                is loaded by the simulator.
+            gradient: prepare the session for ``session.gradient``.
+
+        Returns:
+            AerSession: session whose parameters are ``circuit.parameters``.
+        """
+        return AerSession(
+            self._transpile_circuit(circuit),
+            observable,
+            backend=self._backend,
+            gradient=gradient,
+            **self._run_options(),
+        )
+
+    #SW
+    def gradient(self, circuit, observable, parameter_values):
+        """Return the expectation value of an observable and its gradient.
+
+        The gradient with respect to ``circuit.parameters`` is computed by
+        the adjoint method in one reverse sweep over the circuit, which
+        makes gradient based optimizers such as L-BFGS affordable. The
+        session of the last circuit and observable is reused.
+
+        Args:
+            circuit: parameterized circuit.
+            observable: observable accepted by :class:`~.SparsePauliOp`, or a
+                :class:`~qiskit_aer.quantum_info.QubitHamiltonian` whose file
+                is loaded by the simulator.
+            parameter_values: values in the order of ``circuit.parameters``.
+
+        Returns:
+            tuple: the expectation value and its gradient.
+        """
+        cached = self._gradient_session
+        if cached is None or cached[0] is not circuit or cached[1] is not observable:
+            cached = (circuit, observable, self.session(circuit, observable, gradient=True))
+            self._gradient_session = cached
+        return cached[2].gradient(parameter_values)
+
+    #SW
+    def _transpile_circuit(self, circuit):
+        """Return the circuit with its Pauli evolution gates expanded for MOSQ
+
+        The gates are decomposed into basis changes, CX ladders and RZ
+        rotations, which the simulator rewrites into MOSQ_CR operations when
+        ``mosq_rewrite_enable`` is set.
+        """
+        return circuit.decompose(gates_to_decompose=[PauliEvolutionGate])
+
+    def _run_options(self):
+        """Return the run options with the MOSQ_CR rewrite enabled"""
+        run_options = dict(self.options.run_options)
+        run_options.setdefault("mosq_rewrite_enable", True)
+        return run_options
+
+    def _run_pub(self, pub: EstimatorPub, hamiltonian: QubitHamiltonian | None = None) -> PubResult:
         import time #SW
         etc_start_time = time.time() #SW
         circuit = pub.circuit.copy()
@@ -118,83 +194,29 @@ class EstimatorV2(BaseEstimatorV2):
         precision = pub.precision
         
         #SW: add MOSQ
-        if self._transpiled_circuit: #use a cache
-            trans_circuit = self._transpiled_circuit
+        # one energy is saved per distinct observable of the pub, and the terms
+        # of a Hamiltonian file are read by the simulator
+        def obs_key(obs_dict):
+            if hamiltonian is not None:
+                return hamiltonian.filename
+            return tuple(sorted(obs_dict.items()))
+
+        energy_labels = {}
+        for obs_dict in observables.ravel():
+            energy_labels.setdefault(obs_key(obs_dict), f"energy_{len(energy_labels)}")
+        if self._transpiled_circuit and self._transpiled_circuit[0] == energy_labels: #use a cache
+            trans_circuit = self._transpiled_circuit[1]
         else:
-            #MOSQ
-            trans_circuit = [] # transpiled quantum circuit
-            qreg = circuit[0].qubits[0]._register # Quantum Register
-            for i_pauli in range(len(circuit)):
-                subcirc_inst = circuit[i_pauli] #CircuitInstruction
-                # print(subcirc_inst)
-                oper_subcirc = subcirc_inst.operation #Gate
-                # print(oper_subcirc)
-                def_oper = oper_subcirc.definition #QuantumCircuit = list of CircuitInstructions
-                # print(def_oper)
-                qubit_idx = []
-                before_RZ = True
-                CNOT_cnt = 0
-                if len(def_oper) == 1: # for U3 gates
-                    trans_circuit.append(subcirc_inst)
-                    # print(subcirc_inst)
-                else: # for pauli strings (ex: exp(it IIXY))
-                    for i in range(len(def_oper)):
-                        gate_type = str(type(def_oper[i][0]))
-                        if gate_type == "<class 'qiskit.circuit.library.standard_gates.rz.RZGate'>":
-                            name = subcirc_inst.operation.name
-                            name = name.split(' ')[1].strip(')')
-                            # print(name)
-                            # params = subcirc_inst.operation.params
-                            params = def_oper[i].operation.params
-                            # print(params)
-                            x_positions = [1 if char == 'X' else 0 for char in name]
-                            y_positions = [1 if char == 'Y' else 0 for char in name]
-                            z_positions = [1 if char in 'Z' else 0 for char in name]
-                            X_idx = int(''.join(map(str, x_positions)), 2)
-                            Y_idx = int(''.join(map(str, y_positions)), 2)
-                            Z_idx = int(''.join(map(str, z_positions)), 2)
-                            # print(X_idx)
-                            # print(Y_idx)
-                            # print(Z_idx)
-                            # inst_qreg = tuple((X_idx, Y_idx, Z_idx))
-                            qubit_idx.append(def_oper[i].qubits[0])
-                            params.append(X_idx)
-                            params.append(Y_idx)
-                            params.append(Z_idx)
-                            # print(params)
-                            # op_MOSQ_CR = oper_subcirc
-                            op_MOSQ_CR = def_oper[i].operation
-                            op_MOSQ_CR.name = 'MOSQ_CR'
-                            before_RZ = False
-                            CNOT_cnt += 1
-                            op_MOSQ_CR.num_qubits = CNOT_cnt
-                            # def_oper[i].operation.params = params
-                            op_MOSQ_CR.params = params
-                            # print(def_oper[i].operation.params)
-                            from qiskit._accelerate.circuit import CircuitInstruction
-                            MOSQ_CR_inst = CircuitInstruction(op_MOSQ_CR, qubit_idx)
-                            # MOSQ_CR_inst = CircuitInstruction(op_MOSQ_CR)
-                            trans_circuit.append(MOSQ_CR_inst)
-                            # print(MOSQ_CR_inst)
-                        # 밑에 거 추가하면 multi-qubit gate로 구현 가능
-                        elif gate_type == "<class '_SingletonCXGate'>":
-                            if before_RZ:
-                                CNOT_cnt += 1
-                                ctrl_qubit = def_oper[i].qubits[0]
-                                qubit_idx.append(ctrl_qubit)
-                    # print(qubit_idx)
-                    # print(CNOT_cnt)
+            trans_circuit = self._transpile_circuit(circuit)
             
-            from qiskit.circuit import QuantumCircuit
-            trans_circuit = QuantumCircuit.from_instructions(instructions=trans_circuit, qubits=qreg)
-            
-            # save expval
-            paulis = {pauli for obs_dict in observables.ravel() for pauli in obs_dict.keys()}
-            for pauli in paulis:
-                trans_circuit.save_expectation_value(
-                    Pauli(pauli), qubits=range(circuit.num_qubits), label=pauli
+            # save expval: each observable is evaluated by one instruction
+            for key, label in energy_labels.items():
+                trans_circuit.save_hamiltonian_expectation_value(
+                    hamiltonian if hamiltonian is not None else SparsePauliOp.from_list(list(key)),
+                    qubits=range(circuit.num_qubits),
+                    label=label,
                 )
-            self._transpiled_circuit = trans_circuit
+            self._transpiled_circuit = (energy_labels, trans_circuit)
             # print(trans_circuit)
 
         # calculate broadcasting of parameters and observables
@@ -215,10 +237,15 @@ class EstimatorV2(BaseEstimatorV2):
             
         # run simulation
         sim_start_time = time.time() #SW
-        result = self._backend.run(
-            trans_circuit, parameter_binds=[parameter_binds], **self.options.run_options
+        # all parameter sets are bound at runtime by a single executor call,
+        # which simulates them on parallel statevectors for small circuits
+        run_options = self._run_options()
+        if parameter_values.size > 1:
+            run_options.setdefault("runtime_parameter_bind_enable", True)
+        result = self._strategy_selector.run(
+            self._backend, trans_circuit, [parameter_binds], **run_options
             # circuit, parameter_binds=[parameter_binds], **self.options.run_options
-        ).result()
+        )
         sim_end_time = time.time() #SW
         self._sim_time += (sim_end_time - sim_start_time) #SW
         
@@ -227,30 +254,17 @@ class EstimatorV2(BaseEstimatorV2):
         flat_indices = list(param_indices.ravel())
         evs = np.zeros_like(bc_param_ind, dtype=float)
         stds = np.full(bc_param_ind.shape, precision)
-        for pauli, coeff in bc_obs[0].items():
-            expval = result.data(0)[pauli]
-            evs[0] += expval * coeff
+        result_index = {param_index: i for i, param_index in enumerate(flat_indices)}
+        for index in np.ndindex(*bc_param_ind.shape):
+            label = energy_labels[obs_key(bc_obs[index])]
+            evs[index] = result.data(result_index[bc_param_ind[index]])[label]
         data_bin_cls = self._make_data_bin(pub)
         data_bin = data_bin_cls(evs=evs, stds=stds)
         exp_end_time = time.time() #SW
         self._exp_time += (exp_end_time - exp_start_time) #SW
         
-        #SW: additional metadata
-        time_expval = result.results[0].metadata['time_expval']
-        time_Diag = result.results[0].metadata['time_Diag']
-        time_Fuse2 = result.results[0].metadata['time_Fuse2']
-        time_Fuse3 = result.results[0].metadata['time_Fuse3']
-        time_Fuse4 = result.results[0].metadata['time_Fuse4']
-        time_Fuse5 = result.results[0].metadata['time_Fuse5']
-        time_MOSQ = result.results[0].metadata['time_MOSQ']
-        time_MOSQ_CR = result.results[0].metadata['time_MOSQ_CR']
-        time_HS = result.results[0].metadata['time_HS']
-        time_SDGH = result.results[0].metadata['time_SDGH']
-        time_RZ = result.results[0].metadata['time_RZ']
-        time_CX = result.results[0].metadata['time_CX']
-        time_S = result.results[0].metadata['time_S']
-        time_SDG = result.results[0].metadata['time_SDG']
-        time_H = result.results[0].metadata['time_H']
+        #SW: op profile, emitted by builds with AER_PROFILING
+        profile = result.results[0].metadata.get("profile", {})
         
         etc_end_time = time.time() #SW
         self._sim_exp_etc_time += (etc_end_time - etc_start_time) #SW
@@ -258,20 +272,18 @@ class EstimatorV2(BaseEstimatorV2):
         return PubResult(
             data_bin,
             metadata={"target_precision": precision, "simulator_metadata": result.metadata,
-                      "time_expval": time_expval,
-                      "time_Diag": time_Diag,
-                      "time_Fuse2": time_Fuse2,
-                      "time_Fuse3": time_Fuse3,
-                      "time_Fuse4": time_Fuse4,
-                      "time_Fuse5": time_Fuse5,
-                      "time_MOSQ": time_MOSQ,
-                      "time_MOSQ_CR": time_MOSQ_CR,
-                      "time_HS": time_HS,
-                      "time_SDGH": time_SDGH,
-                      "time_RZ": time_RZ,
-                      "time_CX": time_CX,
-                      "time_S": time_S,
-                      "time_SDG": time_SDG,
-                      "time_H": time_H,
+                      "profile": profile,
                       },
         )
+
+
+def _coerce_pub(pub, precision):
+    """Return a coerced pub and the Hamiltonian file of a ``(circuit, QubitHamiltonian, ...)`` pub.
+
+    The terms of the file are not loaded into Python: the pub holds an identity
+    observable of the same width and the file is saved by the simulator.
+    """
+    if isinstance(pub, tuple) and len(pub) > 1 and isinstance(pub[1], QubitHamiltonian):
+        identity = SparsePauliOp("I" * pub[1].num_qubits)
+        return EstimatorPub.coerce((pub[0], identity) + tuple(pub[2:]), precision), pub[1]
+    return EstimatorPub.coerce(pub, precision), None
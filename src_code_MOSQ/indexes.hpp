@@ -175,9 +175,6 @@ const std::array<uint_t, 64> MASKS{{0ULL,
 template <typename list_t>
 uint_t index0(const list_t &qubits_sorted, const uint_t k);
 
-// uint_t index0_MOSQ_CR(uint_t X_idx, uint_t Z_idx, const uint_t k);//SW
-// uint_t index1_MOSQ_CR(uint_t X_idx, uint_t Z_idx, const uint_t k);//SW
-
 // Return a std::unique_ptr to an array of of 2^N in ints
 // each int corresponds to an N qubit bitstring for M-N qubit bits in state k,
 // and the specified N qubits in states [0, ..., 2^N - 1]
@@ -199,8 +196,6 @@ uint_t index0(const list_t &qubits_sorted, const uint_t k);
 // put into places 1 and 4).
 indexes_t indexes(const reg_t &qubits, const reg_t &qubits_sorted,
                   const uint_t k);
-// indexes_t indexes_MOSQ_CR(size_t num_q, uint_t X_idx, uint_t Z_idx,
-//                   const uint_t k);//SW
 
 // As above but returns a fixed sized array of of 2^N in ints
 template <size_t N>
@@ -254,26 +249,30 @@ inline indexes_t indexes(const reg_t &qubits, const reg_t &qubits_sorted,
   return ret;
 }
 
-// template <typename list_t>
-// uint_t index0_MOSQ_CR(uint_t X_idx, uint_t Z_idx, const uint_t k) {
-//   uint_t lowbits, retval = k;
-//   for (size_t j = 0; j < qubits_sorted.size(); j++) {
-//     lowbits = retval & MASKS[qubits_sorted[j]];
-//     retval >>= qubits_sorted[j];
-//     retval <<= qubits_sorted[j] + 1;
-//     retval |= lowbits;
-//   }
-//   return retval;
-// }//SW
-
-// inline indexes_t indexes_MOSQ_CR(size_t num_q, uint_t X_idx, uint_t Z_idx,
-//                          const uint_t k) {
-//   indexes_t ret(new uint_t[2]);
-//   // Get index0
-//   ret[0] = index0_MOSQ_CR(num_q, X_idx, k);
-//   ret[1] = index1_MOSQ_CR(num_q, Z_idx, ret[0]);
-//   return ret;
-// }//SW
+// Number of set bits of a bit mask
+inline uint_t mask_weight(const uint_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(mask);
+#else
+  uint_t count = mask;
+  count = (count & 0x5555555555555555) + ((count >> 1) & 0x5555555555555555);
+  count = (count & 0x3333333333333333) + ((count >> 2) & 0x3333333333333333);
+  count = (count & 0x0f0f0f0f0f0f0f0f) + ((count >> 4) & 0x0f0f0f0f0f0f0f0f);
+  return (count * 0x0101010101010101) >> 56;
+#endif
+}
+
+// Position of the highest set bit of a non-zero bit mask
+inline uint_t mask_highest_bit(const uint_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+  return 63 - __builtin_clzll(mask);
+#else
+  uint_t pos = 0;
+  for (uint_t m = mask >> 1; m; m >>= 1)
+    ++pos;
+  return pos;
+#endif
+}
 
 /*******************************************************************************
  *
@@ -330,169 +329,62 @@ inline void apply_lambda(const size_t start, const size_t stop,
   }
 }
 
-template <typename Lambda, typename list_t>
+// Diagonal Pauli Z-string update. The lambda is called for every index k
+// with the parity of k over `z_mask`, computed by a single masked popcount:
+//
+// [&](const uint_t k, const uint_t parity)->void
+template <typename Lambda>
 inline void apply_lambda_MOSQ(const size_t start, const size_t stop,
-                         const uint_t omp_threads, Lambda &&func,
-                         const list_t &qubits) {
+                              const uint_t omp_threads, Lambda &&func,
+                              const uint_t z_mask) {
   if (omp_threads > 1) {
 #pragma omp parallel for num_threads(omp_threads)
-    for (int_t k = int_t(start); k < int_t(stop); k++) {
-      //parity check
-      bool parity = false;
-      for (uint_t index : qubits) {
-        parity ^= ((k >> index) & 1);
-      }
-      //forward lambda only for parity(ind) == 1
-      if(parity) std::forward<Lambda>(func)(k);
-    }
+    for (int_t k = int_t(start); k < int_t(stop); k++)
+      std::forward<Lambda>(func)(k, mask_weight(k & z_mask) & 1);
   } else {
-    for (int_t k = int_t(start); k < int_t(stop); k++) {
-      //parity check
-      bool parity = false;
-      for (uint_t index : qubits) {
-        parity ^= ((k >> index) & 1);
-      }
-      //forward lambda only for parity(ind) == 1
-      if(parity) std::forward<Lambda>(func)(k);
-    }
+    for (int_t k = int_t(start); k < int_t(stop); k++)
+      std::forward<Lambda>(func)(k, mask_weight(k & z_mask) & 1);
   }
-}//SW
-
-template <typename Lambda, typename list_t, typename param_t>
+} //SW
+
+// Pauli rotation exp(-i theta/2 P) pair update for a Pauli string P with
+// X/Y bits `xy_mask`, Y bits `y_mask` and Z bits `z_mask` (xy_mask != 0).
+// The k-th pair is (i0, i1) where i0 is k with a zero inserted at the highest
+// bit of xy_mask and i1 = i0 ^ xy_mask. The lambda signature is
+//
+// [&](const areg_t<2> &inds, const uint_t sel)->void
+//
+// where `sel` = (num_y + 2 * parity(i0 & (y_mask | z_mask))) mod 4 selects
+// the phase i^sel of the off-diagonal matrix entries for that pair.
+template <typename Lambda>
 inline void apply_lambda_MOSQ_CR(const size_t start, const size_t stop,
-                         const uint_t omp_threads, Lambda &&func,
-                         const list_t &qubits,
-                         const param_t &mat0, const param_t &mat1, const param_t &mat2, const param_t &mat3,
-                         uint_t X_idx, uint_t Y_idx, uint_t Z_idx, size_t num_qubits_) {
-
-  // const auto NUM_QUBITS = qubits.size();
-  // const int_t END = stop >> NUM_QUBITS;
+                                 const uint_t omp_threads, Lambda &&func,
+                                 const uint_t xy_mask, const uint_t y_mask,
+                                 const uint_t z_mask) {
+  const uint_t x_max = mask_highest_bit(xy_mask);
+  const uint_t mask_u = ~MASKS[x_max + 1];
+  const uint_t mask_l = MASKS[x_max];
+  const uint_t yz_mask = y_mask | z_mask;
+  const uint_t num_y = mask_weight(y_mask);
   const int_t END = stop >> 1;
-  auto qubits_sorted = qubits;
-  std::sort(qubits_sorted.begin(), qubits_sorted.end());
 
-  //Y_idx 1 개수 세기
-  uint_t num_Y = 0;
-  uint_t temp = Y_idx;
-  while (temp) {
-    num_Y += (temp & 1);
-    temp >>= 1;
-  }
-  // std::cout << "(X_idx): " << std::bitset<32>(X_idx) << std::endl;
-  // std::cout << "(Y_idx): " << std::bitset<32>(Y_idx) << std::endl;
-  // std::cout << "(Z_idx): " << std::bitset<32>(Z_idx) << std::endl;
-  // std::cout << "(num_Y): " << num_Y << std::endl;
+  auto pair_func = [&](const uint_t k) -> void {
+    areg_t<2> inds;
+    inds[0] = ((k << 1) & mask_u) | (k & mask_l);
+    inds[1] = inds[0] ^ xy_mask;
+    const uint_t sel = (num_y + (mask_weight(inds[0] & yz_mask) << 1)) & 3;
+    std::forward<Lambda>(func)(inds, sel);
+  };
 
   if (omp_threads > 1) {
-#pragma omp parallel num_threads(omp_threads)
-    {
-#pragma omp for
-      for (int_t k = int_t(start); k < END; k += 1) {
-        //k번째 2x2 matmul에 대한 index 2개를 찾는 과정
-        //XY_idx의 가장 높은 1 위치를 찾아서 k 값의 그 위치에 0을 대입한 것이 idx0
-        //idx0 값에서 XY_idx에 대해 XOR를 취해주면 idx1
-        uint_t idx0, idx1, lowbits, XY_idx;
-        XY_idx = X_idx ^ Y_idx;
-        int highest_one_pos = -1;
-        for (int i = sizeof(XY_idx) * 8 - 1; i >= 0; --i) {
-            if ((XY_idx >> i) & 1) {
-                highest_one_pos = i;
-                break;
-            }
-        }
-        idx0 = k;
-        if(highest_one_pos > -1){
-          lowbits = idx0 & MASKS[highest_one_pos];
-          idx0 >>= highest_one_pos;
-          idx0 <<= highest_one_pos + 1;
-          idx0 |= lowbits;
-        }
-        idx1 = idx0 ^ XY_idx;
-        indexes_t inds(new uint_t[2]);
-        inds[0] = idx0;
-        inds[1] = idx1;
-
-        //matrix를 만드는 과정
-        //idx0의 Y_idx와 Z_idx에 대한 1 개수를 세서 Y,Z에 저장하면 matrix의 각 항은
-        //mat[0]=1+phase mat[1]=i^(num_Y-2*Y)*(-1)^(Z)*(1-phase)
-        //mat[2]=i^(2*Y-num_Y)*(-1)^(Z)*(1-phase) mat[3]=1+phase
-        uint_t Y_count = 0;
-        uint_t Z_count = 0;
-        uint_t Y_masked_value = Y_idx & idx0;
-        uint_t Z_masked_value = Z_idx & idx0;
-        for (size_t i = 0; i < sizeof(idx0) * 8; ++i) {
-            Y_count += (Y_masked_value & 1);
-            Y_masked_value >>= 1;
-            Z_count += (Z_masked_value & 1);
-            Z_masked_value >>= 1;
-        }
-        uint_t mat_sel = (num_Y - 2 * Y_count + 2 * Z_count) % 4;
-        // if(k < 10){
-        //   std::cout << "k: " << k << std::endl;
-        //   std::cout << "(idx0): " << std::bitset<32>(idx0) << std::endl;
-        //   std::cout << "(idx1): " << std::bitset<32>(idx1) << std::endl;
-        //   std::cout << "(mat_sel): " << mat_sel << std::endl;
-        // }
-        if(mat_sel==0) std::forward<Lambda>(func)(inds, mat0);
-        else if(mat_sel==1) std::forward<Lambda>(func)(inds, mat1);
-        else if(mat_sel==2) std::forward<Lambda>(func)(inds, mat2);
-        else if(mat_sel==3) std::forward<Lambda>(func)(inds, mat3);
-      }
-    }
+#pragma omp parallel for num_threads(omp_threads)
+    for (int_t k = int_t(start); k < END; k++)
+      pair_func(k);
   } else {
-    for (int_t k = int_t(start); k < END; k += 1) {
-        //k번째 2x2 matmul에 대한 index 2개를 찾는 과정
-        //XY_idx의 가장 높은 1 위치를 찾아서 k 값의 그 위치에 0을 대입한 것이 idx0
-        //idx0 값에서 XY_idx에 대해 XOR를 취해주면 idx1
-        uint_t idx0, idx1, lowbits, XY_idx;
-        XY_idx = X_idx ^ Y_idx;
-        int highest_one_pos = -1;
-        for (int i = sizeof(XY_idx) * 8 - 1; i >= 0; --i) {
-            if ((XY_idx >> i) & 1) {
-                highest_one_pos = i;
-                break;
-            }
-        }
-        idx0 = k;
-        if(highest_one_pos > -1){
-          lowbits = idx0 & MASKS[highest_one_pos];
-          idx0 >>= highest_one_pos;
-          idx0 <<= highest_one_pos + 1;
-          idx0 |= lowbits;
-        }
-        idx1 = idx0 ^ XY_idx;
-        indexes_t inds(new uint_t[2]);
-        inds[0] = idx0;
-        inds[1] = idx1;
-
-        //matrix를 만드는 과정
-        //idx0의 Y_idx와 Z_idx에 대한 1 개수를 세서 Y,Z에 저장하면 matrix의 각 항은
-        //mat[0]=1+phase mat[1]=i^(num_Y-2*Y)*(-1)^(Z)*(1-phase)
-        //mat[2]=i^(2*Y-num_Y)*(-1)^(Z)*(1-phase) mat[3]=1+phase
-        uint_t Y_count = 0;
-        uint_t Z_count = 0;
-        uint_t Y_masked_value = Y_idx & idx0;
-        uint_t Z_masked_value = Z_idx & idx0;
-        for (size_t i = 0; i < sizeof(idx0) * 8; ++i) {
-            Y_count += (Y_masked_value & 1);
-            Y_masked_value >>= 1;
-            Z_count += (Z_masked_value & 1);
-            Z_masked_value >>= 1;
-        }
-        uint_t mat_sel = (num_Y - 2 * Y_count + 2 * Z_count) % 4;
-        // if(k < 10){
-        //   std::cout << "k: " << k << std::endl;
-        //   std::cout << "(idx0): " << std::bitset<32>(idx0) << std::endl;
-        //   std::cout << "(idx1): " << std::bitset<32>(idx1) << std::endl;
-        //   std::cout << "(mat_sel): " << mat_sel << std::endl;
-        // }
-        if(mat_sel==0) std::forward<Lambda>(func)(inds, mat0);
-        else if(mat_sel==1) std::forward<Lambda>(func)(inds, mat1);
-        else if(mat_sel==2) std::forward<Lambda>(func)(inds, mat2);
-        else if(mat_sel==3) std::forward<Lambda>(func)(inds, mat3);
-    }
+    for (int_t k = int_t(start); k < END; k++)
+      pair_func(k);
   }
-}//SW
+} //SW
 
 template <typename Lambda, typename list_t, typename param_t>
 inline void apply_lambda(const size_t start, const size_t stop,
@@ -621,6 +513,67 @@ apply_reduction_lambda(const size_t start, const size_t stop,
   return std::complex<double>(val_re, val_im);
 }
 
+//------------------------------------------------------------------------------
+// Transforms
+//------------------------------------------------------------------------------
+
+// In-place Walsh-Hadamard transform of a vector of length 2^num_bits,
+// data[z] <- sum_i (-1)^|i & z| data[i] (unnormalized).
+// The stages of the lowest bits run on cache resident blocks, the remaining
+// stages combine two bits per pass over the vector.
+template <typename T>
+inline void walsh_hadamard_transform(T *data, const uint_t num_bits,
+                                     const uint_t omp_threads) {
+  const uint_t block_bits = std::min<uint_t>(num_bits, 12);
+  const uint_t block_size = BITS[block_bits];
+  const int_t NUM_BLOCKS = BITS[num_bits - block_bits];
+
+#pragma omp parallel for if (omp_threads > 1) num_threads(omp_threads)
+  for (int_t b = 0; b < NUM_BLOCKS; b++) {
+    T *block = data + b * block_size;
+    for (uint_t h = 1; h < block_size; h <<= 1) {
+      for (uint_t i = 0; i < block_size; i += (h << 1)) {
+        for (uint_t j = i; j < i + h; ++j) {
+          const T u = block[j];
+          const T v = block[j + h];
+          block[j] = u + v;
+          block[j + h] = u - v;
+        }
+      }
+    }
+  }
+
+  uint_t bit = block_bits;
+  for (; bit + 1 < num_bits; bit += 2) {
+    const uint_t h = BITS[bit];
+    const int_t END = BITS[num_bits - 2];
+#pragma omp parallel for if (omp_threads > 1) num_threads(omp_threads)
+    for (int_t k = 0; k < END; k++) {
+      const uint_t i0 = ((k >> bit) << (bit + 2)) | (k & MASKS[bit]);
+      const T a = data[i0];
+      const T b = data[i0 + h];
+      const T c = data[i0 + 2 * h];
+      const T d = data[i0 + 3 * h];
+      data[i0] = (a + b) + (c + d);
+      data[i0 + h] = (a - b) + (c - d);
+      data[i0 + 2 * h] = (a + b) - (c + d);
+      data[i0 + 3 * h] = (a - b) - (c - d);
+    }
+  }
+  if (bit < num_bits) {
+    const uint_t h = BITS[bit];
+    const int_t END = BITS[num_bits - 1];
+#pragma omp parallel for if (omp_threads > 1) num_threads(omp_threads)
+    for (int_t k = 0; k < END; k++) {
+      const uint_t i0 = ((k >> bit) << (bit + 1)) | (k & MASKS[bit]);
+      const T u = data[i0];
+      const T v = data[i0 + h];
+      data[i0] = u + v;
+      data[i0 + h] = u - v;
+    }
+  }
+} //SW
+
 //------------------------------------------------------------------------------
 } // end namespace QV
 //------------------------------------------------------------------------------
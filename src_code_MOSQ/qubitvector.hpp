@@ -44,6 +44,9 @@ using cvector_t = std::vector<std::complex<T>>;
 template <typename T>
 using cdict_t = std::map<std::string, std::complex<T>>;
 
+// Pauli operator as (x_mask, z_mask, num_y, x_max)
+using pauli_mask_data = std::tuple<uint_t, uint_t, uint_t, uint_t>;
+
 enum class Rotation {
   x,
   y,
@@ -149,6 +152,12 @@ public:
   uint_t chunk_setup(QubitVector<data_t> &base, const uint_t chunk_index);
   uint_t chunk_index(void) { return chunk_index_; }
 
+  // Make this vector a view of the chunk chunk_index of base, the amplitudes
+  // of base with chunk_index in their bits from chunk_bits on. The view
+  // shares the memory of base and is applied without OpenMP.
+  void set_chunk_view(QubitVector<data_t> &base, const uint_t chunk_bits,
+                      const uint_t chunk_index); //SW
+
   // cache control for chunks on host
   bool fetch_chunk(void) const { return true; }
   void release_chunk(bool write_back = true) const {}
@@ -265,7 +274,14 @@ public:
   void apply_mcphase(const reg_t &qubits, const std::complex<double> phase);
   void apply_MOSQ(const reg_t &qubits, const std::complex<double> phase); //SW
   void apply_MOSQ_CR(const reg_t &qubits, const std::complex<double> phase,
-    std::complex<double> X_idx, std::complex<double> Y_idx, std::complex<double> Z_idx); //SW
+                     const uint_t X_idx, const uint_t Y_idx,
+                     const uint_t Z_idx); //SW
+
+  // Apply a block of Pauli rotations in one pass over the statevector.
+  // Rotation r has angle thetas[r] and the Pauli masks
+  // masks[3r .. 3r+2] = [X_idx, Y_idx, Z_idx] as for apply_MOSQ_CR.
+  void apply_MOSQ_BLOCK(const cvector_t<double> &thetas,
+                        const reg_t &masks); //SW
 
   // Apply a general multi-controlled single-qubit unitary gate
   // If N=1 this implements an optimized single-qubit U gate
@@ -417,6 +433,32 @@ public:
                             const std::string &pauli, bool variance,
                             std::complex<double> param, bool last,
                             const complex_t initial_phase = 1.0) const {}
+
+  // Return the expectation values of a list of N-qubit Pauli matrices.
+  // Paulis with the same X mask only differ by signs and a phase per
+  // amplitude pair, so they are evaluated together in one pass over the
+  // statevector per distinct X mask.
+  std::vector<double> expval_paulis(const reg_t &qubits,
+                                    const std::vector<std::string> &paulis)
+      const; //SW
+
+  // Return the expectation values of Paulis given by their X and Z masks
+  // on the qubits of the statevector (a bit set in both masks is a Y)
+  std::vector<double> expval_pauli_masks(const reg_t &x_masks,
+                                         const reg_t &z_masks) const; //SW
+
+  // Set the vector to sum_k coeffs[k] P_k |state> for Paulis P_k given by
+  // their X and Z masks as for expval_pauli_masks. The state must have the
+  // same number of qubits.
+  void initialize_from_pauli_sum(const QubitVector<data_t> &state,
+                                 const reg_t &x_masks, const reg_t &z_masks,
+                                 const std::vector<double> &coeffs); //SW
+
+  // Return <bra|P|psi> for the current state psi and a Pauli P given by
+  // (x_mask, z_mask, num_y, x_max)
+  std::complex<double>
+  pauli_inner_product(const QubitVector<data_t> &bra,
+                      const pauli_mask_data &mask) const; //SW
   //-----------------------------------------------------------------------
   // JSON configuration settings
   //-----------------------------------------------------------------------
@@ -475,7 +517,8 @@ protected:
   std::complex<data_t> *data_;
   std::complex<data_t> *checkpoint_;
 
-  uint_t chunk_index_;                    // global chunk index
+  uint_t chunk_index_ = 0;                // global chunk index
+  bool owns_data_ = true;                 // false for a chunk view //SW
   mutable cvector_t<data_t> recv_buffer_; // receive buffer for MPI
 
   //-----------------------------------------------------------------------
@@ -491,6 +534,34 @@ protected:
                                                               : 1;
   }
 
+  // Expectation values of Paulis given by their (x_mask, z_mask, num_y,
+  // x_max), evaluated together per distinct X mask
+  std::vector<double>
+  expval_paulis(const std::vector<pauli_mask_data> &masks) const; //SW
+
+  // Expectation value of a single Pauli given by its masks
+  double expval_pauli(const pauli_mask_data &mask,
+                      const complex_t initial_phase = 1.0) const; //SW
+
+  // Expectation values of Paulis sharing x_mask (with highest bit x_max)
+  // given by their Z masks and number of Y's, stored to vals[terms[k]]
+  void expval_pauli_group(const uint_t x_mask, const uint_t x_max,
+                          const std::vector<uint_t> &terms,
+                          const std::vector<pauli_mask_data> &masks,
+                          std::vector<double> &vals) const; //SW
+
+  // Expectation values of diagonal Paulis (Z strings), stored to
+  // vals[terms[k]]. With many terms they are read off the Walsh-Hadamard
+  // transform of the probabilities of the qubits they act on.
+  void expval_pauli_diagonal(const std::vector<uint_t> &terms,
+                             const std::vector<pauli_mask_data> &masks,
+                             std::vector<double> &vals) const; //SW
+
+  // Pair matrix entries {diag, upper[4], lower[4]} of a MOSQ_CR rotation
+  // indexed by the phase selector of a pair
+  std::array<std::complex<data_t>, 9>
+  MOSQ_CR_coeffs(const std::complex<double> phase) const; //SW
+
   void set_transformer_method() {
 #if defined(GNUC_AVX2) || defined(_MSC_VER)
     transformer_ =
@@ -560,13 +631,26 @@ protected:
   template <typename Lambda, typename list_t>
   void apply_lambda(Lambda &&func, const list_t &qubits);
 
-  template <typename Lambda, typename list_t>
-  void apply_lambda_MOSQ(Lambda &&func, const list_t &qubits); //SW
+  // Apply a diagonal Pauli Z-string lambda function to all entries of the
+  // statevector. The function signature should be:
+  //
+  // [&](const uint_t k, const uint_t parity)->void
+  //
+  // where `parity` is the parity of k over the bits of `z_mask`.
+  template <typename Lambda>
+  void apply_lambda_MOSQ(Lambda &&func, uint_t z_mask); //SW
 
-  template <typename Lambda, typename list_t, typename param_t>
-  void apply_lambda_MOSQ_CR(Lambda &&func, const list_t &qubits, 
-    const param_t &par1, const param_t &par2, const param_t &par3, const param_t &par4, 
-    uint_t X_idx, uint_t Y_idx, uint_t Z_idx); //SW
+  // Apply a Pauli rotation pair lambda function to all amplitude pairs
+  // coupled by a Pauli string with X/Y mask `xy_mask`. The function
+  // signature should be:
+  //
+  // [&](const areg_t<2> &inds, const uint_t sel)->void
+  //
+  // where `sel` selects the off-diagonal phase of the pair (see
+  // QV::apply_lambda_MOSQ_CR).
+  template <typename Lambda>
+  void apply_lambda_MOSQ_CR(Lambda &&func, uint_t xy_mask, uint_t y_mask,
+                            uint_t z_mask); //SW
 
   // Apply an N-qubit parameterized lambda function to all blocks of the
   // statevector for the given qubits. The function signature should be:
@@ -800,6 +884,7 @@ QubitVector<data_t> &QubitVector<data_t>::operator=(QubitVector<data_t> &&obj) {
   data_ = obj.data_;
   checkpoint_ = obj.checkpoint_;
   chunk_index_ = obj.chunk_index_;
+  owns_data_ = obj.owns_data_; //SW
   recv_buffer_ = obj.recv_buffer_;
   omp_threads_ = obj.omp_threads_;
   omp_threshold_ = obj.omp_threshold_;
@@ -933,6 +1018,10 @@ template <typename data_t>
 void QubitVector<data_t>::set_num_qubits(size_t num_qubits) {
 
   free_checkpoint();
+  //SW: keep the buffer of the same size, a session reinitializes it for
+  // every evaluation
+  if (num_qubits == num_qubits_ && data_ != nullptr)
+    return;
   if (num_qubits != num_qubits_) {
     free_mem();
   }
@@ -945,9 +1034,11 @@ void QubitVector<data_t>::set_num_qubits(size_t num_qubits) {
 template <typename data_t>
 void QubitVector<data_t>::free_mem() {
   if (data_) {
-    free(data_);
+    if (owns_data_) //SW
+      free(data_);
     data_ = nullptr;
   }
+  owns_data_ = true; //SW
 }
 
 template <typename data_t>
@@ -1067,6 +1158,20 @@ uint_t QubitVector<data_t>::chunk_setup(QubitVector<data_t> &base,
   return 0;
 }
 
+template <typename data_t>
+void QubitVector<data_t>::set_chunk_view(QubitVector<data_t> &base,
+                                         const uint_t chunk_bits,
+                                         const uint_t chunk_index) {
+  free_mem();
+  free_checkpoint();
+  num_qubits_ = chunk_bits;
+  data_size_ = BITS[chunk_bits];
+  data_ = base.data_ + (chunk_index << chunk_bits);
+  owns_data_ = false;
+  chunk_index_ = chunk_index;
+  omp_threads_ = 1;
+} //SW
+
 // prepare buffer for MPI send/recv
 template <typename data_t>
 std::complex<data_t> *QubitVector<data_t>::send_buffer(uint_t &size_in_byte) {
@@ -1230,20 +1335,18 @@ void QubitVector<data_t>::apply_lambda(Lambda &&func, const list_t &qubits) {
 }
 
 template <typename data_t>
-template <typename Lambda, typename list_t>
-void QubitVector<data_t>::apply_lambda_MOSQ(Lambda &&func, const list_t &qubits) {
-  QV::apply_lambda_MOSQ(0, data_size_, omp_threads_managed(), func, qubits);
-}//SW
+template <typename Lambda>
+void QubitVector<data_t>::apply_lambda_MOSQ(Lambda &&func, uint_t z_mask) {
+  QV::apply_lambda_MOSQ(0, data_size_, omp_threads_managed(), func, z_mask);
+} //SW
 
 template <typename data_t>
-template <typename Lambda, typename list_t, typename param_t>
-void QubitVector<data_t>::apply_lambda_MOSQ_CR(Lambda &&func, const list_t &qubits,
-                                       const param_t &params1, const param_t &params2, const param_t &params3, const param_t &params4, 
-                                       uint_t X_idx, uint_t Y_idx, uint_t Z_idx) {
-  QV::apply_lambda_MOSQ_CR(0, data_size_, omp_threads_managed(), func, qubits, 
-  params1, params2, params3, params4,
-  X_idx, Y_idx, Z_idx, num_qubits_);
-}//SW
+template <typename Lambda>
+void QubitVector<data_t>::apply_lambda_MOSQ_CR(Lambda &&func, uint_t xy_mask,
+                                               uint_t y_mask, uint_t z_mask) {
+  QV::apply_lambda_MOSQ_CR(0, data_size_, omp_threads_managed(), func, xy_mask,
+                           y_mask, z_mask);
+} //SW
 
 template <typename data_t>
 template <typename Lambda, typename list_t, typename param_t>
@@ -1648,81 +1751,190 @@ void QubitVector<data_t>::apply_mcphase(const reg_t &qubits,
 
 template <typename data_t>
 void QubitVector<data_t>::apply_MOSQ(const reg_t &qubits,
-                                        const std::complex<double> phase) {
-  // std::cout << "(phase)Real part: " << phase.real() << std::endl;
-  // std::cout << "(phase)Imag part: " << phase.imag() << std::endl;
-  // std::complex<double> phase_double = phase * phase;
-  // std::cout << "(phase_double)Real part: " << phase_double.real() << std::endl;
-  // std::cout << "(phase_double)Imag part: " << phase_double.imag() << std::endl;
-  // Lambda function for arbitrary Phase gate with diagonal [1, phase]
-  auto lambda = [&](const uint_t &ind) -> void {
-    // std::cout << "ind: " << ind << std::endl;
-    // std::cout << "(before)Real part: " << data_[ind].real() << std::endl;
-    // std::cout << "(before)Imaginary  part: " << data_[ind].imag() << std::endl;
-    data_[ind] *= phase;
-    // data_[ind] *= (2.0 * phase);
-    // std::cout << "(after)Real part: " << data_[ind].real() << std::endl;
-    // std::cout << "(after)Imaginary  part: " << data_[ind].imag() << std::endl;
-  };
-  apply_lambda_MOSQ(lambda, qubits);
-  return;
+                                     const std::complex<double> phase) {
+  // Diagonal [1, phase] on the parity of the qubits
+  uint_t z_mask = 0;
+  for (const auto q : qubits)
+    z_mask ^= BITS[q];
+  // Qubits above a chunk add the parity of their bits in the chunk index
+  const bool flip =
+      AER::Utils::popcount((z_mask >> num_qubits_) & chunk_index_) & 1;
+  z_mask &= MASKS[num_qubits_];
+  const std::complex<data_t> phases[2] = {
+      flip ? std::complex<data_t>(phase) : 1.,
+      flip ? 1. : std::complex<data_t>(phase)};
+  transformer_->apply_MOSQ(data_, data_size_, omp_threads_managed(), z_mask,
+                           phases);
 } //SW
 
 template <typename data_t>
 void QubitVector<data_t>::apply_MOSQ_CR(const reg_t &qubits,
-                                        const std::complex<double> phase, std::complex<double> X_idx, std::complex<double> Y_idx, std::complex<double> Z_idx) {
-  uint_t X_idx_int = (uint_t)(X_idx.real());
-  uint_t Y_idx_int = (uint_t)(Y_idx.real());
-  uint_t Z_idx_int = (uint_t)(Z_idx.real());
-  // std::cout << "X_idx_int: " << X_idx_int << std::endl;
-  // std::cout << "Y_idx_int: " << Y_idx_int << std::endl;
-  // std::cout << "Z_idx_int: " << Z_idx_int << std::endl;
-  // std::cout << "MOSQ_CR" << std::endl;
-  // for (size_t i = 0; i < 16; ++i) {
-  //   std::cout << "data_[" << i << "]: " << data_[i] << std::endl;
-  // }
+                                        const std::complex<double> phase,
+                                        const uint_t x_mask,
+                                        const uint_t y_mask,
+                                        const uint_t z_mask) {
+  const uint_t xy_mask = x_mask | y_mask;
+
+  // Z qubits above a chunk (X and Y qubits must be inside) negate the Pauli
+  // in the chunks with an odd parity of their bits. The rotation [1, phase]
+  // on the eigenvalues (1, -1) of -P is phase times [1, conj(phase)] on P.
+  const bool flip =
+      AER::Utils::popcount((z_mask >> num_qubits_) & chunk_index_) & 1;
+  const uint_t z_chunk_mask = z_mask & MASKS[num_qubits_];
+
+  // Z-only strings are diagonal: odd parity amplitudes pick up the phase
+  if (xy_mask == 0) {
+    const std::complex<data_t> phases[2] = {
+        flip ? std::complex<data_t>(phase) : 1.,
+        flip ? 1. : std::complex<data_t>(phase)};
+    transformer_->apply_MOSQ(data_, data_size_, omp_threads_managed(),
+                             z_chunk_mask, phases);
+    return;
+  }
 
-  // Lambda function
-  auto lambda = [&](const indexes_t &inds,
-                      const cvector_t<data_t> &_mat) -> void {
-    const auto cache = data_[inds[0]];
-    data_[inds[0]] =
-        _mat[0] * data_[inds[0]] + _mat[2] * data_[inds[1]];
-    data_[inds[1]] = _mat[1] * cache + _mat[3] * data_[inds[1]];
+  auto coeffs = MOSQ_CR_coeffs(flip ? std::conj(phase) : phase);
+  if (flip) {
+    for (auto &coeff : coeffs)
+      coeff *= std::complex<data_t>(phase);
+  }
+  transformer_->apply_MOSQ_CR(data_, data_size_, omp_threads_managed(),
+                              xy_mask, y_mask, z_chunk_mask, coeffs.data());
+} //SW
+
+template <typename data_t>
+std::array<std::complex<data_t>, 9>
+QubitVector<data_t>::MOSQ_CR_coeffs(const std::complex<double> phase) const {
+  // The rotation acts on each pair as
+  // [[(1 + phase) / 2, (-i)^sel (1 - phase) / 2],
+  //  [i^sel (1 - phase) / 2,  (1 + phase) / 2]]
+  // with the phase selector sel computed by the pair kernel, so the four
+  // possible matrices only differ in their off-diagonal entries.
+  const complex_t off = 0.5 * (complex_t(1.0) - phase);
+  const complex_t i_pow[4] = {complex_t(1., 0.), complex_t(0., 1.),
+                              complex_t(-1., 0.), complex_t(0., -1.)};
+  std::array<std::complex<data_t>, 9> coeffs;
+  coeffs[0] = std::complex<data_t>(0.5 * (complex_t(1.0) + phase));
+  for (uint_t sel = 0; sel < 4; ++sel) {
+    coeffs[1 + sel] = std::complex<data_t>(off * i_pow[(4 - sel) & 3]);
+    coeffs[5 + sel] = std::complex<data_t>(off * i_pow[sel]);
+  }
+  return coeffs;
+} //SW
+
+template <typename data_t>
+void QubitVector<data_t>::apply_MOSQ_BLOCK(const cvector_t<double> &thetas,
+                                           const reg_t &masks) {
+  // Minimum number of qubits of a block, so that the per block cost of the
+  // rotation kernels is amortized over a few thousand amplitudes
+  const uint_t min_block_bits = std::min<uint_t>(num_qubits_, 10);
+
+  // A block holds every amplitude coupled by the rotations (the pair qubits
+  // of all rotations) and is filled up with the lowest remaining qubits, so
+  // that it is gathered from contiguous runs of cache lines
+  uint_t block_mask = MASKS[std::min<uint_t>(num_qubits_, 3)];
+  for (uint_t i = 0; i < masks.size(); i += 3)
+    block_mask |= masks[i] | masks[i + 1];
+  for (uint_t q = 0; mask_weight(block_mask) < min_block_bits; ++q)
+    block_mask |= BITS[q];
+
+  reg_t block_qubits;
+  for (uint_t q = 0; q < num_qubits_; ++q)
+    if (block_mask & BITS[q])
+      block_qubits.push_back(q);
+  const uint_t block_bits = block_qubits.size();
+  const uint_t block_size = BITS[block_bits];
+
+  // The lowest block qubits are consecutive, so a block is copied as runs of
+  // contiguous amplitudes
+  uint_t run_bits = 0;
+  while (run_bits < block_bits && block_qubits[run_bits] == run_bits)
+    ++run_bits;
+  const uint_t run_size = BITS[run_bits];
+
+  // Statevector offsets of the amplitudes of a block from its base index
+  std::vector<uint_t> offsets(block_size, 0);
+  for (uint_t i = 0; i < block_bits; ++i)
+    for (uint_t l = BITS[i]; l < BITS[i + 1]; ++l)
+      offsets[l] = offsets[l - BITS[i]] | BITS[block_qubits[i]];
+
+  auto block_local = [&](const uint_t mask) -> uint_t {
+    uint_t ret = 0;
+    for (uint_t i = 0; i < block_bits; ++i)
+      if (mask & BITS[block_qubits[i]])
+        ret |= BITS[i];
+    return ret;
+  };
+
+  // Each rotation is a MOSQ_CR (or MOSQ) rotation of the block in block
+  // coordinates. Y/Z bits outside the block only contribute the parity of the
+  // block base index, which shifts the phase selector by 2, so coefficients
+  // are prepared for both parities.
+  struct PauliRotation {
+    uint_t xy_mask;
+    uint_t y_mask;
+    uint_t z_mask;
+    uint_t outer_yz_mask;
+    std::array<std::complex<data_t>, 9> coeffs[2];
   };
-  // double scale = 1.0 / std::sqrt(2.0);
-  double scale = 1.0 / 2.0;
-  // std::cout << "phase: " << phase << std::endl;
-  // std::cout << "complex_t(1.0): " << complex_t(1.0) << std::endl;
-  // std::cout << "complex_t(0, 1): " << complex_t(0, 1) << std::endl;
-  std::vector<complex_t> mat0(2 * 2);
-  mat0[0 + 0 * 2] = scale * (complex_t(1.0) + phase);
-  mat0[0 + 1 * 2] = scale * (complex_t(1.0) - phase);
-  mat0[1 + 0 * 2] = scale * (complex_t(1.0) - phase);
-  mat0[1 + 1 * 2] = scale * (complex_t(1.0) + phase);
-  // std::cout << "mat0: " << mat0 << std::endl;
-  std::vector<complex_t> mat1(2 * 2);
-  mat1[0 + 0 * 2] = scale * (complex_t(1.0) + phase);
-  mat1[0 + 1 * 2] = -scale * complex_t(0, 1) * (complex_t(1.0) - phase);
-  mat1[1 + 0 * 2] = scale * complex_t(0, 1) * (complex_t(1.0) - phase);
-  mat1[1 + 1 * 2] = scale * (complex_t(1.0) + phase);
-  // std::cout << "mat1: " << mat1 << std::endl;
-  std::vector<complex_t> mat2(2 * 2);
-  mat2[0 + 0 * 2] = scale * (complex_t(1.0) + phase);
-  mat2[0 + 1 * 2] = -scale * (complex_t(1.0) - phase);
-  mat2[1 + 0 * 2] = -scale * (complex_t(1.0) - phase);
-  mat2[1 + 1 * 2] = scale * (complex_t(1.0) + phase);
-  std::vector<complex_t> mat3(2 * 2);
-  mat3[0 + 0 * 2] = scale * (complex_t(1.0) + phase);
-  mat3[0 + 1 * 2] = scale * complex_t(0, 1) * (complex_t(1.0) - phase);
-  mat3[1 + 0 * 2] = -scale * complex_t(0, 1) * (complex_t(1.0) - phase);
-  mat3[1 + 1 * 2] = scale * (complex_t(1.0) + phase);
-  apply_lambda_MOSQ_CR(lambda, qubits, 
-    convert(mat0), convert(mat1), convert(mat2), convert(mat3), 
-    X_idx_int, Y_idx_int, Z_idx_int);
-  return;
+  std::vector<PauliRotation> rotations(thetas.size());
+  for (uint_t r = 0; r < rotations.size(); ++r) {
+    const uint_t x_mask = masks[3 * r];
+    const uint_t y_mask = masks[3 * r + 1];
+    const uint_t z_mask = masks[3 * r + 2];
+    const auto phase = std::exp(complex_t(0., 1.) * thetas[r]);
+
+    auto &rot = rotations[r];
+    rot.xy_mask = block_local(x_mask | y_mask);
+    rot.y_mask = block_local(y_mask);
+    rot.z_mask = block_local(z_mask);
+    rot.outer_yz_mask = (y_mask | z_mask) & ~block_mask;
+    if (rot.xy_mask == 0) {
+      rot.coeffs[0][0] = rot.coeffs[1][1] = 1.;
+      rot.coeffs[0][1] = rot.coeffs[1][0] = std::complex<data_t>(phase);
+    } else {
+      rot.coeffs[0] = MOSQ_CR_coeffs(phase);
+      rot.coeffs[1][0] = rot.coeffs[0][0];
+      for (uint_t sel = 0; sel < 4; ++sel) {
+        rot.coeffs[1][1 + sel] = rot.coeffs[0][1 + ((sel + 2) & 3)];
+        rot.coeffs[1][5 + sel] = rot.coeffs[0][5 + ((sel + 2) & 3)];
+      }
+    }
+  }
+
+  const int_t END = data_size_ >> block_bits;
+  const uint_t threads = omp_threads_managed();
+
+#pragma omp parallel if (threads > 1) num_threads(threads)
+  {
+    // 64 byte aligned block buffer for the SIMD kernels
+    std::vector<std::complex<data_t>> buffer(block_size + 8);
+    std::complex<data_t> *block = reinterpret_cast<std::complex<data_t> *>(
+        (reinterpret_cast<uintptr_t>(buffer.data()) + 63) & ~uintptr_t(63));
+
+#pragma omp for
+    for (int_t k = 0; k < END; k++) {
+      const uint_t base = index0(block_qubits, k);
+      for (uint_t l = 0; l < block_size; l += run_size)
+        std::copy_n(data_ + (base | offsets[l]), run_size, block + l);
+
+      for (const auto &rot : rotations) {
+        const uint_t outer = mask_weight(base & rot.outer_yz_mask) & 1;
+        if (rot.xy_mask == 0)
+          transformer_->apply_MOSQ(block, block_size, 1, rot.z_mask,
+                                   rot.coeffs[outer].data());
+        else
+          transformer_->apply_MOSQ_CR(block, block_size, 1, rot.xy_mask,
+                                      rot.y_mask, rot.z_mask,
+                                      rot.coeffs[outer].data());
+      }
+
+      for (uint_t l = 0; l < block_size; l += run_size)
+        std::copy_n(block + l, run_size, data_ + (base | offsets[l]));
+    }
+  }
 } //SW
 
+
 template <typename data_t>
 void QubitVector<data_t>::apply_mcu(const reg_t &qubits,
                                     const cvector_t<double> &mat) {
@@ -2349,7 +2561,6 @@ reg_t QubitVector<data_t>::sample_measure(
  * EXPECTATION VALUES
  *
  ******************************************************************************/
-using pauli_mask_data = std::tuple<uint_t, uint_t, uint_t, uint_t>;
 inline pauli_mask_data pauli_masks_and_phase(const reg_t &qubits,
                                              const std::string &pauli) {
   // Break string up into Z and X
@@ -2423,8 +2634,14 @@ double QubitVector<data_t>::expval_pauli(const reg_t &qubits,
                                          const std::string &pauli,
                                          const complex_t initial_phase) const {
 
+  return expval_pauli(pauli_masks_and_phase(qubits, pauli), initial_phase);
+}
+
+template <typename data_t>
+double QubitVector<data_t>::expval_pauli(const pauli_mask_data &mask,
+                                         const complex_t initial_phase) const {
   uint_t x_mask, z_mask, num_y, x_max;
-  std::tie(x_mask, z_mask, num_y, x_max) = pauli_masks_and_phase(qubits, pauli);
+  std::tie(x_mask, z_mask, num_y, x_max) = mask;
   // std::bitset<sizeof(uint_t) * 8> binary_x_mask(x_mask);
   // std::cout << "x_mask: " << binary_x_mask << std::endl;
   // std::bitset<sizeof(uint_t) * 8> binary_z_mask(z_mask);
@@ -2518,6 +2735,251 @@ double QubitVector<data_t>::expval_pauli(const reg_t &qubits,
       apply_reduction_lambda(std::move(lambda), (size_t)0, data_size_));
 }
 
+template <typename data_t>
+std::vector<double>
+QubitVector<data_t>::expval_paulis(const reg_t &qubits,
+                                   const std::vector<std::string> &paulis)
+    const {
+  std::vector<pauli_mask_data> masks;
+  masks.reserve(paulis.size());
+  for (const auto &pauli : paulis)
+    masks.push_back(pauli_masks_and_phase(qubits, pauli));
+  return expval_paulis(masks);
+}
+
+template <typename data_t>
+std::vector<double>
+QubitVector<data_t>::expval_pauli_masks(const reg_t &x_masks,
+                                        const reg_t &z_masks) const {
+  std::vector<pauli_mask_data> masks;
+  masks.reserve(x_masks.size());
+  for (uint_t i = 0; i < x_masks.size(); ++i) {
+    const uint_t x_mask = x_masks[i];
+    uint_t x_max = 0;
+    for (uint_t q = 0; q < num_qubits_; ++q)
+      if (x_mask & BITS[q])
+        x_max = q;
+    masks.emplace_back(x_mask, z_masks[i],
+                       AER::Utils::popcount(x_mask & z_masks[i]), x_max);
+  }
+  return expval_paulis(masks);
+}
+
+template <typename data_t>
+void QubitVector<data_t>::initialize_from_pauli_sum(
+    const QubitVector<data_t> &state, const reg_t &x_masks,
+    const reg_t &z_masks, const std::vector<double> &coeffs) {
+  if (state.num_qubits() != num_qubits_) {
+    throw std::invalid_argument(
+        "QubitVector::initialize_from_pauli_sum: state does not match qubit "
+        "number");
+  }
+  // (P |state>)[i] = (-i)^num_y (-1)^|i & z| state[i ^ x], so the terms
+  // sharing an X mask read the same amplitude and are summed into one
+  // coefficient per amplitude
+  std::map<uint_t, std::vector<uint_t>> groups;
+  for (uint_t k = 0; k < coeffs.size(); ++k)
+    groups[x_masks[k]].push_back(k);
+
+  const std::complex<data_t> *src = state.data_;
+  auto zero = [&](const int_t i) -> void { data_[i] = 0.; };
+  apply_lambda(zero);
+
+  for (const auto &group : groups) {
+    const uint_t x_mask = group.first;
+    const auto &terms = group.second;
+    std::vector<uint_t> z_masks_g(terms.size());
+    std::vector<std::complex<data_t>> phases(terms.size());
+    for (uint_t j = 0; j < terms.size(); ++j) {
+      const uint_t k = terms[j];
+      z_masks_g[j] = z_masks[k];
+      phases[j] = coeffs[k];
+      add_y_phase(AER::Utils::popcount(x_mask & z_masks[k]), phases[j]);
+    }
+    auto lambda = [&](const int_t i) -> void {
+      std::complex<data_t> coeff = 0.;
+      for (uint_t j = 0; j < z_masks_g.size(); ++j) {
+        if (AER::Utils::popcount(i & z_masks_g[j]) & 1)
+          coeff -= phases[j];
+        else
+          coeff += phases[j];
+      }
+      data_[i] += coeff * src[i ^ x_mask];
+    };
+    apply_lambda(lambda);
+  }
+} //SW
+
+template <typename data_t>
+std::complex<double>
+QubitVector<data_t>::pauli_inner_product(const QubitVector<data_t> &bra,
+                                         const pauli_mask_data &mask) const {
+  uint_t x_mask, z_mask, num_y, x_max;
+  std::tie(x_mask, z_mask, num_y, x_max) = mask;
+  std::complex<data_t> phase = 1.;
+  add_y_phase(num_y, phase);
+
+  const std::complex<data_t> *bra_data = bra.data_;
+  auto lambda = [&](const int_t i, double &val_re, double &val_im) -> void {
+    std::complex<data_t> val = std::conj(bra_data[i]) * data_[i ^ x_mask];
+    if (AER::Utils::popcount(i & z_mask) & 1)
+      val = -val;
+    val_re += std::real(val);
+    val_im += std::imag(val);
+  };
+  return complex_t(phase) * apply_reduction_lambda(std::move(lambda));
+} //SW
+
+template <typename data_t>
+std::vector<double> QubitVector<data_t>::expval_paulis(
+    const std::vector<pauli_mask_data> &masks) const {
+  std::vector<double> vals(masks.size(), 0.);
+  std::map<uint_t, std::vector<uint_t>> groups;
+  for (uint_t i = 0; i < masks.size(); ++i)
+    groups[std::get<0>(masks[i])].push_back(i);
+
+  for (const auto &group : groups) {
+    const auto &terms = group.second;
+    if (terms.size() == 1) {
+      vals[terms[0]] = expval_pauli(masks[terms[0]]);
+      continue;
+    }
+    if (group.first == 0) {
+      expval_pauli_diagonal(terms, masks, vals);
+      continue;
+    }
+    expval_pauli_group(group.first, std::get<3>(masks[terms[0]]), terms, masks,
+                       vals);
+  }
+  return vals;
+} //SW
+
+template <typename data_t>
+void QubitVector<data_t>::expval_pauli_diagonal(
+    const std::vector<uint_t> &terms, const std::vector<pauli_mask_data> &masks,
+    std::vector<double> &vals) const {
+  uint_t z_union = 0;
+  for (const auto i : terms)
+    z_union |= std::get<1>(masks[i]);
+  reg_t z_qubits;
+  for (uint_t q = 0; q < num_qubits_; ++q)
+    if (z_union & BITS[q])
+      z_qubits.push_back(q);
+  const uint_t num_z = z_qubits.size();
+
+  // The transform costs a pass for the marginal probabilities and num_z
+  // passes over their 2^num_z entries, the grouped reduction a dot product
+  // over the statevector per term
+  if (num_z == 0 || terms.size() * BITS[num_qubits_] <=
+                        BITS[num_qubits_] + num_z * BITS[num_z]) {
+    expval_pauli_group(0, 0, terms, masks, vals);
+    return;
+  }
+
+  auto probs = probabilities(z_qubits);
+  walsh_hadamard_transform(probs.data(), num_z, omp_threads_managed());
+  for (const auto i : terms) {
+    const uint_t z_mask = std::get<1>(masks[i]);
+    uint_t index = 0;
+    for (uint_t j = 0; j < num_z; ++j)
+      if (z_mask & BITS[z_qubits[j]])
+        index |= BITS[j];
+    vals[i] = probs[index];
+  }
+} //SW
+
+template <typename data_t>
+void QubitVector<data_t>::expval_pauli_group(
+    const uint_t x_mask, const uint_t x_max, const std::vector<uint_t> &terms,
+    const std::vector<pauli_mask_data> &masks,
+    std::vector<double> &vals) const {
+  // For a pair (i0, i1 = i0 ^ x_mask) with c = data[i1] * conj(data[i0]),
+  // a Pauli with Y phase p contributes
+  //   (-1)^|i0 & z| (Re(p c) + (-1)^|x & z| Re(p conj(c)))
+  // = (-1)^|i0 & z| (w_re Re(c) + w_im Im(c)),
+  // so c is computed once per pair for all the Paulis of the group.
+  // Diagonal Paulis contribute (-1)^|i & z| Re(p) |data[i]|^2.
+  //
+  // The sign is linear in the pair index k (i0 is k with a zero inserted at
+  // x_max), so over a block of pairs it is the sign of the block base times
+  // a sign pattern of the low bits of k, tabulated once per Pauli. Each
+  // Pauli then costs two dot products with the block of c values.
+  const uint_t num_terms = terms.size();
+  const uint_t mask_u = ~MASKS[x_max + 1];
+  const uint_t mask_l = MASKS[x_max];
+  const int_t END = (x_mask == 0) ? data_size_ : (data_size_ >> 1);
+  const uint_t block_bits = std::min<uint_t>(7, (x_mask == 0)
+                                                    ? num_qubits_
+                                                    : num_qubits_ - 1);
+  const uint_t block_size = BITS[block_bits];
+
+  std::vector<uint_t> z_masks(num_terms);
+  std::vector<double> w_re(num_terms), w_im(num_terms);
+  std::vector<double> signs(num_terms * block_size);
+  for (uint_t j = 0; j < num_terms; ++j) {
+    const auto &m = masks[terms[j]];
+    const uint_t z_mask = std::get<1>(m);
+    std::complex<double> phase = 1.;
+    add_y_phase(std::get<2>(m), phase);
+    if (x_mask == 0) {
+      z_masks[j] = z_mask;
+      w_re[j] = phase.real();
+      w_im[j] = 0.;
+    } else {
+      z_masks[j] = (z_mask & mask_l) | ((z_mask & mask_u) >> 1);
+      const double t = (Utils::popcount(x_mask & z_mask) & 1) ? -1. : 1.;
+      w_re[j] = (1. + t) * phase.real();
+      w_im[j] = (t - 1.) * phase.imag();
+    }
+    for (uint_t l = 0; l < block_size; ++l)
+      signs[j * block_size + l] =
+          (Utils::popcount(l & z_masks[j]) & 1) ? -1. : 1.;
+  }
+
+  const int_t NUM_BLOCKS = END >> block_bits;
+  const uint_t threads = omp_threads_managed();
+  std::vector<double> sums(num_terms, 0.);
+
+#pragma omp parallel if (threads > 1) num_threads(threads)
+  {
+    std::vector<double> acc(num_terms, 0.);
+    std::vector<double> c_re(block_size), c_im(block_size, 0.);
+#pragma omp for
+    for (int_t b = 0; b < NUM_BLOCKS; b++) {
+      const uint_t base = uint_t(b) << block_bits;
+      if (x_mask == 0) {
+        for (uint_t l = 0; l < block_size; ++l)
+          c_re[l] = std::norm(data_[base + l]);
+      } else {
+        for (uint_t l = 0; l < block_size; ++l) {
+          const uint_t k = base + l;
+          const uint_t i0 = ((k << 1) & mask_u) | (k & mask_l);
+          const std::complex<double> c =
+              data_[i0 ^ x_mask] * std::conj(data_[i0]);
+          c_re[l] = c.real();
+          c_im[l] = c.imag();
+        }
+      }
+      for (uint_t j = 0; j < num_terms; ++j) {
+        const double *sign = &signs[j * block_size];
+        double re = 0., im = 0.;
+        for (uint_t l = 0; l < block_size; ++l) {
+          re += sign[l] * c_re[l];
+          im += sign[l] * c_im[l];
+        }
+        const double v = w_re[j] * re + w_im[j] * im;
+        acc[j] += (Utils::popcount(base & z_masks[j]) & 1) ? -v : v;
+      }
+    }
+#pragma omp critical
+    for (uint_t j = 0; j < num_terms; ++j)
+      sums[j] += acc[j];
+  }
+
+  for (uint_t j = 0; j < num_terms; ++j)
+    vals[terms[j]] = sums[j];
+} //SW
+
 /*******************************************************************************
  *
  * PAULI
@@ -19,6 +19,7 @@
 #include "framework/creg.hpp"
 #include "framework/json.hpp"
 #include "framework/opset.hpp"
+#include "framework/profiler.hpp"
 #include "framework/results/experiment_result.hpp"
 #include "framework/types.hpp"
 
@@ -113,6 +114,53 @@ public:
   virtual double expval_pauli(const reg_t &qubits,
                               const std::string &pauli) = 0;
 
+  // Return the expectation values of a list of N-qubit Pauli operators.
+  // The default evaluates them one at a time with expval_pauli; simulators
+  // may override it to share work between the Paulis.
+  virtual std::vector<double>
+  expval_paulis(const reg_t &qubits, const std::vector<std::string> &paulis) {
+    std::vector<double> vals;
+    vals.reserve(paulis.size());
+    for (const auto &pauli : paulis)
+      vals.push_back(expval_pauli(qubits, pauli));
+    return vals;
+  } //SW
+
+  // Return the expectation values of N-qubit Paulis given by their X and Z
+  // masks, where bit j of a mask refers to qubits[j]. The default converts
+  // them to Pauli labels for expval_paulis.
+  virtual std::vector<double> expval_pauli_masks(const reg_t &qubits,
+                                                 const reg_t &x_masks,
+                                                 const reg_t &z_masks) {
+    Operations::Op op;
+    op.qubits = qubits;
+    std::vector<std::string> paulis;
+    paulis.reserve(x_masks.size());
+    for (uint_t i = 0; i < x_masks.size(); ++i) {
+      op.int_params = {x_masks[i], z_masks[i]};
+      paulis.push_back(Operations::hamiltonian_term_pauli(op, 0));
+    }
+    return expval_paulis(qubits, paulis);
+  } //SW
+
+  // Return the expectation value of the Pauli sum of a
+  // save_hamiltonian_expval instruction, and the values of its terms in vals
+  double expval_hamiltonian(const Operations::Op &op,
+                            std::vector<double> &vals); //SW
+
+  // Return the gradient of the energy of the Pauli sum of a
+  // save_energy_gradient (or save_hamiltonian_expval) instruction op with
+  // respect to the angles of the Pauli rotations of ops [first, last), which
+  // are the ops applied to the state since its initialization. The energy is
+  // returned in energy. The state is left unchanged unless final_op is true.
+  virtual std::vector<double> energy_gradient(OpItr first, OpItr last,
+                                              const Operations::Op &op,
+                                              double &energy,
+                                              bool final_op = false) {
+    throw std::invalid_argument("State " + name() +
+                                " does not support energy gradients.");
+  } //SW
+
   // Initializes the State to the default state.
   // Typically this is the n-qubit all |0> state
   virtual void initialize_qreg(uint_t num_qubits) = 0;
@@ -250,22 +298,15 @@ public:
   // Apply a save expectation value instruction
   void apply_save_expval(const Operations::Op &op, ExperimentResult &result);
 
-  //SW
-  double time_taken = 0.0;
-  double time_Diag = 0.0;
-  double time_Fuse2 = 0.0;
-  double time_Fuse3 = 0.0;
-  double time_Fuse4 = 0.0;
-  double time_Fuse5 = 0.0;
-  double time_MOSQ = 0.0;
-  double time_MOSQ_CR = 0.0;
-  double time_HS = 0.0;
-  double time_SDGH = 0.0;
-  double time_RZ = 0.0;
-  double time_CX = 0.0;
-  double time_S = 0.0;
-  double time_SDG = 0.0;
-  double time_H = 0.0;
+  // Apply a save Hamiltonian expectation value instruction
+  void apply_save_hamiltonian_expval(const Operations::Op &op,
+                                     ExperimentResult &result); //SW
+
+  // Apply a save energy gradient instruction at the end of ops [first, last)
+  void apply_save_energy_gradient(OpItr first, OpItr last,
+                                  const Operations::Op &op,
+                                  ExperimentResult &result,
+                                  bool final_op); //SW
 
 protected:
   // Classical register data
@@ -292,6 +333,9 @@ protected:
   bool cuStateVec_enable_ = false;
 
   reg_t target_gpus_;
+
+  //SW: Per-op-type counters, empty unless compiled with AER_PROFILING
+  Profiling::Profile profile_;
 };
 
 void Base::set_config(const Config &config) {
@@ -346,27 +390,18 @@ void Base::apply_ops(const OpItr first, const OpItr last,
       }
       break;
     }
+    case Operations::OpType::save_energy_gradient: {
+      // The gradient reverses the ops applied before it
+      if (creg().check_conditional(*it))
+        apply_save_energy_gradient(first, it, *it, result,
+                                   final_ops && (it + 1 == last));
+      break;
+    } //SW
     default: {
       apply_op(*it, result, rng, final_ops && (it + 1 == last));
     }
     }
   }
-
-  result.metadata.add(this->time_taken, "time_expval");
-  result.metadata.add(this->time_Diag, "time_Diag");
-  result.metadata.add(this->time_Fuse2, "time_Fuse2");
-  result.metadata.add(this->time_Fuse3, "time_Fuse3");
-  result.metadata.add(this->time_Fuse4, "time_Fuse4");
-  result.metadata.add(this->time_Fuse5, "time_Fuse5");
-  result.metadata.add(this->time_MOSQ, "time_MOSQ");
-  result.metadata.add(this->time_MOSQ_CR, "time_MOSQ_CR");
-  result.metadata.add(this->time_HS, "time_HS");
-  result.metadata.add(this->time_SDGH, "time_SDGH");
-  result.metadata.add(this->time_RZ, "time_RZ");
-  result.metadata.add(this->time_CX, "time_CX");
-  result.metadata.add(this->time_S, "time_S");
-  result.metadata.add(this->time_SDG, "time_SDG");
-  result.metadata.add(this->time_H, "time_H");
 };
 
 void Base::initialize_creg(uint_t num_memory, uint_t num_register) {
@@ -456,13 +491,18 @@ void Base::apply_save_expval(const Operations::Op &op,
   double expval(0.);
   double sq_expval(0.);
 
-  for (const auto &param : op.expval_params) {
-    // std::cout << "Pauli: " << std::get<0>(param) << ", Coeff: " << std::get<1>(param) << ", Sq_Coeff: " << std::get<2>(param) << std::endl;
+  std::vector<std::string> paulis;
+  paulis.reserve(op.expval_params.size());
+  for (const auto &param : op.expval_params)
+    paulis.push_back(std::get<0>(param));
+  const auto vals = expval_paulis(op.qubits, paulis); //SW
+
+  for (uint_t i = 0; i < vals.size(); ++i) {
     // param is tuple (pauli, coeff, sq_coeff)
-    const auto val = expval_pauli(op.qubits, std::get<0>(param));
-    expval += std::get<1>(param) * val;
+    const auto &param = op.expval_params[i];
+    expval += std::get<1>(param) * vals[i];
     if (variance) {
-      sq_expval += std::get<2>(param) * val;
+      sq_expval += std::get<2>(param) * vals[i];
     }
   }
   if (variance) {
@@ -477,6 +517,45 @@ void Base::apply_save_expval(const Operations::Op &op,
   }
 }
 
+double Base::expval_hamiltonian(const Operations::Op &op,
+                                std::vector<double> &vals) {
+  const uint_t num_terms = op.params.size();
+  reg_t x_masks(num_terms), z_masks(num_terms);
+  for (uint_t i = 0; i < num_terms; ++i) {
+    x_masks[i] = op.int_params[2 * i];
+    z_masks[i] = op.int_params[2 * i + 1];
+  }
+  vals = expval_pauli_masks(op.qubits, x_masks, z_masks);
+
+  double energy = 0.;
+  for (uint_t i = 0; i < num_terms; ++i)
+    energy += std::real(op.params[i]) * vals[i];
+  return energy;
+}
+
+void Base::apply_save_hamiltonian_expval(const Operations::Op &op,
+                                         ExperimentResult &result) {
+  std::vector<double> vals;
+  const double energy = expval_hamiltonian(op, vals);
+  result.save_data_average(creg(), op.string_params[0], energy, op.type,
+                           op.save_type);
+  if (op.string_params.size() > 1)
+    result.save_data_average(creg(), op.string_params[1], std::move(vals),
+                             op.type, op.save_type);
+} //SW
+
+void Base::apply_save_energy_gradient(OpItr first, OpItr last,
+                                      const Operations::Op &op,
+                                      ExperimentResult &result, bool final_op) {
+  double energy;
+  auto grad = energy_gradient(first, last, op, energy, final_op);
+  result.save_data_average(creg(), op.string_params[0], std::move(grad),
+                           op.type, op.save_type);
+  if (op.string_params.size() > 1)
+    result.save_data_average(creg(), op.string_params[1], energy, op.type,
+                             op.save_type);
+} //SW
+
 //-------------------------------------------------------------------------
 } // namespace QuantumState
 //-------------------------------------------------------------------------